@@ -1,3 +1,22 @@
 #pragma once
 
+#include "preprocessor.h"
+
 #define DJINN_VULKAN_VALIDATION 1
+
+// includes the Vulkan and shaderc headers; without them the Graphics system is not available
+// and the engine can only run headless (the CMake build for non-Windows platforms sets this to 0)
+#ifndef DJINN_VULKAN
+#define DJINN_VULKAN 1
+#endif
+
+// enables DJINN_PROFILE_ZONE instrumentation; when 0 the macros expand to nothing
+#define DJINN_PROFILING 1
+
+// the lowest log category that is compiled in; log statements below it are removed entirely
+// (0: DEBUG, 1: MESSAGE, 2: WARNING, 3: ERROR_, 4: FATAL) [NOTE] FATAL is never removed
+#ifdef DJINN_DEBUG
+#define DJINN_MIN_LOG_LEVEL 0
+#else
+#define DJINN_MIN_LOG_LEVEL 1
+#endif
@@ -0,0 +1,474 @@
+#include "binary_log.h"
+#include "log_sink.h"
+#include "logger.h"
+
+#include <algorithm>
+#include <cstring>
+#include <istream>
+#include <iterator>
+#include <ostream>
+#include <sstream>
+#include <unordered_map>
+
+namespace djinn::core {
+    BinaryLog& BinaryLog::instance() {
+        static BinaryLog binaryLog;
+        return binaryLog;
+    }
+
+    template <typename T>
+    void BinaryLog::append(std::vector<uint8_t>& data, const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        auto bytes = reinterpret_cast<const uint8_t*>(&value);
+        data.insert(data.end(), bytes, bytes + sizeof(T));
+    }
+
+    BinaryLog::~BinaryLog() {
+        close();
+    }
+
+    void BinaryLog::open(const std::filesystem::path& path) {
+        close();
+
+        std::lock_guard<std::mutex> guard(m_Mutex);
+
+        m_File.open(path, std::ios::binary | std::ios::trunc);
+
+        if (!m_File.good()) {
+            gLogError << "Failed to open binary log " << path.string();
+            return;
+        }
+
+        // relates the steady timestamps of the messages to the wall clock
+        using namespace std::chrono;
+
+        auto wallClock   = static_cast<uint64_t>(duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count());
+        auto steadyClock = static_cast<uint64_t>(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+
+        m_File.write(k_Magic, sizeof(k_Magic));
+        m_File.write(reinterpret_cast<const char*>(&k_Version), sizeof(k_Version));
+        m_File.write(reinterpret_cast<const char*>(&wallClock), sizeof(wallClock));
+        m_File.write(reinterpret_cast<const char*>(&steadyClock), sizeof(steadyClock));
+
+        for (uint32_t id = 0; id < static_cast<uint32_t>(m_Formats.size()); ++id)
+            writeFormat(id, m_Formats[id]);
+
+        m_Open = true;
+    }
+
+    void BinaryLog::close() {
+        if (!m_Open)
+            return;
+
+        flush();
+
+        std::lock_guard<std::mutex> guard(m_Mutex);
+
+        m_Open = false;
+        m_File.close();
+    }
+
+    bool BinaryLog::isOpen() const {
+        return m_Open;
+    }
+
+    uint32_t BinaryLog::registerFormat(const LogFormat& format) {
+        std::lock_guard<std::mutex> guard(m_Mutex);
+
+        auto id = static_cast<uint32_t>(m_Formats.size());
+        m_Formats.push_back(format);
+
+        if (m_Open)
+            writeFormat(id, format);
+
+        return id;
+    }
+
+    void BinaryLog::flush() {
+        std::lock_guard<std::mutex> guard(m_Mutex);
+
+        for (auto it = m_Buffers.begin(); it != m_Buffers.end();) {
+            auto& buffer = **it;
+
+            // [NOTE] check before flushing; the last records of a thread precede the flag
+            bool isOrphaned = buffer.m_IsOrphaned;
+
+            flush(buffer);
+
+            // forget about the buffers of threads that have exited
+            if (isOrphaned)
+                it = m_Buffers.erase(it);
+            else
+                ++it;
+        }
+
+        if (m_File.is_open())
+            m_File.flush();
+    }
+
+    BinaryLog::ThreadBufferOwner::~ThreadBufferOwner() {
+        if (m_Buffer)
+            m_Buffer->m_IsOrphaned = true;
+    }
+
+    BinaryLog::ThreadBuffer& BinaryLog::getThreadBuffer() {
+        thread_local ThreadBufferOwner t_Owner;
+
+        if (!t_Owner.m_Buffer) {
+            t_Owner.m_Buffer = std::make_shared<ThreadBuffer>();
+
+            std::lock_guard<std::mutex> guard(m_Mutex);
+            m_Buffers.push_back(t_Owner.m_Buffer);
+        }
+
+        return *t_Owner.m_Buffer;
+    }
+
+    uint8_t* BinaryLog::reserve(ThreadBuffer& buffer, size_t numBytes) {
+        uint64_t committed = buffer.m_Committed.load(std::memory_order_relaxed);
+
+        if (numBytes <= k_BufferSize) {
+            // only when the ring is (nearly) full does this thread have to write it out itself
+            if (committed + numBytes - buffer.m_Flushed.load(std::memory_order_acquire) > k_BufferSize) {
+                std::lock_guard<std::mutex> guard(m_Mutex);
+                flush(buffer);
+            }
+
+            size_t offset = static_cast<size_t>(committed % k_BufferSize);
+
+            if (offset + numBytes <= k_BufferSize)
+                return buffer.m_Ring.get() + offset;
+        }
+
+        buffer.m_Scratch.resize(numBytes);
+
+        return buffer.m_Scratch.data();
+    }
+
+    void BinaryLog::commit(ThreadBuffer& buffer, size_t numBytes) {
+        uint64_t committed = buffer.m_Committed.load(std::memory_order_relaxed);
+        size_t   offset    = static_cast<size_t>(committed % k_BufferSize);
+
+        if (numBytes > k_BufferSize) {
+            // too large for the ring, write out what came before and then the record itself
+            std::lock_guard<std::mutex> guard(m_Mutex);
+
+            flush(buffer);
+
+            if (m_File.is_open())
+                m_File.write(reinterpret_cast<const char*>(buffer.m_Scratch.data()), static_cast<std::streamsize>(numBytes));
+
+            return;
+        }
+
+        if (offset + numBytes > k_BufferSize) {
+            // the record was encoded in the scratch buffer, split it over the end of the ring
+            size_t head = k_BufferSize - offset;
+
+            std::memcpy(buffer.m_Ring.get() + offset, buffer.m_Scratch.data(), head);
+            std::memcpy(buffer.m_Ring.get(), buffer.m_Scratch.data() + head, numBytes - head);
+        }
+
+        committed += numBytes;
+        buffer.m_Committed.store(committed, std::memory_order_release);
+
+        // write out larger blocks, but don't wait for another thread that is doing so already
+        if (committed - buffer.m_Flushed.load(std::memory_order_acquire) >= k_FlushSize) {
+            std::unique_lock<std::mutex> lock(m_Mutex, std::try_to_lock);
+
+            if (lock.owns_lock())
+                flush(buffer);
+        }
+    }
+
+    void BinaryLog::writeFormat(uint32_t id, const LogFormat& format) {
+        std::vector<uint8_t> data;
+
+        append(data, eRecordType::FORMAT);
+        append(data, id);
+        append(data, static_cast<int32_t>(format.m_Category));
+        append(data, static_cast<int32_t>(format.m_SourceLine));
+
+        std::string_view file(format.m_SourceFile);
+        std::string_view fmt(format.m_Format);
+
+        append(data, static_cast<uint32_t>(file.size()));
+        data.insert(data.end(), file.begin(), file.end());
+        append(data, static_cast<uint32_t>(fmt.size()));
+        data.insert(data.end(), fmt.begin(), fmt.end());
+
+        m_File.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    }
+
+    void BinaryLog::flush(ThreadBuffer& buffer) {
+        uint64_t committed = buffer.m_Committed.load(std::memory_order_acquire);
+        uint64_t flushed   = buffer.m_Flushed.load(std::memory_order_relaxed);
+
+        if (committed == flushed)
+            return;
+
+        if (m_File.is_open()) {
+            size_t offset   = static_cast<size_t>(flushed % k_BufferSize);
+            size_t numBytes = static_cast<size_t>(committed - flushed);
+            size_t head     = std::min(numBytes, k_BufferSize - offset);
+
+            m_File.write(reinterpret_cast<const char*>(buffer.m_Ring.get() + offset), static_cast<std::streamsize>(head));
+
+            if (numBytes > head)
+                m_File.write(reinterpret_cast<const char*>(buffer.m_Ring.get()), static_cast<std::streamsize>(numBytes - head));
+        }
+
+        buffer.m_Flushed.store(committed, std::memory_order_release);
+    }
+
+    namespace {
+        class Reader {
+        public:
+            Reader(const std::vector<char>& data):
+                m_Cursor(data.data()),
+                m_End(data.data() + data.size()) {}
+
+            template <typename T>
+            bool read(T& value) {
+                if (static_cast<size_t>(m_End - m_Cursor) < sizeof(T))
+                    return false;
+
+                std::memcpy(&value, m_Cursor, sizeof(T));
+                m_Cursor += sizeof(T);
+
+                return true;
+            }
+
+            bool read(std::string& str) {
+                uint32_t length = 0;
+
+                if (!read(length) || (static_cast<size_t>(m_End - m_Cursor) < length))
+                    return false;
+
+                str.assign(m_Cursor, length);
+                m_Cursor += length;
+
+                return true;
+            }
+
+            bool read(std::vector<char>& bytes, size_t numBytes) {
+                if (static_cast<size_t>(m_End - m_Cursor) < numBytes)
+                    return false;
+
+                bytes.assign(m_Cursor, m_Cursor + numBytes);
+                m_Cursor += numBytes;
+
+                return true;
+            }
+
+            bool isDone() const { return m_Cursor >= m_End; }
+
+        private:
+            const char* m_Cursor;
+            const char* m_End;
+        };
+
+        struct DecodedFormat {
+            eLogCategory m_Category = eLogCategory::MESSAGE;
+            int32_t      m_Line     = 0;
+            std::string  m_File;
+            std::string  m_Format;
+        };
+
+        struct DecodedMessage {
+            uint32_t          m_FormatId;
+            uint64_t          m_Timestamp;
+            std::vector<char> m_Arguments;
+        };
+
+        // yields false when the arguments are malformed
+        bool decodeArguments(const std::vector<char>& arguments, std::vector<std::string>& result) {
+            using eArgType = BinaryLog::eArgType;
+
+            Reader reader(arguments);
+
+            while (!reader.isDone()) {
+                eArgType          type;
+                std::stringstream sstr;
+
+                if (!reader.read(type))
+                    return false;
+
+                switch (type) {
+                case eArgType::BOOL: {
+                    uint8_t value;
+                    if (!reader.read(value))
+                        return false;
+                    sstr << std::boolalpha << (value != 0);
+                } break;
+
+                case eArgType::CHAR: {
+                    char value;
+                    if (!reader.read(value))
+                        return false;
+                    sstr << value;
+                } break;
+
+                case eArgType::INT: {
+                    int64_t value;
+                    if (!reader.read(value))
+                        return false;
+                    sstr << value;
+                } break;
+
+                case eArgType::UINT: {
+                    uint64_t value;
+                    if (!reader.read(value))
+                        return false;
+                    sstr << value;
+                } break;
+
+                case eArgType::FLOAT: {
+                    double value;
+                    if (!reader.read(value))
+                        return false;
+                    sstr << value;
+                } break;
+
+                case eArgType::POINTER: {
+                    uint64_t value;
+                    if (!reader.read(value))
+                        return false;
+                    sstr << "0x" << std::hex << value;
+                } break;
+
+                case eArgType::STRING: {
+                    std::string value;
+                    if (!reader.read(value))
+                        return false;
+                    sstr << value;
+                } break;
+
+                default: return false;
+                }
+
+                result.push_back(sstr.str());
+            }
+
+            return true;
+        }
+
+        // replaces every {} with the next argument, any remaining arguments are appended
+        std::string applyFormat(const std::string& format, const std::vector<std::string>& arguments) {
+            std::string result;
+            size_t      next = 0;
+
+            for (size_t i = 0; i < format.size(); ++i) {
+                if ((format[i] == '{') && (i + 1 < format.size()) && (format[i + 1] == '}') &&
+                    (next < arguments.size())) {
+                    result += arguments[next++];
+                    ++i;
+                }
+                else
+                    result += format[i];
+            }
+
+            for (; next < arguments.size(); ++next) {
+                result += ' ';
+                result += arguments[next];
+            }
+
+            return result;
+        }
+    }  // namespace
+
+    bool decodeBinaryLog(std::istream& input, std::ostream& output) {
+        using eRecordType = BinaryLog::eRecordType;
+
+        std::vector<char> data((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+
+        Reader reader(data);
+
+        char     magic[4];
+        uint32_t version     = 0;
+        uint64_t wallClock   = 0;
+        uint64_t steadyClock = 0;
+
+        if (!reader.read(magic) || !std::equal(std::begin(magic), std::end(magic), BinaryLog::k_Magic))
+            return false;
+
+        if (!reader.read(version) || (version != BinaryLog::k_Version))
+            return false;
+
+        if (!reader.read(wallClock) || !reader.read(steadyClock))
+            return false;
+
+        std::unordered_map<uint32_t, DecodedFormat> formats;
+        std::vector<DecodedMessage>                 messages;
+
+        while (!reader.isDone()) {
+            eRecordType type;
+            uint32_t    id;
+
+            if (!reader.read(type) || !reader.read(id))
+                return false;
+
+            if (type == eRecordType::FORMAT) {
+                DecodedFormat format;
+                int32_t       category;
+
+                if (!reader.read(category) || !reader.read(format.m_Line) || !reader.read(format.m_File) ||
+                    !reader.read(format.m_Format))
+                    return false;
+
+                format.m_Category = static_cast<eLogCategory>(category);
+                formats[id]       = std::move(format);
+            }
+            else if (type == eRecordType::MESSAGE) {
+                DecodedMessage message;
+                uint32_t       size;
+
+                message.m_FormatId = id;
+
+                if (!reader.read(message.m_Timestamp) || !reader.read(size) ||
+                    !reader.read(message.m_Arguments, size))
+                    return false;
+
+                messages.push_back(std::move(message));
+            }
+            else
+                return false;
+        }
+
+        // every thread wrote its own buffer, restore the global order
+        std::stable_sort(messages.begin(), messages.end(), [](const DecodedMessage& a, const DecodedMessage& b) {
+            return a.m_Timestamp < b.m_Timestamp;
+        });
+
+        std::vector<std::string> arguments;
+
+        for (const auto& message : messages) {
+            auto it = formats.find(message.m_FormatId);
+
+            if (it == formats.end()) {
+                output << "<< unknown log format " << message.m_FormatId << " >>\n";
+                continue;
+            }
+
+            const auto& format = it->second;
+
+            arguments.clear();
+            if (!decodeArguments(message.m_Arguments, arguments))
+                arguments.push_back("<< malformed arguments >>");
+
+            // [NOTE] messages may have been logged just before the file was opened
+            auto sinceOpen = static_cast<int64_t>(message.m_Timestamp - steadyClock);
+
+            writeFileSinkLine(
+                output,
+                wallClock + sinceOpen,
+                format.m_Category,
+                applyFormat(format.m_Format, arguments),
+                format.m_File,
+                format.m_Line);
+        }
+
+        return true;
+    }
+}  // namespace djinn::core
@@ -0,0 +1,172 @@
+#pragma once
+
+#include "log_category.h"
+#include "log_message.h"
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace djinn::core {
+    // Deferred formatting log for hot code paths
+    //
+    // Every call site registers a static format descriptor (source file, line, category and
+    // a format string with {} placeholders) once. After that, logging only appends the id of
+    // the descriptor, a timestamp and the raw bytes of the arguments to a buffer of the
+    // calling thread; no text is formatted at all. Full buffers are appended to the output
+    // file as a whole, and decodeBinaryLog() (or the LogTool) turns the file back into the
+    // same text that the regular file sink produces.
+    //
+    // The buffer of a thread is a ring with a single producer (the thread itself), so logging
+    // doesn't lock anything; only the threads that write buffers to the file (flush(), or a
+    // thread that finds its own buffer filling up) synchronize with each other. Timestamps are
+    // taken from the steady clock, the file header relates that to the wall clock.
+    //
+    // Supported arguments are arithmetic types, enums, pointers and strings.
+    //
+    // file:   magic, u32 version, u64 wall clock (ns since the unix epoch), u64 steady clock (ns)
+    //         when the file was opened, followed by any number of records
+    // record: eRecordType, followed by
+    //         FORMAT:  u32 id, i32 category, i32 line, u32 length + file, u32 length + format
+    //         MESSAGE: u32 id, u64 timestamp (steady clock, ns), u32 size + arguments
+    // argument: eArgType, followed by the value (strings are a u32 length + characters)
+    //
+    // [NOTE] values are stored in native byte order
+    // [NOTE] records from different threads are interleaved per buffer, the decoder sorts
+    //        messages by timestamp
+    // [NOTE] messages that are logged while the file is being closed may be lost
+    struct LogFormat {
+        const char*  m_SourceFile;  // just the filename, see DJINN_SOURCE_FILENAME
+        int          m_SourceLine;
+        eLogCategory m_Category;
+        const char*  m_Format;
+    };
+
+    class BinaryLog {
+    public:
+        enum class eRecordType: uint8_t
+        {
+            FORMAT  = 1,
+            MESSAGE = 2
+        };
+
+        enum class eArgType: uint8_t
+        {
+            BOOL = 1,
+            CHAR,
+            INT,    // all signed integers are stored as 64 bits
+            UINT,   // same for the unsigned ones
+            FLOAT,  // stored as a double
+            POINTER,
+            STRING
+        };
+
+        static constexpr char     k_Magic[4]  = {'D', 'J', 'B', 'L'};
+        static constexpr uint32_t k_Version    = 2;
+        static constexpr size_t   k_BufferSize = 128 * 1024;  // per thread
+        static constexpr size_t   k_FlushSize  = 64 * 1024;   // a thread tries to flush its own buffer beyond this
+
+        static BinaryLog& instance();
+
+    private:
+        BinaryLog() = default;
+
+    public:
+        ~BinaryLog();
+
+        BinaryLog(const BinaryLog&) = delete;
+        BinaryLog& operator=(const BinaryLog&) = delete;
+        BinaryLog(BinaryLog&&)                 = delete;
+        BinaryLog& operator=(BinaryLog&&) = delete;
+
+        void open(const std::filesystem::path& path);  // writes all known formats as well
+        void close();                                  // flushes before closing
+        bool isOpen() const;
+
+        uint32_t registerFormat(const LogFormat& format);  // may be called from any thread
+
+        template <typename... tArgs>
+        void write(uint32_t formatId, const tArgs&... args);
+
+        void flush();  // appends the buffers of all threads to the file
+
+    private:
+        // [NOTE] positions are the total number of bytes written/flushed, modulo the size is the offset
+        struct ThreadBuffer {
+            std::unique_ptr<uint8_t[]> m_Ring       = std::make_unique<uint8_t[]>(k_BufferSize);
+            std::atomic<uint64_t>      m_Committed  = 0;      // only written by the thread itself
+            std::atomic<uint64_t>      m_Flushed    = 0;      // only written with m_Mutex locked
+            std::atomic_bool           m_IsOrphaned = false;  // the thread has exited
+
+            std::vector<uint8_t> m_Scratch;  // for records that don't fit in one piece
+        };
+
+        using ThreadBufferPtr = std::shared_ptr<ThreadBuffer>;
+
+        // marks the buffer as orphaned when the thread exits
+        struct ThreadBufferOwner {
+            ~ThreadBufferOwner();
+
+            ThreadBufferPtr m_Buffer;
+        };
+
+        ThreadBuffer& getThreadBuffer();
+
+        void writeFormat(uint32_t id, const LogFormat& format);  // [NOTE] expects m_Mutex to be locked
+        void flush(ThreadBuffer& buffer);                        // [NOTE] expects m_Mutex to be locked
+
+        // a record is encoded in the space yielded by reserve() and then published with commit();
+        // only the thread that owns the buffer may do this
+        uint8_t* reserve(ThreadBuffer& buffer, size_t numBytes);
+        void     commit(ThreadBuffer& buffer, size_t numBytes);
+
+        template <typename T>
+        static size_t encodedSize(const T& value);
+
+        template <typename T>
+        static uint8_t* encode(uint8_t* cursor, const T& value);  // yields the new cursor
+
+        template <typename T>
+        static std::string_view toStringView(const T& value);
+
+        template <typename T>
+        static uint8_t* put(uint8_t* cursor, const T& value);
+
+        template <typename T>
+        static void append(std::vector<uint8_t>& data, const T& value);
+
+        std::atomic_bool m_Open = false;
+
+        mutable std::mutex           m_Mutex;  // guards the file, the formats, the buffer list and flushing
+        std::ofstream                m_File;
+        std::vector<LogFormat>       m_Formats;
+        std::vector<ThreadBufferPtr> m_Buffers;
+    };
+
+    // writes the text equivalent of a binary log, as the file sink would have;
+    // yields false if the input is not a (valid) binary log
+    bool decodeBinaryLog(std::istream& input, std::ostream& output);
+}  // namespace djinn::core
+
+// clang-format off
+// [NOTE] the format must be a string literal
+#define gLogBinary(category, format, ...)                                                          \
+    do {                                                                                           \
+        if (::djinn::core::isLogCategoryActive(::djinn::core::eLogCategory::category)) {           \
+            static const uint32_t s_DjinnLogFormat = ::djinn::core::BinaryLog::instance().registerFormat( \
+                {DJINN_SOURCE_FILENAME, __LINE__, ::djinn::core::eLogCategory::category, format});        \
+                                                                                                   \
+            ::djinn::core::BinaryLog::instance().write(s_DjinnLogFormat, ##__VA_ARGS__);           \
+        }                                                                                          \
+    } while (false)
+// clang-format on
+
+#include "binary_log.inl"
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "binary_log.h"
+
+#include <chrono>
+#include <cstring>
+
+namespace djinn::core {
+    template <typename... tArgs>
+    void BinaryLog::write(uint32_t formatId, const tArgs&... args) {
+        using namespace std::chrono;
+
+        if (!m_Open)
+            return;
+
+        auto timestamp = static_cast<uint64_t>(
+            duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+
+        // the size of the whole record is known up front, so it can be encoded in place
+        auto argumentSize = static_cast<uint32_t>((size_t(0) + ... + encodedSize(args)));
+
+        constexpr size_t headerSize = sizeof(eRecordType) + sizeof(formatId) + sizeof(timestamp) + sizeof(argumentSize);
+
+        size_t recordSize = headerSize + argumentSize;
+
+        auto&    buffer = getThreadBuffer();
+        uint8_t* cursor = reserve(buffer, recordSize);
+
+        cursor = put(cursor, eRecordType::MESSAGE);
+        cursor = put(cursor, formatId);
+        cursor = put(cursor, timestamp);
+        cursor = put(cursor, argumentSize);
+
+        ((cursor = encode(cursor, args)), ...);
+
+        commit(buffer, recordSize);
+    }
+
+    template <typename T>
+    size_t BinaryLog::encodedSize(const T& value) {
+        // enums are stored as their underlying type, so they have to be checked first
+        if constexpr (std::is_enum_v<T>)
+            return encodedSize(static_cast<std::underlying_type_t<T>>(value));
+        else if constexpr (std::is_same_v<T, bool>)
+            return sizeof(eArgType) + sizeof(uint8_t);
+        else if constexpr (std::is_same_v<T, char>)
+            return sizeof(eArgType) + sizeof(char);
+        else if constexpr (std::is_integral_v<T> || std::is_floating_point_v<T>)
+            return sizeof(eArgType) + sizeof(uint64_t);
+        else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+            return sizeof(eArgType) + sizeof(uint32_t) + toStringView(value).size();
+        else if constexpr (std::is_pointer_v<T>)
+            return sizeof(eArgType) + sizeof(uint64_t);
+        else
+            static_assert(sizeof(T) == 0, "Unsupported binary log argument type");
+    }
+
+    template <typename T>
+    uint8_t* BinaryLog::encode(uint8_t* cursor, const T& value) {
+        if constexpr (std::is_enum_v<T>)
+            return encode(cursor, static_cast<std::underlying_type_t<T>>(value));
+        else if constexpr (std::is_same_v<T, bool>) {
+            cursor = put(cursor, eArgType::BOOL);
+            return put(cursor, static_cast<uint8_t>(value));
+        }
+        else if constexpr (std::is_same_v<T, char>) {
+            cursor = put(cursor, eArgType::CHAR);
+            return put(cursor, value);
+        }
+        else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+            cursor = put(cursor, eArgType::INT);
+            return put(cursor, static_cast<int64_t>(value));
+        }
+        else if constexpr (std::is_integral_v<T>) {
+            cursor = put(cursor, eArgType::UINT);
+            return put(cursor, static_cast<uint64_t>(value));
+        }
+        else if constexpr (std::is_floating_point_v<T>) {
+            cursor = put(cursor, eArgType::FLOAT);
+            return put(cursor, static_cast<double>(value));
+        }
+        else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+            auto str = toStringView(value);
+
+            cursor = put(cursor, eArgType::STRING);
+            cursor = put(cursor, static_cast<uint32_t>(str.size()));
+            std::memcpy(cursor, str.data(), str.size());
+
+            return cursor + str.size();
+        }
+        else if constexpr (std::is_pointer_v<T>) {
+            cursor = put(cursor, eArgType::POINTER);
+            return put(cursor, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value)));
+        }
+        else
+            static_assert(sizeof(T) == 0, "Unsupported binary log argument type");
+    }
+
+    template <typename T>
+    std::string_view BinaryLog::toStringView(const T& value) {
+        if constexpr (std::is_pointer_v<T>)
+            return value ? std::string_view(value) : std::string_view("(null)");
+        else
+            return std::string_view(value);
+    }
+
+    template <typename T>
+    uint8_t* BinaryLog::put(uint8_t* cursor, const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        std::memcpy(cursor, &value, sizeof(T));
+        return cursor + sizeof(T);
+    }
+}  // namespace djinn::core
@@ -0,0 +1,148 @@
+#include "dependency_graph.h"
+#include "system.h"
+
+#include <algorithm>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace djinn::core {
+    DependencyGraph::DependencyGraph(
+        const std::vector<System*>&     systems,
+        const std::vector<std::string>& available) {
+        using namespace std;
+
+        // intern the names, so the rest only deals with indices
+        unordered_map<string, SystemId> lookup;
+        unordered_set<string>           satisfied(available.begin(), available.end());
+
+        m_Nodes.reserve(systems.size());
+
+        for (auto* system : systems) {
+            lookup[system->getName()] = static_cast<SystemId>(m_Nodes.size());
+            m_Nodes.push_back(Node{system, {}, {}});
+        }
+
+        stringstream missing;
+
+        for (SystemId id = 0; id < m_Nodes.size(); ++id) {
+            for (const auto& dep : m_Nodes[id].m_System->getDependencies()) {
+                auto it = lookup.find(dep);
+
+                if (it != lookup.end()) {
+                    m_Nodes[id].m_Dependencies.push_back(it->second);
+                    m_Nodes[it->second].m_Dependents.push_back(id);
+                }
+                else if (satisfied.find(dep) == satisfied.end())
+                    missing << "\n\t" << m_Nodes[id].m_System->getName() << ": Missing dependency [" << dep << "]";
+            }
+        }
+
+        if (!missing.str().empty())
+            throw runtime_error("Unresolved system dependencies:" + missing.str());
+
+        // Kahn's algorithm, one depth level at a time
+        vector<size_t>   remaining(m_Nodes.size());
+        vector<SystemId> current;
+
+        for (SystemId id = 0; id < m_Nodes.size(); ++id) {
+            remaining[id] = m_Nodes[id].m_Dependencies.size();
+
+            if (remaining[id] == 0)
+                current.push_back(id);
+        }
+
+        while (!current.empty()) {
+            vector<SystemId> next;
+
+            for (auto id : current) {
+                m_Nodes[id].m_Depth = static_cast<uint32_t>(m_Levels.size());
+                m_Order.push_back(id);
+
+                for (auto dependent : m_Nodes[id].m_Dependents)
+                    if (--remaining[dependent] == 0)
+                        next.push_back(dependent);
+            }
+
+            m_Levels.push_back(std::move(current));
+            current = std::move(next);
+        }
+
+        if (m_Order.size() != m_Nodes.size())
+            throw runtime_error("Cyclic system dependency: " + describeCycle());
+    }
+
+    size_t DependencyGraph::size() const noexcept {
+        return m_Nodes.size();
+    }
+
+    bool DependencyGraph::empty() const noexcept {
+        return m_Nodes.empty();
+    }
+
+    const DependencyGraph::Node& DependencyGraph::operator[](SystemId id) const {
+        return m_Nodes[id];
+    }
+
+    const std::vector<DependencyGraph::SystemId>& DependencyGraph::getOrder() const noexcept {
+        return m_Order;
+    }
+
+    const std::vector<std::vector<DependencyGraph::SystemId>>& DependencyGraph::getLevels() const noexcept {
+        return m_Levels;
+    }
+
+    std::string DependencyGraph::describeCycle() const {
+        // every node that didn't make it into the topological order is either part of a cycle
+        // or depends on one; following unordered dependencies must eventually revisit a node
+        std::vector<bool> ordered(m_Nodes.size(), false);
+        for (auto id : m_Order)
+            ordered[id] = true;
+
+        auto start = static_cast<SystemId>(
+            std::distance(ordered.begin(), std::find(ordered.begin(), ordered.end(), false)));
+
+        std::vector<SystemId> path;
+        std::vector<bool>     onPath(m_Nodes.size(), false);
+
+        SystemId id = start;
+
+        while (!onPath[id]) {
+            onPath[id] = true;
+            path.push_back(id);
+
+            for (auto dep : m_Nodes[id].m_Dependencies) {
+                if (!ordered[dep]) {
+                    id = dep;
+                    break;
+                }
+            }
+        }
+
+        std::stringstream sstr;
+
+        auto it = std::find(path.begin(), path.end(), id);
+        for (; it != path.end(); ++it)
+            sstr << m_Nodes[*it].m_System->getName() << " -> ";
+        sstr << m_Nodes[id].m_System->getName();
+
+        return sstr.str();
+    }
+
+    std::ostream& operator<<(std::ostream& os, const DependencyGraph& graph) {
+        const auto& levels = graph.getLevels();
+
+        for (size_t depth = 0; depth < levels.size(); ++depth) {
+            os << "\t" << depth << ":";
+
+            for (auto id : levels[depth])
+                os << " " << graph[id].m_System->getName();
+
+            os << "\n";
+        }
+
+        return os;
+    }
+}  // namespace djinn::core
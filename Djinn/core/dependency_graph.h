@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace djinn::core {
+    class System;
+
+    // Resolves the (string based) dependencies between systems once, and stores them
+    // as interned indices. Computes a topological order and groups the systems by depth
+    // (systems at the same depth are independent of each other).
+    //
+    // Dependencies on any of the 'available' names are considered satisfied already; this
+    // allows building a graph for just the systems that were enabled after others were
+    // initialized.
+    //
+    // [NOTE] the constructor throws a std::runtime_error describing all missing dependencies
+    //        and/or a dependency cycle
+    class DependencyGraph {
+    public:
+        using SystemId = uint32_t;  // index into the list of systems that was supplied
+
+        struct Node {
+            System*               m_System;
+            std::vector<SystemId> m_Dependencies;  // only the ones inside of this graph
+            std::vector<SystemId> m_Dependents;
+            uint32_t              m_Depth = 0;
+        };
+
+        DependencyGraph() = default;
+        explicit DependencyGraph(
+            const std::vector<System*>&     systems,
+            const std::vector<std::string>& available = {});
+
+        size_t      size() const noexcept;
+        bool        empty() const noexcept;
+        const Node& operator[](SystemId id) const;
+
+        const std::vector<SystemId>&              getOrder() const noexcept;   // dependencies come first
+        const std::vector<std::vector<SystemId>>& getLevels() const noexcept;  // grouped by depth
+
+    private:
+        std::string describeCycle() const;
+
+        std::vector<Node>                  m_Nodes;
+        std::vector<SystemId>              m_Order;
+        std::vector<std::vector<SystemId>> m_Levels;
+    };
+
+    std::ostream& operator<<(std::ostream& os, const DependencyGraph& graph);
+}  // namespace djinn::core
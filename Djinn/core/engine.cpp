@@ -1,6 +1,11 @@
 #include "engine.h"
+#include "binary_log.h"
+#include "flight_recorder.h"
+#include "mediator.h"
 #include "util/algorithm.h"
 #include <fstream>
+#include <sstream>
+#include <unordered_map>
 
 namespace djinn {
     namespace {
@@ -12,17 +17,23 @@ namespace djinn {
         return result;
     }
 
-    Engine::Engine() {}
+    Engine::Engine() {
+        m_FramePacer.setMode(core::FramePacer::eMode::TARGET_FPS);
+        m_FramePacer.setTargetFrameRate(60.0);
 
-    void Engine::run() {
-        // start by trying to load a config file
+        // [NOTE] loaded here rather than in run(), so settings that are changed
+        //        programmatically before running take precedence over the config file
         std::ifstream config_stream(g_SystemConfigFilename.c_str());
         if (config_stream.good())
             config_stream >> m_SystemSettings;
         else
             gLogWarning << "No configuration file was found, using defaults for all subsystems";
 
-        // next, try to load the application config
+        load_engine_settings();
+    }
+
+    void Engine::run() {
+        // try to load the application config
         if (m_Application) {
             std::string   applicationName           = m_Application->getName();
             std::string   applicationConfigFilename = applicationName + std::string(".cfg");
@@ -35,75 +46,154 @@ namespace djinn {
                             << " was found, using defaults";
         }
 
+        if (!m_BinaryLogOutput.empty())
+            core::BinaryLog::instance().open(m_BinaryLogOutput);
+
+        // [NOTE] the flight recorder sink stays in place until the logger itself is destroyed, so
+        //        it is only added by the first run() (mapping the same file twice would mix up
+        //        the ring)
+        if (!m_FlightRecorderOutput.empty() && !m_FlightRecorderAdded) {
+            try {
+                core::Logger::instance().add(core::makeFlightRecorderSink(m_FlightRecorderOutput, m_FlightRecorderCapacity));
+                m_FlightRecorderAdded = true;
+            }
+            catch (const std::runtime_error& ex) {
+                gLogError << ex.what();
+            }
+        }
+
         // continue with initializing third-party libraries
         init_external_libraries();
 
         // and start the main loop
         // [NOTE] the code ends up pretty loopy, perhaps some restructuring is in order?
         m_Running = true;
+        m_FramePacer.setHeadless(m_Headless);
+        m_FramePacer.start();
+
         while (m_Running) {
+            m_Profiler.beginFrame(m_FrameIndex.load());
+
+            // messages sent from other threads to handlers that live on the main thread
+            core::Mailbox::current().drain();
+
             // This is done within the run loop so systems may be
             // enabled while running
-            if (m_UninitializedSystems > 0) {
-                static int s_prev_count = std::numeric_limits<int>::max();
-
-                if (s_prev_count == m_UninitializedSystems) {
-                    std::stringstream sstr;
-                    sstr << "\n";
-                    int missing = 0;
-
-                    // check for systems that are completely missing
-                    for (const auto& s : m_Systems) {
-                        if (!s->isInitialized()) {
-                            for (const auto& dep : s->getDependencies()) {
-                                if (!find(dep)) {
-                                    sstr << "\t" << s->getName() << ": Missing dependency [" << dep
-                                         << "]\n";
-                                    ++missing;
-                                }
-                            }
-                        }
-                    }
-
-                    if (missing > 0)
-                        gLogError << sstr.str();
-
-                    // even if nothing is missing, we could have a cyclic dependency between subsystems
-                    throw std::runtime_error("Unable to make progress initializing systems");
-                }
-
-                s_prev_count = m_UninitializedSystems;
+            if (m_UninitializedSystems > 0)
                 init_systems();
-            }
 
             if (m_UninitializedSystems == 0) {
                 if (m_Application && !m_Application->isInitialized())
                     init_application();
 
-                for (auto& system : m_Systems)
-                    system->update();
+                rebuild_schedule();
+
+                // deliver the messages that were posted since the previous frame
+                dispatch();
+
+                fixed_update_systems();
+                update_systems();
 
                 if (m_Application) {
                     if (m_Application->isInitialized())
-                        m_Application->update();
+                        m_Profiler.measure(m_Application->getName(), core::Profiler::ePhase::UPDATE, [this] {
+                            m_Application->update();
+                        });
                 }
                 else {
                     gLog << "No application was set, stopping...";
                     stop();
                 }
             }
+
+            advance_frame();
         }
 
         // done with the main loop, cleanup
         shutdown_application();
         shutdown_systems();
         shutdown_external_libraries();
+
+        // make sure everything that was logged has actually been written
+        core::Logger::instance().reportSuppressed();
+        core::Logger::instance().sync();
+        core::BinaryLog::instance().close();
     }
 
     void Engine::stop() {
         m_Running = false;
     }
 
+    void Engine::setHeadless(bool headless) {
+        m_Headless = headless;
+    }
+
+    bool Engine::isHeadless() const {
+        return m_Headless;
+    }
+
+    void Engine::setSaveSettings(bool enabled) {
+        m_SaveSettings = enabled;
+    }
+
+    bool Engine::isSavingSettings() const {
+        return m_SaveSettings;
+    }
+
+    core::FramePacer& Engine::getFramePacer() {
+        return m_FramePacer;
+    }
+
+    const core::FramePacer& Engine::getFramePacer() const {
+        return m_FramePacer;
+    }
+
+    void Engine::setFixedTimestep(double seconds) {
+        m_FixedSteps.setTimestep(seconds);
+    }
+
+    double Engine::getFixedTimestep() const {
+        return m_FixedSteps.getTimestep();
+    }
+
+    double Engine::getFixedAlpha() const {
+        return m_FixedSteps.getAlpha();
+    }
+
+    uint64_t Engine::getFrameIndex() const {
+        return m_FrameIndex.load();
+    }
+
+    double Engine::getDeltaTime() const {
+        return m_DeltaTime;
+    }
+
+    core::SystemScheduler& Engine::getScheduler() {
+        return m_Scheduler;
+    }
+
+    void Engine::setNumWorkers(unsigned numWorkers) {
+        m_NumWorkers = numWorkers;
+
+        m_Scheduler.setNumWorkers((numWorkers > 0) ? numWorkers : core::SystemScheduler::getDefaultWorkerCount());
+    }
+
+    unsigned Engine::getNumWorkers() const {
+        return m_Scheduler.getNumWorkers();
+    }
+
+    core::Profiler& Engine::getProfiler() {
+        return m_Profiler;
+    }
+
+    const core::Profiler& Engine::getProfiler() const {
+        return m_Profiler;
+    }
+
+    util::FrameArena& Engine::getFrameArena() {
+        return m_FrameArena;
+    }
+
     namespace {
         bool is_satisfied(
             const std::vector<std::string>& dependencies,
@@ -113,45 +203,157 @@ namespace djinn {
     }  // namespace
 
     void Engine::init_systems() {
-        // single pass over all the systems,
-        // initializing anything that has its
-        // dependencies satisfied
+        // the dependencies are resolved once, and independent systems are
+        // initialized concurrently (following the same rules as updating)
+        std::vector<core::System*> pending;
 
-        if (m_UninitializedSystems == 0)
+        for (const auto& system : m_Systems)
+            if (!system->isInitialized())
+                pending.push_back(system.get());
+
+        if (pending.empty())
             return;
 
-        for (auto& system : m_Systems) {
-            if (!system->isInitialized()) {
-                if (is_satisfied(system->getDependencies(), m_InitOrder)) {
-                    // look up settings specific to this system
-                    auto it = m_SystemSettings.find(system->getName());
-
-                    if (it != m_SystemSettings.end()) {
-                        for (const auto& entry : system->getSettings())
-                            entry.m_DeserializeFn(*it);
-                    }
-                    else
-                        gLogWarning << "No configuration for system " << system->getName()
-                                    << " was found, using defaults";
-
-                    try {
-                        system->m_Engine = this;
-                        system->init();
-
-                        m_InitOrder.push_back(system->getName());
-                        --m_UninitializedSystems;
-                    }
-                    catch (std::exception& ex) {
-                        gLogError << ex.what();
-
-                        system->m_Engine = nullptr;
-                    }
-                    catch (...) {
-                        system->m_Engine = nullptr;
-                    }
-                }
+        core::DependencyGraph graph(pending, m_InitOrder);  // throws if something is missing or cyclic
+
+        gLogDebug << "System initialization order:\n" << graph;
+
+        // the dependencies within the graph, so they don't have to be looked up by name again
+        // (the others were initialized before)
+        std::unordered_map<core::System*, std::vector<core::System*>> dependencies;
+
+        for (core::DependencyGraph::SystemId id = 0; id < graph.size(); ++id) {
+            auto& list = dependencies[graph[id].m_System];
+
+            for (auto dep : graph[id].m_Dependencies)
+                list.push_back(graph[dep].m_System);
+        }
+
+        m_Scheduler.build(graph);
+        m_ScheduleDirty = true;  // the update schedule should cover all systems again
+
+        m_Scheduler.execute([this, &dependencies](core::System* system) {
+            init_system(system, dependencies.find(system)->second);
+        });
+
+        std::stringstream failed;
+
+        for (auto id : graph.getOrder()) {
+            auto* system = graph[id].m_System;
+
+            if (system->isInitialized()) {
+                m_InitOrder.push_back(system->getName());
+                --m_UninitializedSystems;
+            }
+            else
+                failed << " [" << system->getName() << "]";
+        }
+
+        if (!failed.str().empty())
+            throw std::runtime_error("Failed to initialize systems:" + failed.str());
+    }
+
+    void Engine::init_system(core::System* system, const std::vector<core::System*>& dependencies) {
+        // dependencies were processed before this one, but may have failed
+        for (auto* dep : dependencies) {
+            if (!dep->isInitialized()) {
+                gLogError << system->getName() << " ~ skipped, dependency [" << dep->getName() << "] was not initialized";
+                return;
             }
         }
+
+        // look up settings specific to this system
+        auto it = m_SystemSettings.find(system->getName());
+
+        if (it != m_SystemSettings.end()) {
+            for (const auto& entry : system->getSettings())
+                entry.m_DeserializeFn(*it);
+        }
+        else
+            gLogWarning << "No configuration for system " << system->getName()
+                        << " was found, using defaults";
+
+        try {
+            system->m_Engine = this;
+
+            m_Profiler.measure(system->getName(), core::Profiler::ePhase::INIT, [system] { system->init(); });
+        }
+        catch (std::exception& ex) {
+            gLogError << ex.what();
+
+            system->m_Engine = nullptr;
+        }
+        catch (...) {
+            system->m_Engine = nullptr;
+        }
+    }
+
+    void Engine::rebuild_schedule() {
+        if (!m_ScheduleDirty)
+            return;
+
+        std::vector<core::System*> systems;
+        systems.reserve(m_Systems.size());
+
+        for (const auto& system : m_Systems)
+            systems.push_back(system.get());
+
+        m_Scheduler.build(core::DependencyGraph(systems));
+        m_ScheduleDirty = false;
+    }
+
+    void Engine::fixed_update_systems() {
+        const double timestep = m_FixedSteps.getTimestep();
+        const int    steps    = m_FixedSteps.consume();
+
+        for (int i = 0; i < steps; ++i) {
+            m_Scheduler.execute([this, timestep](core::System* system) {
+                m_Profiler.measure(system->getName(), core::Profiler::ePhase::FIXED_UPDATE, [system, timestep] {
+                    system->fixedUpdate(timestep);
+                });
+            });
+
+            if (m_Application && m_Application->isInitialized())
+                m_Profiler.measure(m_Application->getName(), core::Profiler::ePhase::FIXED_UPDATE, [this, timestep] {
+                    m_Application->fixedUpdate(timestep);
+                });
+        }
+    }
+
+    void Engine::update_systems() {
+        // independent systems are updated concurrently, see core::SystemScheduler
+        m_Scheduler.execute([this](core::System* system) {
+            m_Profiler.measure(system->getName(), core::Profiler::ePhase::UPDATE, [system] { system->update(); });
+        });
+    }
+
+    void Engine::advance_frame() {
+        using namespace std::chrono;
+
+        // waiting for the next frame is not part of the profiled frame time
+        m_Profiler.endFrame();
+
+        auto elapsed = m_FramePacer.endFrame();
+
+        m_DeltaTime = duration_cast<duration<double>>(elapsed).count();
+
+        // cheap enough to record every frame, and a no-op unless the binary log is enabled
+        gLogBinary(DEBUG, "frame {} took {} ms", m_FrameIndex.load(), m_DeltaTime * 1000.0);
+
+        // only accumulate simulation time once everything is up and running
+        if (m_UninitializedSystems == 0)
+            m_FixedSteps.add(m_DeltaTime);
+
+        m_FrameArena.nextFrame();
+
+        // so suppressed log messages are reported even if their call site went quiet
+        core::Logger::instance().reportExpired();
+
+        // in async mode the writer thread takes care of this
+        if (!core::Logger::instance().isAsync())
+            core::Logger::instance().pollSinks();
+
+        ++m_FrameIndex;
     }
 
     void Engine::shutdown_systems() {
@@ -162,7 +364,7 @@ namespace djinn {
             });
 
             // allow the system to clean up
-            (*jt)->shutdown();
+            m_Profiler.measure(systemName, core::Profiler::ePhase::SHUTDOWN, [&jt] { (*jt)->shutdown(); });
 
             // collect the systems' settings
             nlohmann::json settings;
@@ -183,7 +385,17 @@ namespace djinn {
         m_SystemMap.clear();
         m_Systems.clear();
 
-        {
+        if (m_Profiler.isEnabled()) {
+            gLog << m_Profiler;
+            gLog << "Frame arena peak usage: " << m_FrameArena.getPeakBytesUsed() << " / "
+                 << m_FrameArena.getCapacity() << " bytes, " << m_FrameArena.getNumOverflows()
+                 << " overflow allocations";
+            m_Profiler.exportChromeTrace(m_ProfilerOutput);
+        }
+
+        save_engine_settings();
+
+        if (m_SaveSettings) {
             // save system settings to disk
             std::ofstream out(g_SystemConfigFilename.c_str());
             if (!out.good())
@@ -223,20 +435,103 @@ namespace djinn {
                 m_ApplicationSettings.push_back(std::move(setting));
             }
 
-            std::string   applicationName           = m_Application->getName();
-            std::string   applicationConfigFilename = applicationName + std::string(".cfg");
-            std::ofstream out(applicationConfigFilename.c_str());
+            if (m_SaveSettings) {
+                std::string   applicationName           = m_Application->getName();
+                std::string   applicationConfigFilename = applicationName + std::string(".cfg");
+                std::ofstream out(applicationConfigFilename.c_str());
 
-            if (!out.good())
-                gLogError << "Failed to open " << applicationConfigFilename
-                          << ", discarding settings";
-            else
-                out << m_ApplicationSettings.dump(4);
+                if (!out.good())
+                    gLogError << "Failed to open " << applicationConfigFilename
+                              << ", discarding settings";
+                else
+                    out << m_ApplicationSettings.dump(4);
+            }
 
             m_Application.reset();  // and we're done
         }
     }
 
+    void Engine::load_engine_settings() {
+        auto it = m_SystemSettings.find("Engine");
+
+        if ((it == m_SystemSettings.end()) || !it->is_object()) {
+            gLogWarning << "No configuration for the engine was found, using defaults";
+            return;
+        }
+
+        std::stringstream sstr;
+        sstr << m_FramePacer.getMode();
+
+        m_FramePacer.setMode(core::parseFramePacingMode(it->value("FramePacing", sstr.str()), m_FramePacer.getMode()));
+        m_FramePacer.setTargetFrameRate(it->value("TargetFPS", m_FramePacer.getTargetFrameRate()));
+        setFixedTimestep(it->value("FixedTimestep", m_FixedSteps.getTimestep()));
+        m_FixedSteps.setMaxSteps(it->value("MaxFixedSteps", m_FixedSteps.getMaxSteps()));
+        m_Headless      = it->value("Headless", m_Headless);
+
+        setNumWorkers(it->value("NumWorkers", m_NumWorkers));
+
+        m_Profiler.setEnabled(it->value("Profiling", m_Profiler.isEnabled()));
+        m_ProfilerOutput = it->value("ProfilerOutput", m_ProfilerOutput);
+
+        auto& logger = core::Logger::instance();
+
+        std::stringstream overflow;
+        overflow << logger.getOverflowPolicy();
+
+        logger.setQueueCapacity(it->value("LogQueueCapacity", logger.getQueueCapacity()));
+        logger.setOverflowPolicy(core::parseLogOverflowPolicy(it->value("LogOverflowPolicy", overflow.str())));
+        logger.setAsync(it->value("AsyncLogging", logger.isAsync()));
+
+        // the same (per call site) limit for every category except FATAL
+        auto limit = logger.getRateLimit(core::eLogCategory::MESSAGE);
+
+        limit.m_MaxMessages     = it->value("LogRateLimit", limit.m_MaxMessages);
+        limit.m_CollapseRepeats = it->value("LogCollapseRepeats", limit.m_CollapseRepeats);
+
+        for (auto category : {core::eLogCategory::DEBUG, core::eLogCategory::MESSAGE, core::eLogCategory::WARNING, core::eLogCategory::ERROR_})
+            logger.setRateLimit(category, limit);
+
+        m_BinaryLogOutput = it->value("BinaryLog", m_BinaryLogOutput);
+
+        m_FlightRecorderOutput   = it->value("FlightRecorder", m_FlightRecorderOutput);
+        m_FlightRecorderCapacity = it->value("FlightRecorderCapacity", m_FlightRecorderCapacity);
+    }
+
+    void Engine::save_engine_settings() {
+        std::stringstream sstr;
+        sstr << m_FramePacer.getMode();
+
+        nlohmann::json settings;
+
+        settings["FramePacing"]    = sstr.str();
+        settings["Headless"]       = m_Headless;
+        settings["TargetFPS"]      = m_FramePacer.getTargetFrameRate();
+        settings["FixedTimestep"]  = m_FixedSteps.getTimestep();
+        settings["MaxFixedSteps"]  = m_FixedSteps.getMaxSteps();
+        settings["NumWorkers"]     = m_NumWorkers;
+        settings["Profiling"]      = m_Profiler.isEnabled();
+        settings["ProfilerOutput"] = m_ProfilerOutput;
+
+        auto& logger = core::Logger::instance();
+
+        std::stringstream overflow;
+        overflow << logger.getOverflowPolicy();
+
+        auto limit = logger.getRateLimit(core::eLogCategory::MESSAGE);
+
+        settings["AsyncLogging"]       = logger.isAsync();
+        settings["LogQueueCapacity"]   = logger.getQueueCapacity();
+        settings["LogOverflowPolicy"]  = overflow.str();
+        settings["LogRateLimit"]       = limit.m_MaxMessages;
+        settings["LogCollapseRepeats"] = limit.m_CollapseRepeats;
+        settings["BinaryLog"]          = m_BinaryLogOutput;
+
+        settings["FlightRecorder"]         = m_FlightRecorderOutput;
+        settings["FlightRecorderCapacity"] = m_FlightRecorderCapacity;
+
+        m_SystemSettings["Engine"] = settings;
+    }
+
     void Engine::init_external_libraries() {}
 
     void Engine::shutdown_external_libraries() {}
@@ -1,7 +1,11 @@
 #pragma once
 
 #include "app/application.h"
+#include "frame_pacer.h"
+#include "profiler.h"
 #include "system.h"
+#include "system_scheduler.h"
+#include "util/frame_arena.h"
 #include "util/typemap.h"
 #include <atomic>
 #include <memory>
@@ -41,19 +45,74 @@ namespace djinn {
         template <typename T, typename... tArgs>
         void setApplication(tArgs... args);
 
+        // [NOTE] throws a std::runtime_error when the systems can't all be initialized (missing or
+        //        cyclic dependencies, or an init() that failed); failures are logged individually
         void run();
         void stop();
 
+        // Headless mode runs the main loop without creating any windows (and without a swapchain),
+        // so it can be used for automated tests and benchmarks
+        // [NOTE] should be set before run(); can also be set with 'Headless' in the config file
+        void setHeadless(bool headless);
+        bool isHeadless() const;
+
+        // The engine settings from the config file are applied when the engine is created, so
+        // anything set programmatically afterwards takes precedence. All settings are written back
+        // to the config file after run(), unless that is disabled here (f.e. for benchmarks).
+        void setSaveSettings(bool enabled);
+        bool isSavingSettings() const;
+
+        // The main loop runs (and renders) at a variable rate, governed by the frame pacer;
+        // System::fixedUpdate is called at a fixed rate, zero or more times per frame.
+        // The alpha value is the fraction of a fixed step that remains, for interpolation.
+        // [NOTE] these can also be configured in the 'Engine' section of the config file
+        core::FramePacer&       getFramePacer();
+        const core::FramePacer& getFramePacer() const;
+
+        void   setFixedTimestep(double seconds);
+        double getFixedTimestep() const;
+        double getFixedAlpha() const;
+
+        uint64_t getFrameIndex() const;
+        double   getDeltaTime() const;  // duration of the previous frame, in seconds
+
+        // Per-system timings; when enabled (setting 'Profiling'), a chrome trace is written
+        // to 'ProfilerOutput' at shutdown and a summary is logged
+        core::Profiler&       getProfiler();
+        const core::Profiler& getProfiler() const;
+
+        // The worker pool that runs the systems; it can be shared with other work (see JobSystem)
+        // [NOTE] the number of workers can also be set with 'NumWorkers' in the config file;
+        //        0 selects SystemScheduler::getDefaultWorkerCount()
+        // [NOTE] the number of workers should be set before run()
+        core::SystemScheduler& getScheduler();
+
+        void     setNumWorkers(unsigned numWorkers);
+        unsigned getNumWorkers() const;
+
+        // Scratch memory for the current frame, see util::FrameArena
+        // [NOTE] allocations remain valid until the end of the next frame
+        util::FrameArena& getFrameArena();
+
     private:
+        void load_engine_settings();
+        void save_engine_settings();
+
         void init_external_libraries();
         void shutdown_external_libraries();
 
         void init_systems();
+        void init_system(core::System* system, const std::vector<core::System*>& dependencies);
         void shutdown_systems();
 
         void init_application();
         void shutdown_application();
 
+        void rebuild_schedule();
+        void fixed_update_systems();
+        void update_systems();
+        void advance_frame();
+
         core::System* find(const std::string& name) const;
 
         SystemList     m_Systems;
@@ -64,9 +123,31 @@ namespace djinn {
         nlohmann::json m_ApplicationSettings;
 
         std::atomic_bool m_Running              = false;
+        bool             m_Headless             = false;
+        bool             m_SaveSettings         = true;
         int              m_UninitializedSystems = 0;
 
         std::vector<std::string> m_InitOrder;
+
+        core::SystemScheduler m_Scheduler;
+        unsigned              m_NumWorkers    = 0;     // as configured, 0 selects the default
+        bool                  m_ScheduleDirty = true;  // set when the collection of systems changes
+
+        core::FramePacer           m_FramePacer;
+        core::FixedStepAccumulator m_FixedSteps;
+        std::atomic<uint64_t>      m_FrameIndex = 0;  // handlers may query it from any thread
+        double                     m_DeltaTime  = 0.0;
+
+        util::FrameArena m_FrameArena;
+
+        core::Profiler m_Profiler;
+        std::string    m_ProfilerOutput = "djinn_trace.json";
+
+        std::string m_BinaryLogOutput;  // see core::BinaryLog, disabled when empty
+
+        std::string m_FlightRecorderOutput;                      // see core::FlightRecorder, disabled when empty
+        size_t      m_FlightRecorderCapacity = 16 * 1024 * 1024;  // in bytes
+        bool        m_FlightRecorderAdded    = false;             // the sink is only added once, not per run()
     };
 }  // namespace djinn
 
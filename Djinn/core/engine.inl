@@ -15,6 +15,7 @@ namespace djinn {
         m_Systems.push_back(std::move(s));
 
         ++m_UninitializedSystems;
+        m_ScheduleDirty = true;
     }
 
     template <typename T>
@@ -38,6 +39,8 @@ namespace djinn {
 
         m_SystemMap.remove<T>();
         m_Systems.erase(it);
+
+        m_ScheduleDirty = true;
     }
 
     template <typename T>
@@ -0,0 +1,269 @@
+#include "flight_recorder.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <istream>
+#include <iterator>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if DJINN_PLATFORM != DJINN_PLATFORM_WINDOWS
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace djinn::core {
+    static_assert(sizeof(FlightRecorder::Header) <= FlightRecorder::k_HeaderSize);
+    static_assert(sizeof(FlightRecorder::RecordHeader) % FlightRecorder::k_RecordAlignment == 0);
+
+    namespace {
+        constexpr size_t alignRecordSize(size_t numBytes) {
+            return (numBytes + FlightRecorder::k_RecordAlignment - 1) & ~(FlightRecorder::k_RecordAlignment - 1);
+        }
+
+        constexpr size_t k_ChecksumOffset = offsetof(FlightRecorder::RecordHeader, m_Size);
+
+        [[noreturn]] void throwMappingError(const std::filesystem::path& path) {
+            std::string message = "Failed to map flight recorder file: ";
+            message.append(path.string());
+            throw std::runtime_error(message);
+        }
+    }  // namespace
+
+    FlightRecorder::FlightRecorder(const std::filesystem::path& path, size_t capacity):
+        m_Capacity(alignRecordSize(std::max<size_t>(capacity, 4096))) {
+        size_t totalSize = k_HeaderSize + m_Capacity;
+        void*  view      = nullptr;
+
+#if DJINN_PLATFORM == DJINN_PLATFORM_WINDOWS
+        m_File = CreateFileW(
+            path.c_str(),
+            GENERIC_READ | GENERIC_WRITE,
+            FILE_SHARE_READ,
+            nullptr,
+            OPEN_ALWAYS,
+            FILE_ATTRIBUTE_NORMAL,
+            nullptr);
+
+        if (m_File == INVALID_HANDLE_VALUE)
+            throwMappingError(path);
+
+        // this also resizes the file
+        m_Mapping = CreateFileMappingW(
+            m_File,
+            nullptr,
+            PAGE_READWRITE,
+            static_cast<DWORD>(static_cast<uint64_t>(totalSize) >> 32),
+            static_cast<DWORD>(totalSize & 0xFFFFFFFF),
+            nullptr);
+
+        if (m_Mapping)
+            view = MapViewOfFile(m_Mapping, FILE_MAP_ALL_ACCESS, 0, 0, totalSize);
+
+        if (!view) {
+            if (m_Mapping)
+                CloseHandle(m_Mapping);
+
+            CloseHandle(m_File);
+
+            throwMappingError(path);
+        }
+#else
+        int fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+
+        if (fd < 0)
+            throwMappingError(path);
+
+        if (::ftruncate(fd, static_cast<off_t>(totalSize)) == 0)
+            view = ::mmap(nullptr, totalSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+        ::close(fd);  // the mapping keeps the file open
+
+        if (!view || (view == MAP_FAILED))
+            throwMappingError(path);
+#endif
+
+        m_Header = static_cast<Header*>(view);
+        m_Ring   = static_cast<uint8_t*>(view) + k_HeaderSize;
+
+        bool isValid = std::equal(std::begin(k_Magic), std::end(k_Magic), m_Header->m_Magic) &&
+                       (m_Header->m_Version == k_Version) &&
+                       (m_Header->m_Capacity == m_Capacity);
+
+        if (!isValid) {
+            std::memset(view, 0, totalSize);
+            std::memcpy(m_Header->m_Magic, k_Magic, sizeof(k_Magic));
+
+            m_Header->m_Version  = k_Version;
+            m_Header->m_Capacity = m_Capacity;
+        }
+    }
+
+    FlightRecorder::~FlightRecorder() {
+#if DJINN_PLATFORM == DJINN_PLATFORM_WINDOWS
+        UnmapViewOfFile(m_Header);
+        CloseHandle(m_Mapping);
+        CloseHandle(m_File);
+#else
+        ::munmap(m_Header, k_HeaderSize + m_Capacity);
+#endif
+    }
+
+    void FlightRecorder::write(const LogMessage::MetaInfo& meta, std::string_view message) {
+        std::string_view file = meta.m_SourceFile ? meta.m_SourceFile : "";
+
+        // very long messages are truncated, so a single record can't take over the ring
+        size_t maxPayload = m_Capacity / 4 - sizeof(RecordHeader);
+
+        file    = file.substr(0, std::min<size_t>({file.size(), maxPayload / 2, 0xFFFF}));
+        message = message.substr(0, std::min(message.size(), maxPayload - file.size()));
+
+        size_t size = alignRecordSize(sizeof(RecordHeader) + file.size() + message.size());
+
+        uint64_t position = m_Header->m_WritePosition;
+        size_t   offset   = static_cast<size_t>(position % m_Capacity);
+
+        if (offset + size > m_Capacity) {
+            // clear the remainder of the ring and start over at the beginning
+            std::memset(m_Ring + offset, 0, m_Capacity - offset);
+
+            position += m_Capacity - offset;
+            offset = 0;
+        }
+
+        auto timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             std::chrono::system_clock::now().time_since_epoch())
+                             .count();
+
+        RecordHeader record = {};
+
+        record.m_Size       = static_cast<uint32_t>(size);
+        record.m_Category   = static_cast<int32_t>(meta.m_Category);
+        record.m_Sequence   = m_Header->m_NextSequence;
+        record.m_Timestamp  = static_cast<uint64_t>(timestamp);
+        record.m_SourceLine = meta.m_SourceLine;
+        record.m_FileLength = static_cast<uint16_t>(file.size());
+        record.m_TextLength = static_cast<uint32_t>(message.size());
+
+        uint8_t* target  = m_Ring + offset;
+        size_t   payload = sizeof(RecordHeader) + file.size() + message.size();
+
+        std::memcpy(target, &record, sizeof(record));
+        std::memcpy(target + sizeof(record), file.data(), file.size());
+        std::memcpy(target + sizeof(record) + file.size(), message.data(), message.size());
+        std::memset(target + payload, 0, size - payload);
+
+        record.m_Checksum = checksum(target + k_ChecksumOffset, size - k_ChecksumOffset);
+        record.m_Marker   = k_RecordMarker;
+
+        // the marker goes last, so a partially written record is never considered valid
+        std::memcpy(target + offsetof(RecordHeader, m_Checksum), &record.m_Checksum, sizeof(uint32_t));
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(target, &record.m_Marker, sizeof(uint32_t));
+
+        m_Header->m_WritePosition = position + size;
+        m_Header->m_NextSequence  = record.m_Sequence + 1;
+    }
+
+    size_t FlightRecorder::getCapacity() const {
+        return m_Capacity;
+    }
+
+    uint32_t FlightRecorder::checksum(const uint8_t* data, size_t numBytes) {
+        // FNV-1a style, but on 64 bit words (records are padded to 8 bytes anyway)
+        uint64_t result = 14695981039346656037ull;
+        size_t   i      = 0;
+
+        for (; i + sizeof(uint64_t) <= numBytes; i += sizeof(uint64_t)) {
+            uint64_t word;
+            std::memcpy(&word, data + i, sizeof(word));
+
+            result = (result ^ word) * 1099511628211ull;
+            result ^= result >> 32;
+        }
+
+        for (; i < numBytes; ++i)
+            result = (result ^ data[i]) * 1099511628211ull;
+
+        return static_cast<uint32_t>(result ^ (result >> 32));
+    }
+
+    LogSink makeFlightRecorderSink(const std::filesystem::path& path, size_t capacity) {
+        auto recorder = std::make_unique<FlightRecorder>(path, capacity);
+
+        return LogSink([recorder = std::move(recorder)](const LogMessage::MetaInfo& meta, std::string_view message) {
+            recorder->write(meta, message);
+        });
+    }
+
+    bool decodeFlightRecorder(std::istream& input, std::ostream& output) {
+        using RecordHeader = FlightRecorder::RecordHeader;
+
+        std::vector<uint8_t> data((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+
+        if (data.size() < FlightRecorder::k_HeaderSize)
+            return false;
+
+        FlightRecorder::Header header;
+        std::memcpy(&header, data.data(), sizeof(header));
+
+        if (!std::equal(std::begin(header.m_Magic), std::end(header.m_Magic), FlightRecorder::k_Magic) ||
+            (header.m_Version != FlightRecorder::k_Version) ||
+            (header.m_Capacity > data.size() - FlightRecorder::k_HeaderSize))
+            return false;
+
+        const uint8_t* ring     = data.data() + FlightRecorder::k_HeaderSize;
+        size_t         capacity = static_cast<size_t>(header.m_Capacity);
+
+        // the write position may be in the middle of an old record, so just scan the whole
+        // ring for valid records and put them in order afterwards
+        std::vector<size_t> offsets;
+
+        for (size_t offset = 0; offset + sizeof(RecordHeader) <= capacity;) {
+            RecordHeader record;
+            std::memcpy(&record, ring + offset, sizeof(record));
+
+            bool isValid = (record.m_Marker == FlightRecorder::k_RecordMarker) &&
+                           (record.m_Size >= sizeof(RecordHeader)) &&
+                           (record.m_Size <= capacity - offset) &&
+                           (record.m_Size % FlightRecorder::k_RecordAlignment == 0) &&
+                           (sizeof(RecordHeader) + record.m_FileLength + record.m_TextLength <= record.m_Size) &&
+                           (FlightRecorder::checksum(ring + offset + k_ChecksumOffset, record.m_Size - k_ChecksumOffset) == record.m_Checksum);
+
+            if (isValid) {
+                offsets.push_back(offset);
+                offset += record.m_Size;
+            }
+            else
+                offset += FlightRecorder::k_RecordAlignment;
+        }
+
+        auto getRecord = [&](size_t offset) {
+            RecordHeader record;
+            std::memcpy(&record, ring + offset, sizeof(record));
+            return record;
+        };
+
+        std::sort(offsets.begin(), offsets.end(), [&](size_t a, size_t b) {
+            return getRecord(a).m_Sequence < getRecord(b).m_Sequence;
+        });
+
+        for (auto offset : offsets) {
+            auto record = getRecord(offset);
+            auto text   = reinterpret_cast<const char*>(ring + offset + sizeof(RecordHeader));
+
+            std::string_view file(text, record.m_FileLength);
+            std::string_view message(text + record.m_FileLength, record.m_TextLength);
+
+            writeFileSinkLine(output, record.m_Timestamp, static_cast<eLogCategory>(record.m_Category), message, file, record.m_SourceLine);
+        }
+
+        return true;
+    }
+}  // namespace djinn::core
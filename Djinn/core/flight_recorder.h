@@ -0,0 +1,92 @@
+#pragma once
+
+#include "log_message.h"
+#include "log_sink.h"
+#include "preprocessor.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <string_view>
+
+namespace djinn::core {
+    // Log sink that keeps the most recent messages in a memory mapped ring file
+    //
+    // Writing a message is a copy into the mapping, no system calls are involved; the OS
+    // writes the pages back to the file by itself, also when the process crashes. This makes
+    // it cheap enough to keep verbose logging enabled all the time, while the tail of the log
+    // is still available after a crash (see decodeFlightRecorder and the LogTool).
+    //
+    // An existing ring file with the same capacity is continued, otherwise it is reset.
+    //
+    // file:   header (64 bytes), followed by the ring
+    // header: magic, u32 version, u64 capacity, u64 write position, u64 next sequence
+    // record: u32 marker, u32 checksum, u32 size, i32 category, u64 sequence, u64 timestamp
+    //         (ns since the unix epoch), i32 line, u16 file length, u16 (unused),
+    //         u32 text length, u32 (unused), file, text, padded to 8 bytes
+    //
+    // [NOTE] records are never split at the end of the ring, the remainder is cleared instead
+    // [NOTE] a record that was being written during a crash fails the checksum and is skipped
+    // [NOTE] not thread safe by itself, the Logger serializes access to a sink
+    class FlightRecorder {
+    public:
+        static constexpr char     k_Magic[4]        = {'D', 'J', 'F', 'R'};
+        static constexpr uint32_t k_Version         = 1;
+        static constexpr uint32_t k_RecordMarker    = 0xF1E6D7C8;
+        static constexpr size_t   k_HeaderSize      = 64;
+        static constexpr size_t   k_RecordAlignment = 8;
+
+        struct Header {
+            char     m_Magic[4];
+            uint32_t m_Version;
+            uint64_t m_Capacity;
+            uint64_t m_WritePosition;  // total number of bytes written, modulo the capacity is the offset
+            uint64_t m_NextSequence;
+        };
+
+        struct RecordHeader {
+            uint32_t m_Marker;
+            uint32_t m_Checksum;  // of everything after this field
+            uint32_t m_Size;      // including this header and the padding
+            int32_t  m_Category;
+            uint64_t m_Sequence;
+            uint64_t m_Timestamp;
+            int32_t  m_SourceLine;
+            uint16_t m_FileLength;
+            uint16_t m_Unused0;
+            uint32_t m_TextLength;
+            uint32_t m_Unused1;
+        };
+
+        FlightRecorder(const std::filesystem::path& path, size_t capacity);  // throws if the file can't be mapped
+        ~FlightRecorder();
+
+        FlightRecorder(const FlightRecorder&) = delete;
+        FlightRecorder& operator=(const FlightRecorder&) = delete;
+        FlightRecorder(FlightRecorder&&)                 = delete;
+        FlightRecorder& operator=(FlightRecorder&&) = delete;
+
+        void write(const LogMessage::MetaInfo& meta, std::string_view message);
+
+        size_t getCapacity() const;
+
+        static uint32_t checksum(const uint8_t* data, size_t numBytes);
+
+    private:
+        Header*  m_Header = nullptr;
+        uint8_t* m_Ring   = nullptr;
+        size_t   m_Capacity;
+
+#if DJINN_PLATFORM == DJINN_PLATFORM_WINDOWS
+        HANDLE m_File    = INVALID_HANDLE_VALUE;
+        HANDLE m_Mapping = nullptr;
+#endif
+    };
+
+    // ~~> ring file, capacity in bytes
+    LogSink makeFlightRecorderSink(const std::filesystem::path& path, size_t capacity = 16 * 1024 * 1024);
+
+    // writes the records in a ring file in the same layout as the file sink, oldest first;
+    // yields false if the input is not a (valid) ring file
+    bool decodeFlightRecorder(std::istream& input, std::ostream& output);
+}  // namespace djinn::core
@@ -0,0 +1,192 @@
+#include "frame_pacer.h"
+#include "logger.h"
+#include "util/string_util.h"
+
+#include <cmath>
+#include <ostream>
+#include <stdexcept>
+#include <thread>
+
+namespace djinn::core {
+    FramePacer::FramePacer() {
+        setTargetFrameRate(m_TargetFrameRate);
+        start();
+
+#if DJINN_PLATFORM == DJINN_PLATFORM_WINDOWS
+        // high resolution waitable timers are available starting with windows 10 (1803),
+        // fall back to a regular one if that fails
+#ifdef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+        m_Timer = CreateWaitableTimerExW(
+            nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+#endif
+        if (!m_Timer)
+            m_Timer = CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+#endif
+    }
+
+    FramePacer::~FramePacer() {
+#if DJINN_PLATFORM == DJINN_PLATFORM_WINDOWS
+        if (m_Timer)
+            CloseHandle(m_Timer);
+#endif
+    }
+
+    void FramePacer::setMode(eMode mode) {
+        m_Mode         = mode;
+        m_NextDeadline = Clock::now();
+    }
+
+    void FramePacer::setTargetFrameRate(double framesPerSecond) {
+        using namespace std::chrono;
+
+        if (framesPerSecond <= 0.0)
+            framesPerSecond = 60.0;
+
+        m_TargetFrameRate = framesPerSecond;
+        m_FramePeriod     = duration_cast<Duration>(duration<double>(1.0 / framesPerSecond));
+    }
+
+    void FramePacer::setSpinThreshold(Duration threshold) {
+        m_SpinThreshold = threshold;
+    }
+
+    void FramePacer::setHeadless(bool headless) {
+        m_Headless = headless;
+    }
+
+    FramePacer::eMode FramePacer::getMode() const {
+        return m_Mode;
+    }
+
+    double FramePacer::getTargetFrameRate() const {
+        return m_TargetFrameRate;
+    }
+
+    bool FramePacer::isHeadless() const {
+        return m_Headless;
+    }
+
+    void FramePacer::start() {
+        m_LastFrame    = Clock::now();
+        m_NextDeadline = m_LastFrame;
+    }
+
+    FramePacer::Duration FramePacer::endFrame() {
+        // without a swapchain nothing blocks on presentation, so VSYNC would run unthrottled
+        bool isPaced = (m_Mode == eMode::TARGET_FPS) || ((m_Mode == eMode::VSYNC) && m_Headless);
+
+        if (isPaced) {
+            m_NextDeadline += m_FramePeriod;
+
+            auto now = Clock::now();
+
+            // if we've fallen behind by more than a frame, don't try to catch up
+            if (m_NextDeadline + m_FramePeriod < now)
+                m_NextDeadline = now;
+            else
+                waitUntil(m_NextDeadline);
+        }
+
+        auto now     = Clock::now();
+        auto elapsed = now - m_LastFrame;
+        m_LastFrame  = now;
+
+        return elapsed;
+    }
+
+    void FramePacer::waitUntil(TimePoint deadline) {
+        using namespace std::chrono;
+
+        auto remaining = deadline - Clock::now();
+
+        if (remaining > m_SpinThreshold) {
+            auto sleepTime = remaining - m_SpinThreshold;
+
+#if DJINN_PLATFORM == DJINN_PLATFORM_WINDOWS
+            if (m_Timer) {
+                LARGE_INTEGER due;
+                due.QuadPart = -static_cast<LONGLONG>(duration_cast<nanoseconds>(sleepTime).count() / 100);  // relative, in 100ns units
+
+                if (SetWaitableTimerEx(m_Timer, &due, 0, nullptr, nullptr, nullptr, 0))
+                    WaitForSingleObject(m_Timer, INFINITE);
+            }
+            else
+                std::this_thread::sleep_for(sleepTime);
+#else
+            std::this_thread::sleep_for(sleepTime);
+#endif
+        }
+
+        // spin-tail correction
+        while (Clock::now() < deadline)
+            std::this_thread::yield();
+    }
+
+    void FixedStepAccumulator::setTimestep(double seconds) {
+        if (seconds <= 0.0)
+            throw std::runtime_error("Fixed timestep should be positive");
+
+        m_Timestep = seconds;
+    }
+
+    double FixedStepAccumulator::getTimestep() const {
+        return m_Timestep;
+    }
+
+    void FixedStepAccumulator::setMaxSteps(int maxSteps) {
+        m_MaxSteps = maxSteps;
+    }
+
+    int FixedStepAccumulator::getMaxSteps() const {
+        return m_MaxSteps;
+    }
+
+    void FixedStepAccumulator::add(double seconds) {
+        m_Accumulated += seconds;
+    }
+
+    int FixedStepAccumulator::consume() {
+        int steps = 0;
+
+        while ((m_Accumulated >= m_Timestep) && (steps < m_MaxSteps)) {
+            m_Accumulated -= m_Timestep;
+            ++steps;
+        }
+
+        // if we're falling behind, drop the excess instead of accumulating even more work
+        if (m_Accumulated >= m_Timestep)
+            m_Accumulated = std::fmod(m_Accumulated, m_Timestep);
+
+        return steps;
+    }
+
+    double FixedStepAccumulator::getAlpha() const {
+        return m_Accumulated / m_Timestep;
+    }
+
+    std::ostream& operator<<(std::ostream& os, const FramePacer::eMode& mode) {
+        switch (mode) {
+        case FramePacer::eMode::UNLIMITED: os << "Unlimited"; break;
+        case FramePacer::eMode::TARGET_FPS: os << "TargetFPS"; break;
+        case FramePacer::eMode::VSYNC: os << "VSync"; break;
+        }
+
+        return os;
+    }
+
+    FramePacer::eMode parseFramePacingMode(const std::string& name, FramePacer::eMode fallback) {
+        auto lower = util::toLower(name);
+
+        if (lower == "unlimited")
+            return FramePacer::eMode::UNLIMITED;
+        if (lower == "targetfps")
+            return FramePacer::eMode::TARGET_FPS;
+        if (lower == "vsync")
+            return FramePacer::eMode::VSYNC;
+
+        gLogWarning << "Unknown frame pacing mode '" << name << "', keeping " << fallback
+                    << " (expected Unlimited, TargetFPS or VSync)";
+
+        return fallback;
+    }
+}  // namespace djinn::core
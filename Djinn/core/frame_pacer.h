@@ -0,0 +1,99 @@
+#pragma once
+
+#include "preprocessor.h"
+
+#include <chrono>
+#include <iosfwd>
+#include <string>
+
+namespace djinn::core {
+    // Limits the rate at which the main loop runs
+    //
+    // UNLIMITED:  no waiting at all
+    // TARGET_FPS: waits until the next frame deadline; deadlines are spaced evenly so
+    //             a single slow frame doesn't shift all of the following ones
+    // VSYNC:      no waiting here, presentation is expected to block (FIFO present mode);
+    //             without a swapchain (headless) this is paced like TARGET_FPS instead
+    //
+    // Waiting uses the OS (high resolution) timer for the bulk of the remaining time
+    // and spins for the last bit, because sleeping alone tends to overshoot by up to
+    // a scheduler quantum.
+    class FramePacer {
+    public:
+        using Clock     = std::chrono::steady_clock;
+        using Duration  = Clock::duration;
+        using TimePoint = Clock::time_point;
+
+        enum class eMode
+        {
+            UNLIMITED,
+            TARGET_FPS,
+            VSYNC
+        };
+
+        FramePacer();
+        ~FramePacer();
+
+        FramePacer(const FramePacer&) = delete;
+        FramePacer& operator=(const FramePacer&) = delete;
+        FramePacer(FramePacer&&)                 = delete;
+        FramePacer& operator=(FramePacer&&) = delete;
+
+        void setMode(eMode mode);
+        void setTargetFrameRate(double framesPerSecond);
+        void setSpinThreshold(Duration threshold);  // the last part of a wait is spent spinning
+        void setHeadless(bool headless);            // nothing is presented, so VSYNC doesn't block
+
+        eMode  getMode() const;
+        double getTargetFrameRate() const;
+        bool   isHeadless() const;
+
+        void start();  // call right before the main loop, so the first frame doesn't include startup
+
+        // call once per iteration of the main loop; waits if required and
+        // yields the time between the previous call (or start) and this one
+        Duration endFrame();
+
+    private:
+        void waitUntil(TimePoint deadline);
+
+        eMode    m_Mode            = eMode::UNLIMITED;
+        bool     m_Headless        = false;
+        double   m_TargetFrameRate = 60.0;
+        Duration m_FramePeriod;
+        Duration m_SpinThreshold = std::chrono::microseconds(1500);
+
+        TimePoint m_LastFrame;
+        TimePoint m_NextDeadline;
+
+#if DJINN_PLATFORM == DJINN_PLATFORM_WINDOWS
+        HANDLE m_Timer = nullptr;
+#endif
+    };
+
+    // Converts the variable frame durations into a number of fixed size simulation steps
+    // [NOTE] at most MaxSteps are taken at once; when more are due, the excess is dropped
+    //        instead of carried over, to prevent a spiral of death when falling behind
+    class FixedStepAccumulator {
+    public:
+        void   setTimestep(double seconds);  // throws if not positive
+        double getTimestep() const;
+
+        void setMaxSteps(int maxSteps);
+        int  getMaxSteps() const;
+
+        void   add(double seconds);
+        int    consume();         // yields the number of steps that are due now
+        double getAlpha() const;  // the fraction of a step that remains
+
+    private:
+        double m_Timestep    = 1.0 / 60.0;
+        double m_Accumulated = 0.0;
+        int    m_MaxSteps    = 5;
+    };
+
+    std::ostream& operator<<(std::ostream& os, const FramePacer::eMode& mode);
+
+    // case-insensitive; if the name is not recognized a warning is logged and the fallback is returned
+    FramePacer::eMode parseFramePacingMode(const std::string& name, FramePacer::eMode fallback);
+}  // namespace djinn::core
@@ -0,0 +1,250 @@
+#include "job_system.h"
+#include "engine.h"
+#include "logger.h"
+
+namespace djinn {
+    bool JobSystem::Counter::isDone() const {
+        return m_Value.load() == 0;
+    }
+
+    int JobSystem::Counter::getValue() const {
+        return m_Value.load();
+    }
+
+    JobSystem::JobSystem():
+        System("JobSystem") {}
+
+    void JobSystem::init() {
+        System::init();
+        start(m_Engine->getScheduler());
+    }
+
+    void JobSystem::shutdown() {
+        stop();
+        System::shutdown();
+    }
+
+    void JobSystem::start(core::SystemScheduler& pool) {
+        m_Pool = &pool;
+
+        // create all of the queues before any worker can get to them, stealing iterates over the list
+        for (unsigned i = 0; i < pool.getNumWorkers(); ++i)
+            m_Workers.push_back(std::make_unique<WorkerQueue>());
+
+        pool.setIdleTask([this] {
+            Task task;
+
+            if (pop(task))
+                execute(task);
+        });
+
+        gLog << "Running jobs on " << pool.getNumWorkers() << " workers";
+    }
+
+    void JobSystem::stop() {
+        if (!m_Pool)
+            return;
+
+        // complete everything that is still outstanding, so no counter is left waiting
+        helpUntil([this] { return (m_NumQueued == 0) && (m_NumRunning == 0); });
+
+        m_Pool->setIdleTask(nullptr);
+        m_Pool = nullptr;
+
+        m_Workers.clear();
+    }
+
+    JobSystem::CounterPtr JobSystem::schedule(Job job) {
+        auto counter = makeCounter();
+        schedule(std::move(job), counter, nullptr);
+        return counter;
+    }
+
+    JobSystem::CounterPtr JobSystem::schedule(Job job, const CounterPtr& dependency) {
+        auto counter = makeCounter();
+        schedule(std::move(job), counter, dependency);
+        return counter;
+    }
+
+    void JobSystem::schedule(Job job, const CounterPtr& signal, const CounterPtr& dependency) {
+        if (signal)
+            ++signal->m_Value;
+
+        if (dependency) {
+            std::lock_guard<std::mutex> guard(dependency->m_Mutex);
+
+            if (dependency->m_Value > 0) {
+                dependency->m_Continuations.push_back(Task{std::move(job), signal});
+                return;
+            }
+        }
+
+        push(Task{std::move(job), signal});
+    }
+
+    void JobSystem::wait(const CounterPtr& counter) {
+        helpUntil([&counter] { return counter->isDone(); });
+    }
+
+    unsigned JobSystem::getNumWorkers() const {
+        return static_cast<unsigned>(m_Workers.size());
+    }
+
+    JobSystem::CounterPtr JobSystem::makeCounter() {
+        return std::make_shared<Counter>();
+    }
+
+    void JobSystem::push(Task&& task) {
+        if (!m_Pool) {
+            // not running, so nobody else would pick it up
+            ++m_NumRunning;
+            execute(task);
+            return;
+        }
+
+        int idx = m_Pool->getCurrentWorkerIndex();
+
+        if ((idx >= 0) && (idx < static_cast<int>(m_Workers.size()))) {
+            auto& worker = *m_Workers[idx];
+
+            std::lock_guard<std::mutex> guard(worker.m_Mutex);
+            worker.m_Queue.push_back(std::move(task));
+        }
+        else {
+            std::lock_guard<std::mutex> guard(m_SharedMutex);
+            m_SharedQueue.push_back(std::move(task));
+        }
+
+        ++m_NumQueued;
+
+        m_Pool->notifyIdleTask();
+        wakeWaiters();
+    }
+
+    bool JobSystem::pop(Task& task) {
+        if (m_NumQueued == 0)
+            return false;
+
+        int        idx        = m_Pool ? m_Pool->getCurrentWorkerIndex() : -1;
+        const auto numWorkers = static_cast<int>(m_Workers.size());
+
+        // own queue, LIFO
+        if ((idx >= 0) && (idx < numWorkers)) {
+            auto& worker = *m_Workers[idx];
+
+            std::lock_guard<std::mutex> guard(worker.m_Mutex);
+
+            if (!worker.m_Queue.empty()) {
+                task = std::move(worker.m_Queue.back());
+                worker.m_Queue.pop_back();
+                ++m_NumRunning;
+                --m_NumQueued;
+                return true;
+            }
+        }
+
+        // jobs scheduled from outside of the pool, FIFO
+        {
+            std::lock_guard<std::mutex> guard(m_SharedMutex);
+
+            if (!m_SharedQueue.empty()) {
+                task = std::move(m_SharedQueue.front());
+                m_SharedQueue.pop_front();
+                ++m_NumRunning;
+                --m_NumQueued;
+                return true;
+            }
+        }
+
+        // steal from the other workers, FIFO, starting with the next one over
+        for (int i = 1; i <= numWorkers; ++i) {
+            int   victimIdx = (std::max(idx, 0) + i) % numWorkers;
+            auto& victim    = *m_Workers[victimIdx];
+
+            if (victimIdx == idx)
+                continue;
+
+            std::lock_guard<std::mutex> guard(victim.m_Mutex);
+
+            if (!victim.m_Queue.empty()) {
+                task = std::move(victim.m_Queue.front());
+                victim.m_Queue.pop_front();
+                ++m_NumRunning;
+                --m_NumQueued;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void JobSystem::execute(Task& task) {
+        try {
+            task.m_Work();
+        }
+        catch (std::exception& ex) {
+            gLogError << "Job failed: " << ex.what();
+        }
+        catch (...) {
+            gLogError << "Job failed with an unknown exception";
+        }
+
+        if (task.m_Signal)
+            signal(task.m_Signal);
+
+        // [NOTE] after signalling, so the released continuations are counted as queued
+        --m_NumRunning;
+
+        wakeWaiters();
+    }
+
+    void JobSystem::signal(const CounterPtr& counter) {
+        std::vector<Task> released;
+
+        {
+            std::lock_guard<std::mutex> guard(counter->m_Mutex);
+
+            if (--counter->m_Value == 0)
+                released.swap(counter->m_Continuations);
+        }
+
+        for (auto& task : released)
+            push(std::move(task));
+    }
+
+    void JobSystem::helpUntil(const std::function<bool()>& isDone) {
+        while (!isDone()) {
+            Task task;
+
+            if (pop(task)) {
+                execute(task);
+                continue;
+            }
+
+            // the remaining jobs are being executed elsewhere; sleep until one of them
+            // completes or until there is something to help with again
+            ++m_NumWaiting;
+
+            {
+                std::unique_lock<std::mutex> lock(m_WaitMutex);
+                m_WaitSignal.wait(lock, [&] { return isDone() || (m_NumQueued > 0); });
+            }
+
+            --m_NumWaiting;
+        }
+    }
+
+    void JobSystem::wakeWaiters() {
+        // [NOTE] the waiting thread registers itself before checking the condition, so either it
+        //        sees the change that preceded this call or this sees the waiting thread
+        if (m_NumWaiting == 0)
+            return;
+
+        {
+            // so the notification can't get lost between checking and going to sleep
+            std::lock_guard<std::mutex> guard(m_WaitMutex);
+        }
+
+        m_WaitSignal.notify_all();
+    }
+}  // namespace djinn
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "system.h"
+#include "system_scheduler.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace djinn {
+    // Work-stealing job system
+    //
+    // Jobs are executed by the worker threads of the engine's SystemScheduler, so the machine
+    // isn't oversubscribed with a second pool; systems take precedence over jobs. Each worker
+    // has a deque of jobs; it pushes and pops at the back (LIFO, cache friendly) while idle
+    // workers steal from the front of the other deques. Jobs scheduled from threads outside
+    // of the pool go into a shared queue.
+    //
+    // Completion is tracked with counters; a counter is incremented for every job that
+    // signals it and reaches zero when all of those jobs are done. A job may depend on
+    // a counter, in which case it is only queued once that counter reaches zero.
+    //
+    // wait() executes pending jobs until the counter it is waiting on reaches zero, and sleeps
+    // when there is nothing to execute (so it's fine to wait from within a job).
+    //
+    // [NOTE] all outstanding jobs are completed when the system is shut down; jobs that are
+    //        scheduled while it isn't running are executed right away, on the calling thread
+    // [NOTE] the number of workers is the engine's 'NumWorkers' setting (see Engine::setNumWorkers)
+    // [NOTE] if the pool has no workers (single core), jobs are only executed by wait()
+    // [NOTE] exceptions thrown by a job are logged and otherwise discarded
+    class JobSystem: public core::System {
+    public:
+        using Job = std::function<void()>;
+
+        class Counter {
+        public:
+            bool isDone() const;
+            int  getValue() const;
+
+        private:
+            friend class JobSystem;
+
+            struct Pending {
+                Job                      m_Work;
+                std::shared_ptr<Counter> m_Signal;
+            };
+
+            std::atomic<int>     m_Value = 0;
+            std::mutex           m_Mutex;
+            std::vector<Pending> m_Continuations;  // jobs waiting for this counter to reach zero
+        };
+
+        using CounterPtr = std::shared_ptr<Counter>;
+
+        JobSystem();
+
+        void init() override;      // starts using the pool of the engine
+        void shutdown() override;  // completes the outstanding jobs
+
+        // these allow using the job system without an engine
+        void start(core::SystemScheduler& pool);
+        void stop();
+
+        // the returned counter reaches zero when the job has completed
+        CounterPtr schedule(Job job);
+        CounterPtr schedule(Job job, const CounterPtr& dependency);
+
+        // multiple jobs may signal the same counter, optionally waiting for another counter to start
+        void schedule(Job job, const CounterPtr& signal, const CounterPtr& dependency);
+
+        // splits [0..count) into batches, fn is invoked as fn(size_t index)
+        template <typename Fn>
+        CounterPtr parallel_for(size_t count, size_t batchSize, Fn fn);
+
+        void wait(const CounterPtr& counter);  // executes pending jobs until the counter reaches zero
+
+        unsigned getNumWorkers() const;
+
+        static CounterPtr makeCounter();
+
+    private:
+        using Task = Counter::Pending;
+
+        struct WorkerQueue {
+            std::mutex       m_Mutex;
+            std::deque<Task> m_Queue;
+        };
+
+        void push(Task&& task);
+        bool pop(Task& task);  // own queue first, then the shared queue, then steal from others
+        void execute(Task& task);
+        void signal(const CounterPtr& counter);
+
+        void helpUntil(const std::function<bool()>& isDone);  // executes jobs, sleeps when there are none
+        void wakeWaiters();
+
+        core::SystemScheduler* m_Pool = nullptr;
+
+        std::vector<std::unique_ptr<WorkerQueue>> m_Workers;  // one per worker of the pool
+
+        std::mutex       m_SharedMutex;
+        std::deque<Task> m_SharedQueue;
+
+        std::atomic<int> m_NumQueued  = 0;
+        std::atomic<int> m_NumRunning = 0;
+
+        std::mutex              m_WaitMutex;
+        std::condition_variable m_WaitSignal;  // a job was queued or completed
+        std::atomic<int>        m_NumWaiting = 0;
+    };
+}  // namespace djinn
+
+#include "job_system.inl"
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "job_system.h"
+#include <algorithm>
+
+namespace djinn {
+    template <typename Fn>
+    JobSystem::CounterPtr JobSystem::parallel_for(size_t count, size_t batchSize, Fn fn) {
+        auto counter = makeCounter();
+
+        if (batchSize == 0)
+            batchSize = 1;
+
+        for (size_t first = 0; first < count; first += batchSize) {
+            size_t last = std::min(count, first + batchSize);
+
+            schedule(
+                [fn, first, last] {
+                    for (size_t i = first; i < last; ++i)
+                        fn(i);
+                },
+                counter,
+                nullptr);
+        }
+
+        return counter;
+    }
+}  // namespace djinn
@@ -0,0 +1,112 @@
+#include "log_buffer.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace djinn::core {
+    LogBuffer::LogBuffer(const LogBuffer& buffer):
+        m_Size(buffer.m_Size),
+        m_Overflow(buffer.m_Overflow) {
+        std::memcpy(m_Inline, buffer.m_Inline, m_Size);
+    }
+
+    LogBuffer& LogBuffer::operator=(const LogBuffer& buffer) {
+        if (this != &buffer) {
+            m_Size     = buffer.m_Size;
+            m_Overflow = buffer.m_Overflow;
+            std::memcpy(m_Inline, buffer.m_Inline, m_Size);
+        }
+
+        return *this;
+    }
+
+    LogBuffer::LogBuffer(LogBuffer&& buffer) noexcept:
+        m_Size(buffer.m_Size),
+        m_Overflow(std::move(buffer.m_Overflow)) {
+        std::memcpy(m_Inline, buffer.m_Inline, m_Size);
+        buffer.clear();
+    }
+
+    LogBuffer& LogBuffer::operator=(LogBuffer&& buffer) noexcept {
+        if (this != &buffer) {
+            m_Size     = buffer.m_Size;
+            m_Overflow = std::move(buffer.m_Overflow);
+            std::memcpy(m_Inline, buffer.m_Inline, m_Size);
+
+            buffer.clear();
+        }
+
+        return *this;
+    }
+
+    void LogBuffer::append(std::string_view text) {
+        if (text.empty())
+            return;
+
+        std::memcpy(reserve(text.size()), text.data(), text.size());
+    }
+
+    void LogBuffer::append(char c) {
+        *reserve(1) = c;
+    }
+
+    void LogBuffer::appendFloat(double value) {
+        char digits[32];
+
+#if defined(__cpp_lib_to_chars)
+        auto   result = std::to_chars(std::begin(digits), std::end(digits), value, std::chars_format::general, 6);
+        size_t length = static_cast<size_t>(result.ptr - digits);
+#else
+        // floating point to_chars with a precision is not available everywhere yet
+        int    count  = std::snprintf(digits, sizeof(digits), "%g", value);
+        size_t length = (count > 0) ? static_cast<size_t>(count) : 0;
+#endif
+
+        append(std::string_view(digits, length));
+    }
+
+    std::string_view LogBuffer::view() const {
+        if (!isInline())
+            return m_Overflow;
+
+        return std::string_view(m_Inline, m_Size);
+    }
+
+    size_t LogBuffer::size() const {
+        return view().size();
+    }
+
+    bool LogBuffer::empty() const {
+        return size() == 0;
+    }
+
+    bool LogBuffer::isInline() const {
+        return m_Overflow.empty();
+    }
+
+    void LogBuffer::clear() {
+        m_Size = 0;
+        m_Overflow.clear();
+    }
+
+    char* LogBuffer::reserve(size_t numChars) {
+        if (isInline()) {
+            if (m_Size + numChars <= k_InlineCapacity) {
+                char* result = m_Inline + m_Size;
+                m_Size += numChars;
+
+                return result;
+            }
+
+            // move everything to the heap
+            m_Overflow.reserve(2 * (m_Size + numChars));
+            m_Overflow.assign(m_Inline, m_Size);
+            m_Size = 0;
+        }
+
+        size_t offset = m_Overflow.size();
+        m_Overflow.resize(offset + numChars);
+
+        return m_Overflow.data() + offset;
+    }
+}  // namespace djinn::core
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace djinn::core {
+    // Character buffer for log messages; short messages (the vast majority) are kept inline,
+    // longer ones move to the heap. Numbers are formatted with std::to_chars, which doesn't
+    // involve locales or streams.
+    class LogBuffer {
+    public:
+        static constexpr size_t k_InlineCapacity = 256;
+
+        LogBuffer() = default;
+
+        LogBuffer(const LogBuffer& buffer);
+        LogBuffer& operator=(const LogBuffer& buffer);
+        LogBuffer(LogBuffer&& buffer) noexcept;
+        LogBuffer& operator=(LogBuffer&& buffer) noexcept;
+
+        void append(std::string_view text);
+        void append(char c);
+
+        template <typename T>
+        void appendInteger(T value);
+
+        void appendFloat(double value);  // same output as an std::ostream with default settings
+
+        std::string_view view() const;
+        size_t           size() const;
+        bool             empty() const;
+        bool             isInline() const;
+
+        void clear();
+
+    private:
+        char* reserve(size_t numChars);  // yields where the next numChars may be written
+
+        char        m_Inline[k_InlineCapacity];
+        size_t      m_Size = 0;  // of the inline part
+        std::string m_Overflow;  // holds everything once the inline part is exhausted
+    };
+}  // namespace djinn::core
+
+#include "log_buffer.inl"
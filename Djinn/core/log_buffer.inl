@@ -0,0 +1,17 @@
+#pragma once
+
+#include "log_buffer.h"
+
+#include <charconv>
+
+namespace djinn::core {
+    template <typename T>
+    void LogBuffer::appendInteger(T value) {
+        static_assert(std::is_integral_v<T>);
+
+        char digits[24];  // enough for 64 bits, including the sign
+
+        auto result = std::to_chars(std::begin(digits), std::end(digits), value);
+        append(std::string_view(digits, static_cast<size_t>(result.ptr - digits)));
+    }
+}  // namespace djinn::core
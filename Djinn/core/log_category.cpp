@@ -1,8 +1,8 @@
 #include "log_category.h"
-#include <atomic>
+#include <stdexcept>
 
 namespace djinn::core {
-    namespace {
+    namespace detail {
         std::atomic<bool> g_LogCategoryEnabled[5]{
             {true},  // DEBUG
             {true},  // MESSAGE
@@ -10,7 +10,9 @@ namespace djinn::core {
             {true},  // ERROR_
             {true}   // FATAL
         };
+    }  // namespace detail
 
+    namespace {
         int selectLogState(eLogCategory category) {
             switch (category) {
             case eLogCategory::DEBUG: return 0;
@@ -24,38 +26,42 @@ namespace djinn::core {
     }  // namespace
 
     void enableAllLogCategories() {
-        for (auto& cat : g_LogCategoryEnabled)
+        for (auto& cat : detail::g_LogCategoryEnabled)
             cat.store(true);
     }
 
     void disableAllLogCategories() {
-        for (auto& cat : g_LogCategoryEnabled)
+        for (auto& cat : detail::g_LogCategoryEnabled)
             cat.store(false);
     }
 
     void setGlobalLogCategory(eLogCategory category, bool enabled) {
         int idx = selectLogState(category);
-        g_LogCategoryEnabled[idx].store(enabled);
+        detail::g_LogCategoryEnabled[idx].store(enabled);
     }
 
     bool isGlobalLogCategoryEnabled(eLogCategory category) {
         int idx = selectLogState(category);
-        return g_LogCategoryEnabled[idx].load();
+        return detail::g_LogCategoryEnabled[idx].load();
     }
 
-    std::ostream& operator<<(std::ostream& os, const eLogCategory& category) {
+    const char* getLogCategoryPrefix(eLogCategory category) {
         // Chosen so you'll have an easy time spotting them in the actual log
 
         // clang-format off
 		switch (category) {
-		case eLogCategory::DEBUG:   os << "[dbg] ";         break;
-		case eLogCategory::MESSAGE: os << "      ";         break;  // this should be the majority during debugging. Should be very non-conspicous
-		case eLogCategory::WARNING: os << "*wrn* ";         break;
-		case eLogCategory::ERROR_:  os << "< ERROR >     "; break;  // extra noticable
-		case eLogCategory::FATAL:   os << "<## FATAL ##> "; break;  // extra noticable
+		case eLogCategory::DEBUG:   return "[dbg] ";
+		case eLogCategory::MESSAGE: return "      ";          // this should be the majority during debugging. Should be very non-conspicous
+		case eLogCategory::WARNING: return "*wrn* ";
+		case eLogCategory::ERROR_:  return "< ERROR >     ";  // extra noticable
+		case eLogCategory::FATAL:   return "<## FATAL ##> ";  // extra noticable
 		}
         // clang-format on
 
-        return os;
+        return "";
+    }
+
+    std::ostream& operator<<(std::ostream& os, const eLogCategory& category) {
+        return os << getLogCategoryPrefix(category);
     }
 }  // namespace djinn::core
@@ -1,15 +1,19 @@
 #pragma once
 
+#include "compile_options.h"
+
+#include <atomic>
 #include <ostream>
 
 namespace djinn::core {
+    // [NOTE] the values match DJINN_MIN_LOG_LEVEL in compile_options.h
     enum class eLogCategory
     {
-        DEBUG,
-        MESSAGE,
-        WARNING,
-        ERROR_,  // ERROR is a pretty common macro, so that's off the table
-        FATAL
+        DEBUG   = 0,
+        MESSAGE = 1,
+        WARNING = 2,
+        ERROR_  = 3,  // ERROR is a pretty common macro, so that's off the table
+        FATAL   = 4
     };
 
     // global log level functions
@@ -18,5 +22,20 @@ namespace djinn::core {
     void setGlobalLogCategory(eLogCategory category, bool enabled);
     bool isGlobalLogCategoryEnabled(eLogCategory category);
 
+    // compile time check against DJINN_MIN_LOG_LEVEL
+    constexpr bool isLogCategoryCompiledIn(eLogCategory category);
+
+    // used by the logging macros, so this is inline (and cheap)
+    bool isLogCategoryActive(eLogCategory category);
+
+    namespace detail {
+        extern std::atomic<bool> g_LogCategoryEnabled[5];
+    }
+
+    // the prefix that every message of the category starts with in the log
+    const char* getLogCategoryPrefix(eLogCategory category);
+
     std::ostream& operator<<(std::ostream& os, const eLogCategory& category);
 }  // namespace djinn::core
+
+#include "log_category.inl"
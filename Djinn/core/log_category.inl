@@ -0,0 +1,14 @@
+#pragma once
+
+#include "log_category.h"
+
+namespace djinn::core {
+    constexpr bool isLogCategoryCompiledIn(eLogCategory category) {
+        return (category == eLogCategory::FATAL) || (static_cast<int>(category) >= DJINN_MIN_LOG_LEVEL);
+    }
+
+    inline bool isLogCategoryActive(eLogCategory category) {
+        return isLogCategoryCompiledIn(category) &&
+               detail::g_LogCategoryEnabled[static_cast<int>(category)].load(std::memory_order_relaxed);
+    }
+}  // namespace djinn::core
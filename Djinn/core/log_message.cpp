@@ -1,14 +1,31 @@
 #include "log_message.h"
 #include "logger.h"
 
+#include <sstream>
+
 namespace djinn::core {
+    namespace {
+        // scratch stream for the types that don't have a direct conversion
+        std::ostringstream& getScratchStream() {
+            thread_local std::ostringstream t_Stream;
+
+            // start from the default settings (plus boolalpha) every time
+            t_Stream.str(std::string());
+            t_Stream.flags(std::ios::dec | std::ios::skipws | std::ios::boolalpha);
+
+            return t_Stream;
+        }
+    }  // namespace
+
     LogMessage::LogMessage(
-        Logger*            owner,
-        eLogCategory       category,
-        const std::string& sourceFile,
-        int                sourceLineNumber):
+        Logger*      owner,
+        eLogCategory category,
+        const char*  sourceFile,
+        int          sourceLineNumber,
+        LogSite*     site):
         m_Owner(owner),
-        m_MetaInfo{category, sourceFile, sourceLineNumber} {}
+        m_MetaInfo{category, sourceFile, sourceLineNumber},
+        m_Site(site) {}
 
     LogMessage::~LogMessage() {
         if (m_Owner)
@@ -16,7 +33,18 @@ namespace djinn::core {
     }
 
     LogMessage& LogMessage::operator<<(std::ostream& (*fn)(std::ostream&)) {
-        (*fn)(m_Buffer);
+        auto& stream = getScratchStream();
+
+        (*fn)(stream);
+        m_Buffer.append(stream.str());
+
         return *this;
     }
+
+    void LogMessage::appendStreamed(const void* value, void (*fn)(std::ostream&, const void*)) {
+        auto& stream = getScratchStream();
+
+        fn(stream, value);
+        m_Buffer.append(stream.str());
+    }
 }  // namespace djinn::core
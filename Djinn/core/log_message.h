@@ -1,26 +1,34 @@
 #pragma once
 
 #include <ostream>
-#include <sstream>
 #include <string>
+#include <string_view>
+#include <type_traits>
 
+#include "log_buffer.h"
 #include "log_category.h"
 
 namespace djinn::core {
     class Logger;
+    class LogSite;
 
     // LogMessage holds a string buffer, which accumulates a message iostream style
     // and is flushed to the parent Logger object during destruction
     // This allows automatically adding prefix/postfix strings at each point
+    //
+    // [NOTE] the buffer lives inside the message, so short messages don't touch the heap;
+    //        strings, characters and numbers are appended directly, anything else goes
+    //        through its stream operator
     class LogMessage {
     private:
         friend class Logger;  // only allow Logger objects to construct a LogMessage object
 
         LogMessage(
-            Logger*            owner,
-            eLogCategory       category,
-            const std::string& sourceFile,
-            int                sourceLineNumber);
+            Logger*      owner,
+            eLogCategory category,
+            const char*  sourceFile,
+            int          sourceLineNumber,
+            LogSite*     site);
 
         LogMessage(const LogMessage&) = delete;
         LogMessage& operator=(const LogMessage&) = delete;
@@ -35,21 +43,34 @@ namespace djinn::core {
         template <typename T>
         LogMessage& operator<<(const T& value);
 
-        // apply iostream manipulator functions (such as std::endl and std::boolalpha)
+        // apply iostream manipulator functions (such as std::endl)
+        // [NOTE] only the characters that a manipulator writes are kept, formatting flags
+        //        (std::hex, std::setw etc) have no effect on the message
         LogMessage& operator<<(std::ostream& (*fn)(std::ostream&));
 
         // MetaInfo is public so that any LogSink may make use of it
         struct MetaInfo {
             eLogCategory m_Category;
-            std::string  m_SourceFile;
+            const char*  m_SourceFile;  // just the filename, see DJINN_SOURCE_FILENAME
             int          m_SourceLine;
         };
 
     private:
-        std::ostringstream m_Buffer;
-        Logger*            m_Owner;
-        MetaInfo           m_MetaInfo;
+        void appendStreamed(const void* value, void (*fn)(std::ostream&, const void*));
+
+        LogBuffer m_Buffer;
+        Logger*   m_Owner;
+        MetaInfo  m_MetaInfo;
+        LogSite*  m_Site;  // only for messages from the logging macros
     };
+
+    // offset of the filename within a path (past the last slash or backslash)
+    constexpr size_t getSourceFilenameOffset(const char* path);
 }  // namespace djinn::core
 
+// __FILE__ without the directories; the offset is computed by the compiler, so this is
+// just a pointer into the string literal
+#define DJINN_SOURCE_FILENAME \
+    (__FILE__ + std::integral_constant<size_t, ::djinn::core::getSourceFilenameOffset(__FILE__)>::value)
+
 #include "log_message.inl"
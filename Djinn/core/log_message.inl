@@ -2,10 +2,43 @@
 
 #include "log_message.h"
 
+#include <type_traits>
+
 namespace djinn::core {
     template <typename T>
     LogMessage& LogMessage::operator<<(const T& message) {
-        m_Buffer << std::boolalpha << message;
+        if constexpr (std::is_same_v<T, bool>)
+            m_Buffer.append(message ? std::string_view("true") : std::string_view("false"));
+        else if constexpr (
+            std::is_same_v<T, char> ||
+            std::is_same_v<T, signed char> ||
+            std::is_same_v<T, unsigned char>)
+            m_Buffer.append(static_cast<char>(message));  // same as std::ostream
+        else if constexpr (std::is_integral_v<T>)
+            m_Buffer.appendInteger(message);
+        else if constexpr (std::is_floating_point_v<T>)
+            m_Buffer.appendFloat(static_cast<double>(message));
+        else if constexpr (std::is_convertible_v<const T&, const char*>) {
+            const char* str = message;
+            m_Buffer.append(str ? std::string_view(str) : std::string_view("(null)"));
+        }
+        else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+            m_Buffer.append(std::string_view(message));
+        else
+            appendStreamed(&message, [](std::ostream& os, const void* value) {
+                os << *static_cast<const T*>(value);
+            });
+
         return *this;
     }
+
+    constexpr size_t getSourceFilenameOffset(const char* path) {
+        size_t result = 0;
+
+        for (size_t i = 0; path[i] != '\0'; ++i)
+            if ((path[i] == '/') || (path[i] == '\\'))
+                result = i + 1;
+
+        return result;
+    }
 }  // namespace djinn::core
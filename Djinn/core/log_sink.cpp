@@ -1,12 +1,15 @@
 #include "log_sink.h"
 #include "rang.hpp"
 
+#include <charconv>
 #include <chrono>
 #include <ctime>
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <sstream>
+#include <stdexcept>
 
 namespace djinn::core {
     LogSink::LogSink(LogSink&& sink) noexcept: m_Wrapper(std::move(sink.m_Wrapper)) {}
@@ -20,12 +23,16 @@ namespace djinn::core {
         return (sink.m_Wrapper.get() == m_Wrapper.get());
     }
 
-    void LogSink::write(const LogMessage::MetaInfo& info, const std::string& message) {
+    void LogSink::write(const LogMessage::MetaInfo& info, std::string_view message) {
         m_Wrapper->write(info, message);
     }
 
+    void LogSink::poll() {
+        m_Wrapper->poll();
+    }
+
     LogSink makeConsoleSink() {
-        return LogSink([](const LogMessage::MetaInfo& info, const std::string& message) {
+        return LogSink([](const LogMessage::MetaInfo& info, std::string_view message) {
             switch (info.m_Category) {
             case eLogCategory::DEBUG: std::cout << rang::fgB::green; break;
             case eLogCategory::WARNING: std::cout << rang::fgB::yellow; break;
@@ -43,7 +50,7 @@ namespace djinn::core {
 
 #if DJINN_PLATFORM == DJINN_PLATFORM_WINDOWS
     LogSink makeWindowsConsoleSink() {
-        return LogSink([](const LogMessage::MetaInfo& info, const std::string& message) {
+        return LogSink([](const LogMessage::MetaInfo& info, std::string_view message) {
             std::stringstream sstr;
             sstr << info.m_Category << message << "\n";
             OutputDebugStringA(sstr.str().c_str());
@@ -52,11 +59,15 @@ namespace djinn::core {
 #endif
 
     namespace {
-        struct FileSink {
-            FileSink(const std::filesystem::path& path) {
-                mFile = std::make_unique<std::ofstream>(path.string());
-
-                if (!mFile->good()) {
+        class FileSink {
+        public:
+            FileSink(const std::filesystem::path& path, const FileSinkSettings& settings):
+                m_State(std::make_unique<State>()) {
+                m_State->m_Path     = path;
+                m_State->m_Settings = settings;
+                m_State->m_Buffer.reserve(settings.m_BufferSize);
+
+                if (!m_State->open()) {
                     std::string message = "Failed to open file sink: ";
                     message.append(path.string());
                     throw std::runtime_error(message);
@@ -69,29 +80,170 @@ namespace djinn::core {
             FileSink(FileSink&&) = default;
             FileSink& operator=(FileSink&&) = default;
 
-            void operator()(const LogMessage::MetaInfo& meta, const std::string& message) const {
+            void operator()(const LogMessage::MetaInfo& meta, std::string_view message) const {
                 using namespace std::chrono;
-                using std::experimental::filesystem::path;
 
-                auto now    = system_clock::now();
-                auto time_t = system_clock::to_time_t(now);
+                auto& state = *m_State;
+                auto  now   = system_clock::now();
+
+                // the timestamp only has a resolution of a second, so only format it once per second
+                auto seconds = duration_cast<std::chrono::seconds>(now.time_since_epoch()).count();
+
+                if (seconds != state.m_TimestampSecond) {
+                    auto time_t = system_clock::to_time_t(now);
+
+                    tm localtime;
+#if DJINN_PLATFORM == DJINN_PLATFORM_WINDOWS
+                    localtime_s(&localtime, &time_t);
+#else
+                    localtime_r(&time_t, &localtime);
+#endif
+
+                    state.m_TimestampLength = std::strftime(
+                        state.m_Timestamp, sizeof(state.m_Timestamp), "[%H:%M:%S] ", &localtime);
+                    state.m_TimestampSecond = seconds;
+                }
+
+                // [NOTE] the source file was already stripped to just the filename
+                auto& buffer = state.m_Buffer;
+
+                buffer.append(state.m_Timestamp, state.m_TimestampLength);
+                buffer.append(getLogCategoryPrefix(meta.m_Category));
+                buffer.append(message);
+                buffer.append(" (");
+                buffer.append(meta.m_SourceFile ? meta.m_SourceFile : "?");
+                buffer.push_back(':');
+
+                char digits[16];
+                auto result = std::to_chars(std::begin(digits), std::end(digits), meta.m_SourceLine);
+                buffer.append(digits, result.ptr);
+                buffer.append(")\n");
 
-                tm localtime;
-                localtime_s(&localtime, &time_t);
+                bool isUrgent = (meta.m_Category == eLogCategory::ERROR_) || (meta.m_Category == eLogCategory::FATAL);
 
-                (*mFile)
-                    << std::put_time(&localtime, "[%H:%M:%S] ") << meta.m_Category << message
-                    << " ("
-                    // strip the source data to just the filename, disarding the rest of the path
-                    << path(meta.m_SourceFile).filename().string() << ":" << meta.m_SourceLine
-                    << ")\n";
+                // [NOTE] the flush interval is measured on the steady clock, so it isn't affected
+                //        by adjustments of the wall clock
+                auto steadyNow = steady_clock::now();
+
+                if (isUrgent || (buffer.size() >= state.m_Settings.m_BufferSize))
+                    state.flush(steadyNow);
+                else
+                    state.flushIfDue(steadyNow);
             }
 
-            std::unique_ptr<std::ofstream> mFile;  // use a unique_ptr so it can be mvoed around
+            // [NOTE] the time-based flush above only happens when a message is written, this
+            //        covers the case where nothing else is logged for a while
+            void poll() const { m_State->flushIfDue(std::chrono::steady_clock::now()); }
+
+        private:
+            struct State {
+                ~State() { flush(std::chrono::steady_clock::now()); }
+
+                bool open() {
+                    m_File.rdbuf()->pubsetbuf(nullptr, 0);  // we do our own buffering
+                    m_File.open(m_Path, std::ios::out | std::ios::trunc);
+
+                    m_FileSize = 0;
+
+                    return m_File.good();
+                }
+
+                void flushIfDue(std::chrono::steady_clock::time_point now) {
+                    if (now - m_LastFlush >= m_Settings.m_FlushInterval)
+                        flush(now);
+                }
+
+                void flush(std::chrono::steady_clock::time_point now) {
+                    m_LastFlush = now;
+
+                    if (m_Buffer.empty())
+                        return;
+
+                    uint64_t maxSize = m_Settings.m_MaxFileSize;
+
+                    if ((maxSize > 0) && (m_FileSize > 0) && (m_FileSize + m_Buffer.size() > maxSize))
+                        rotate();
+
+                    m_File.write(m_Buffer.data(), static_cast<std::streamsize>(m_Buffer.size()));
+                    m_File.flush();
+
+                    m_FileSize += m_Buffer.size();
+                    m_Buffer.clear();
+                }
+
+                // shifts every file up by one, dropping the oldest
+                void rotate() {
+                    namespace fs = std::filesystem;
+
+                    m_File.close();
+
+                    std::error_code ec;  // [NOTE] missing files are not a problem
+
+                    size_t maxFiles = (m_Settings.m_MaxFiles > 0) ? m_Settings.m_MaxFiles : 1;
+
+                    fs::remove(getRotatedPath(maxFiles - 1), ec);
+
+                    for (size_t i = maxFiles - 1; i > 0; --i)
+                        fs::rename(getRotatedPath(i - 1), getRotatedPath(i), ec);
+
+                    open();  // [NOTE] if this fails, further output is lost
+                }
+
+                // djinn.log, djinn.1.log, djinn.2.log etc
+                std::filesystem::path getRotatedPath(size_t index) const {
+                    if (index == 0)
+                        return m_Path;
+
+                    auto filename = m_Path.stem().string();
+                    filename.append(".");
+                    filename.append(std::to_string(index));
+                    filename.append(m_Path.extension().string());
+
+                    return m_Path.parent_path() / filename;
+                }
+
+                std::filesystem::path m_Path;
+                FileSinkSettings      m_Settings;
+
+                std::ofstream m_File;
+                uint64_t      m_FileSize = 0;
+
+                std::string                           m_Buffer;
+                std::chrono::steady_clock::time_point m_LastFlush;
+
+                char    m_Timestamp[16]   = {};
+                size_t  m_TimestampLength = 0;
+                int64_t m_TimestampSecond = -1;
+            };
+
+            std::unique_ptr<State> m_State;  // use a unique_ptr so it can be moved around
         };
     }  // namespace
 
-    LogSink makeFileSink(const std::filesystem::path& path) {
-        return FileSink(path);
+    LogSink makeFileSink(const std::filesystem::path& path, const FileSinkSettings& settings) {
+        return FileSink(path, settings);
+    }
+
+    void writeFileSinkLine(
+        std::ostream&    os,
+        uint64_t         timestamp,
+        eLogCategory     category,
+        std::string_view message,
+        std::string_view sourceFile,
+        int              sourceLine) {
+        using namespace std::chrono;
+
+        auto timepoint = system_clock::time_point(duration_cast<system_clock::duration>(nanoseconds(timestamp)));
+        auto time_t    = system_clock::to_time_t(timepoint);
+
+        tm localtime;
+#if DJINN_PLATFORM == DJINN_PLATFORM_WINDOWS
+        localtime_s(&localtime, &time_t);
+#else
+        localtime_r(&time_t, &localtime);
+#endif
+
+        os << std::put_time(&localtime, "[%H:%M:%S] ") << category << message << " (" << sourceFile << ":"
+           << sourceLine << ")\n";
     }
 }  // namespace djinn::core
@@ -2,14 +2,31 @@
 
 #include "log_message.h"
 #include "preprocessor.h"
+#include <chrono>
+#include <cstdint>
 #include <filesystem>
+#include <iosfwd>
 #include <memory>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 
 namespace djinn::core {
+    namespace detail {
+        template <typename T, typename = void>
+        struct HasPoll: std::false_type {};
+
+        template <typename T>
+        struct HasPoll<T, std::void_t<decltype(std::declval<T&>().poll())>>: std::true_type {};
+    }  // namespace detail
+
     // Type-erased interface
     //
     // this will accept any type of backend that has implemented
-    // ::operator()(const LogMessage::MetaInfo&, const std::string)
+    // ::operator()(const LogMessage::MetaInfo&, std::string_view)
+    //
+    // Backends that hold on to text may also implement ::poll(), which is called every now and
+    // then while nothing is being logged so the text doesn't stay buffered indefinitely.
     class LogSink {
     public:
         template <typename T>
@@ -24,22 +41,23 @@ namespace djinn::core {
         bool operator==(
             const LogSink& sink) const;  // implemented so that Logger can detect duplicate sinks
 
-        void write(const LogMessage::MetaInfo& metaInfo, const std::string& message);
+        void write(const LogMessage::MetaInfo& metaInfo, std::string_view message);
+        void poll();  // no-op if the backend doesn't implement it
 
     private:
         struct Concept {
             virtual ~Concept() = default;
 
-            virtual void write(const LogMessage::MetaInfo& metaInfo, const std::string& message)
-                = 0;
+            virtual void write(const LogMessage::MetaInfo& metaInfo, std::string_view message) = 0;
+            virtual void poll()                                                                = 0;
         };
 
         template <typename T>
         struct Model: Concept {
             Model(T impl);
 
-            virtual void
-                write(const LogMessage::MetaInfo& metaInfo, const std::string& message) override;
+            virtual void write(const LogMessage::MetaInfo& metaInfo, std::string_view message) override;
+            virtual void poll() override;
 
             T m_Impl;
         };
@@ -50,8 +68,30 @@ namespace djinn::core {
     // [logLevel] [message][\n] ~~> std::cout
     LogSink makeConsoleSink();
 
+    struct FileSinkSettings {
+        size_t                    m_BufferSize    = 64 * 1024;  // text is kept in memory up to this size...
+        std::chrono::milliseconds m_FlushInterval = std::chrono::milliseconds(500);  // ...or this long
+        uint64_t                  m_MaxFileSize   = 64 * 1024 * 1024;  // rotate beyond this, 0 disables rotation
+        size_t                    m_MaxFiles      = 4;                 // including the current one
+    };
+
     // [timestamp] [loglevel] [message] ([sourcefile]:[linenumber])[\n] ~~> file path
-    LogSink makeFileSink(const std::filesystem::path& path);
+    //
+    // Text is collected in a buffer and written in large blocks; errors are written right
+    // away, and anything else once the flush interval has passed (also when nothing else is
+    // logged, see LogSink::poll). Once a file gets too big it is renamed (djinn.log -> djinn.1.log -> djinn.2.log...),
+    // and only the most recent files are kept.
+    LogSink makeFileSink(const std::filesystem::path& path, const FileSinkSettings& settings = FileSinkSettings());
+
+    // writes a line in the same layout as the file sink, for tools that reconstruct a log;
+    // the timestamp is in nanoseconds since the unix epoch
+    void writeFileSinkLine(
+        std::ostream&    os,
+        uint64_t         timestamp,
+        eLogCategory     category,
+        std::string_view message,
+        std::string_view sourceFile,
+        int              sourceLine);
 
 #if DJINN_PLATFORM == DJINN_PLATFORM_WINDOWS
     // [logLevel] [message][\n] ~~> OutputDebugStringA
@@ -12,7 +12,13 @@ namespace djinn::core {
     LogSink::Model<T>::Model(T impl): m_Impl(std::forward<T>(impl)) {}
 
     template <typename T>
-    void LogSink::Model<T>::write(const LogMessage::MetaInfo& meta, const std::string& message) {
+    void LogSink::Model<T>::write(const LogMessage::MetaInfo& meta, std::string_view message) {
         m_Impl(meta, message);
     }
+
+    template <typename T>
+    void LogSink::Model<T>::poll() {
+        if constexpr (detail::HasPoll<T>::value)
+            m_Impl.poll();
+    }
 }  // namespace djinn::core
@@ -0,0 +1,46 @@
+#include "log_site.h"
+
+namespace djinn::core {
+    namespace {
+        std::atomic<LogSite*> g_FirstLogSite = nullptr;
+    }
+
+    LogSite::LogSite(eLogCategory category, const char* sourceFile, int sourceLine):
+        m_Category(category),
+        m_SourceFile(sourceFile),
+        m_SourceLine(sourceLine) {
+        // sites are never removed, so a lock-free push is all that's needed
+        m_Next = g_FirstLogSite.load();
+
+        while (!g_FirstLogSite.compare_exchange_weak(m_Next, this))
+            ;
+    }
+
+    eLogCategory LogSite::getCategory() const {
+        return m_Category;
+    }
+
+    const char* LogSite::getSourceFile() const {
+        return m_SourceFile;
+    }
+
+    int LogSite::getSourceLine() const {
+        return m_SourceLine;
+    }
+
+    uint64_t LogSite::getNumRateLimited() const {
+        return m_NumRateLimited;
+    }
+
+    uint64_t LogSite::getNumCollapsed() const {
+        return m_NumCollapsed;
+    }
+
+    LogSite* LogSite::getFirst() {
+        return g_FirstLogSite;
+    }
+
+    LogSite* LogSite::getNext() const {
+        return m_Next;
+    }
+}  // namespace djinn::core
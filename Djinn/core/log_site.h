@@ -0,0 +1,80 @@
+#pragma once
+
+#include "log_category.h"
+#include "log_message.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+namespace djinn::core {
+    // Limits for the messages of a single call site, configured per category in the Logger
+    //
+    // A site may log m_MaxMessages per m_Interval, anything beyond that is dropped. With
+    // m_CollapseRepeats, a message identical to the previous one from the same site is
+    // dropped as well, unless the previous one was written over m_Interval ago. Either way
+    // the number of dropped messages is reported with the next message of the site
+    // (or by Logger::reportSuppressed).
+    struct LogRateLimit {
+        uint32_t                  m_MaxMessages     = 0;  // 0 means unlimited
+        std::chrono::milliseconds m_Interval        = std::chrono::seconds(1);
+        bool                      m_CollapseRepeats = false;
+    };
+
+    // State of a single logging statement; the logging macros create one per call site
+    // the first time the statement is executed
+    class LogSite {
+    public:
+        LogSite(eLogCategory category, const char* sourceFile, int sourceLine);
+
+        LogSite(const LogSite&) = delete;
+        LogSite& operator=(const LogSite&) = delete;
+        LogSite(LogSite&&)                 = delete;
+        LogSite& operator=(LogSite&&) = delete;
+
+        eLogCategory getCategory() const;
+        const char*  getSourceFile() const;
+        int          getSourceLine() const;
+
+        uint64_t getNumRateLimited() const;  // messages dropped by the rate limit so far
+        uint64_t getNumCollapsed() const;    // repeated messages dropped so far
+
+        // every call site that has been used, most recent first
+        static LogSite* getFirst();
+        LogSite*        getNext() const;
+
+    private:
+        friend class Logger;
+
+        using Clock = std::chrono::steady_clock;
+
+        eLogCategory m_Category;
+        const char*  m_SourceFile;
+        int          m_SourceLine;
+
+        std::mutex        m_Mutex;  // guards the state below
+        Clock::time_point m_WindowStart;
+        uint32_t          m_NumInWindow = 0;
+        size_t            m_LastHash    = 0;
+        bool              m_HasLast     = false;
+        Clock::time_point m_LastWritten;
+        uint64_t          m_PendingRateLimited = 0;  // not reported yet
+        uint64_t          m_PendingCollapsed   = 0;
+
+        std::atomic<uint64_t> m_NumRateLimited = 0;
+        std::atomic<uint64_t> m_NumCollapsed   = 0;
+
+        LogSite* m_Next;
+    };
+}  // namespace djinn::core
+
+// yields the LogSite of the statement this is expanded in
+// clang-format off
+#define DJINN_LOG_SITE(category)                                                                   \
+    ([]() -> ::djinn::core::LogSite& {                                                             \
+        static ::djinn::core::LogSite s_DjinnLogSite(                                              \
+            ::djinn::core::eLogCategory::category, DJINN_SOURCE_FILENAME, __LINE__);               \
+        return s_DjinnLogSite;                                                                     \
+    }())
+// clang-format on
@@ -0,0 +1,227 @@
+#include "log_writer.h"
+#include "util/string_util.h"
+
+#include <algorithm>
+#include <iterator>
+#include <ostream>
+#include <vector>
+
+namespace djinn::core {
+    namespace {
+        constexpr size_t k_MaxBatchSize = 256;
+
+        constexpr auto k_IdleTimeout = std::chrono::milliseconds(10);  // bounds the shutdown latency
+    }  // namespace
+
+    LogWriter::LogWriter(WriteFn writeFn, size_t capacity, eOverflowPolicy policy, IdleFn idleFn):
+        m_WriteFn(std::move(writeFn)),
+        m_IdleFn(std::move(idleFn)),
+        m_Capacity(capacity > 0 ? capacity : 1),
+        m_Policy(policy),
+        m_Queue(m_Capacity) {
+        m_Thread = std::thread([this] { run(); });
+    }
+
+    LogWriter::~LogWriter() {
+        m_Running = false;
+
+        if (m_Thread.joinable())
+            m_Thread.join();
+    }
+
+    bool LogWriter::push(Record&& record) {
+        bool isFatal = (record.m_MetaInfo.m_Category == eLogCategory::FATAL);
+
+        if (!isFatal) {
+            while (m_Size.fetch_add(1) >= m_Capacity) {
+                m_Size.fetch_sub(1);
+
+                if (m_Policy != eOverflowPolicy::BLOCK) {
+                    ++m_NumDropped;
+                    return false;
+                }
+
+                // only the writer thread makes room, so it would be waiting for itself
+                if (isWriterThread()) {
+                    ++m_Size;
+                    break;
+                }
+
+                waitForProgress([this] { return m_Size < m_Capacity; });
+            }
+        }
+        else
+            ++m_Size;
+
+        uint64_t sequence = m_NextSequence++;
+
+        record.m_Sequence = sequence;
+        m_Queue.enqueue(std::move(record));
+
+        // [NOTE] waiting for the watermark rather than a count of written records, which could
+        //        include records of other threads that were pushed later
+        if (isFatal)
+            waitUntilWritten(sequence + 1);
+
+        return true;
+    }
+
+    void LogWriter::sync() {
+        waitUntilWritten(m_NextSequence);
+    }
+
+    size_t LogWriter::getCapacity() const {
+        return m_Capacity;
+    }
+
+    LogWriter::eOverflowPolicy LogWriter::getOverflowPolicy() const {
+        return m_Policy;
+    }
+
+    size_t LogWriter::getNumDropped() const {
+        return m_NumDropped;
+    }
+
+    void LogWriter::run() {
+        std::vector<Record>        batch;
+        std::vector<const Record*> order;
+
+        batch.reserve(k_MaxBatchSize);
+        order.reserve(k_MaxBatchSize);
+
+        while (true) {
+            batch.clear();
+
+            size_t count = m_Queue.wait_dequeue_bulk_timed(std::back_inserter(batch), k_MaxBatchSize, k_IdleTimeout);
+
+            if (count == 0) {
+                // only stop once the queue has been drained
+                if (!m_Running)
+                    break;
+
+                if (m_Policy == eOverflowPolicy::COUNT)
+                    reportDropped();
+
+                if (m_IdleFn)
+                    m_IdleFn();
+
+                continue;
+            }
+
+            m_Size -= count;
+            notifyProgress();
+
+            // the batch is grouped per producing thread
+            // [NOTE] this only orders the records within the batch
+            order.clear();
+
+            for (const auto& record : batch)
+                order.push_back(&record);
+
+            std::sort(order.begin(), order.end(), [](const Record* a, const Record* b) {
+                return a->m_Sequence < b->m_Sequence;
+            });
+
+            for (const auto* record : order) {
+                m_WriteFn(*record);
+                m_WrittenAhead.push(record->m_Sequence);
+            }
+
+            advanceWatermark();
+            notifyProgress();
+
+            if (m_Policy == eOverflowPolicy::COUNT)
+                reportDropped();
+        }
+    }
+
+    void LogWriter::waitUntilWritten(uint64_t sequence) {
+        // the writer thread can't wait for itself
+        if (isWriterThread())
+            return;
+
+        waitForProgress([this, sequence] { return m_Watermark >= sequence; });
+    }
+
+    void LogWriter::advanceWatermark() {
+        uint64_t watermark = m_Watermark;
+
+        while (!m_WrittenAhead.empty() && (m_WrittenAhead.top() == watermark)) {
+            m_WrittenAhead.pop();
+            ++watermark;
+        }
+
+        m_Watermark = watermark;
+    }
+
+    void LogWriter::waitForProgress(const std::function<bool()>& isDone) {
+        if (isDone())
+            return;
+
+        ++m_NumWaiting;
+
+        {
+            std::unique_lock<std::mutex> lock(m_WaitMutex);
+            m_Progress.wait(lock, isDone);
+        }
+
+        --m_NumWaiting;
+    }
+
+    void LogWriter::notifyProgress() {
+        // [NOTE] a waiting thread registers itself before checking its condition, so either it
+        //        sees the progress that preceded this call or this sees the waiting thread
+        if (m_NumWaiting == 0)
+            return;
+
+        {
+            // so the notification can't get lost between checking and going to sleep
+            std::lock_guard<std::mutex> guard(m_WaitMutex);
+        }
+
+        m_Progress.notify_all();
+    }
+
+    bool LogWriter::isWriterThread() const {
+        return std::this_thread::get_id() == m_Thread.get_id();
+    }
+
+    void LogWriter::reportDropped() {
+        size_t dropped = m_NumDropped;
+
+        if (dropped == m_NumReported)
+            return;
+
+        Record record{{eLogCategory::WARNING, DJINN_SOURCE_FILENAME, __LINE__}, {}};
+
+        record.m_Text.appendInteger(dropped - m_NumReported);
+        record.m_Text.append(" log messages were dropped (queue capacity: ");
+        record.m_Text.appendInteger(m_Capacity);
+        record.m_Text.append(")");
+
+        m_NumReported = dropped;
+
+        m_WriteFn(record);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const LogWriter::eOverflowPolicy& policy) {
+        switch (policy) {
+        case LogWriter::eOverflowPolicy::BLOCK: os << "Block"; break;
+        case LogWriter::eOverflowPolicy::DROP: os << "Drop"; break;
+        case LogWriter::eOverflowPolicy::COUNT: os << "Count"; break;
+        }
+
+        return os;
+    }
+
+    LogWriter::eOverflowPolicy parseLogOverflowPolicy(const std::string& name) {
+        auto lower = util::toLower(name);
+
+        if (lower == "drop")
+            return LogWriter::eOverflowPolicy::DROP;
+        if (lower == "count")
+            return LogWriter::eOverflowPolicy::COUNT;
+
+        return LogWriter::eOverflowPolicy::BLOCK;
+    }
+}  // namespace djinn::core
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "log_message.h"
+#include "third_party.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace djinn::core {
+    // Background thread that takes care of writing log messages for an asynchronous Logger
+    //
+    // Messages are pushed into a lock-free queue by any number of threads, and the writer
+    // thread hands them to the sinks in batches. The queue has a fixed capacity; when it is
+    // full the overflow policy determines what happens:
+    //
+    // BLOCK: the logging thread waits (sleeps) until there is room; records that are logged on
+    //        the writer thread itself (by a sink) are let through, it can't wait for itself
+    // DROP:  the message is discarded
+    // COUNT: the message is discarded, and the number of discarded messages is reported
+    //        in the log once there is room again
+    //
+    // Each thread pushes into a sub-queue of its own (the implicit producers of the queue), so
+    // logging threads don't contend with each other. Records are numbered when they are pushed
+    // and every batch is sorted by that number, so records of different threads that end up in
+    // the same batch are written in the order they were logged. The order of a single thread is
+    // always kept, but a record may still be written after a later one of another thread when
+    // they end up in different batches.
+    //
+    // [NOTE] FATAL messages are never discarded, and are written before push() returns
+    class LogWriter {
+    public:
+        enum class eOverflowPolicy
+        {
+            BLOCK,
+            DROP,
+            COUNT
+        };
+
+        struct Record {
+            LogMessage::MetaInfo m_MetaInfo;
+            LogBuffer            m_Text;          // short messages are stored inline in the queue
+            uint64_t             m_Sequence = 0;  // assigned by push()
+        };
+
+        using WriteFn = std::function<void(const Record&)>;  // invoked on the writer thread
+        using IdleFn  = std::function<void()>;               // same, whenever the queue stays empty for a bit
+
+        LogWriter(WriteFn writeFn, size_t capacity, eOverflowPolicy policy, IdleFn idleFn = nullptr);
+        ~LogWriter();  // writes whatever is still queued before returning
+
+        LogWriter(const LogWriter&) = delete;
+        LogWriter& operator=(const LogWriter&) = delete;
+        LogWriter(LogWriter&&)                 = delete;
+        LogWriter& operator=(LogWriter&&) = delete;
+
+        bool push(Record&& record);  // yields false if the record was discarded
+        void sync();                 // waits until everything pushed before this call has been written
+
+        size_t          getCapacity() const;
+        eOverflowPolicy getOverflowPolicy() const;
+        size_t          getNumDropped() const;
+
+    private:
+        void run();
+        void reportDropped();
+
+        void waitUntilWritten(uint64_t sequence);  // until all records below the sequence have been written
+        void advanceWatermark();                   // writer thread only
+
+        void waitForProgress(const std::function<bool()>& isDone);  // sleeps until the writer makes progress
+        void notifyProgress();                                      // writer thread only
+        bool isWriterThread() const;
+
+        WriteFn         m_WriteFn;
+        IdleFn          m_IdleFn;
+        size_t          m_Capacity;
+        eOverflowPolicy m_Policy;
+
+        moodycamel::BlockingConcurrentQueue<Record> m_Queue;
+
+        std::atomic<size_t>   m_Size         = 0;  // approximate number of queued records
+        std::atomic<uint64_t> m_NextSequence = 0;
+        std::atomic<uint64_t> m_Watermark    = 0;  // every record with a lower sequence has been written
+        std::atomic<size_t>   m_NumDropped   = 0;
+        size_t                m_NumReported  = 0;  // writer thread only
+
+        // [NOTE] the queue only preserves the order per producer, so records from other threads
+        //        may be written before earlier ones; these are the sequences that were written
+        //        ahead of the watermark (writer thread only)
+        std::priority_queue<uint64_t, std::vector<uint64_t>, std::greater<uint64_t>> m_WrittenAhead;
+
+        std::mutex              m_WaitMutex;
+        std::condition_variable m_Progress;  // there is room in the queue, or the watermark moved
+        std::atomic<int>        m_NumWaiting = 0;
+
+        std::atomic_bool m_Running = true;
+        std::thread      m_Thread;
+    };
+
+    std::ostream& operator<<(std::ostream& os, const LogWriter::eOverflowPolicy& policy);
+
+    // case-insensitive, returns BLOCK if the name is not recognized
+    LogWriter::eOverflowPolicy parseLogOverflowPolicy(const std::string& name);
+}  // namespace djinn::core
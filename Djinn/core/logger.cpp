@@ -1,7 +1,20 @@
 #include "logger.h"
 #include "log_sink.h"
+#include "profile_zone.h"
+
+#include <algorithm>
+#include <functional>
 
 namespace djinn::core {
+    namespace {
+        // set by admit(), picked up by the LogMessage that the logging macros create right after
+        thread_local LogSite* t_AdmittedSite = nullptr;
+
+        size_t selectRateLimit(eLogCategory category) {
+            return std::min(static_cast<size_t>(category), static_cast<size_t>(eLogCategory::FATAL));
+        }
+    }  // namespace
+
     Logger::Logger(const std::string& filename) {
         add(makeConsoleSink());
         add(makeFileSink(filename));
@@ -11,43 +24,378 @@ namespace djinn::core {
 #endif
     }
 
-    LogMessage Logger::operator()(eLogCategory category, const std::string& filename, int line) {
-        return LogMessage(this, category, filename, line);
+    Logger::~Logger() {
+        setAsync(false);  // writes whatever is still queued
+
+        delete m_Sinks.load();
+    }
+
+    Logger::SinkEntry::SinkEntry(LogSink&& sink): m_Sink(std::move(sink)) {}
+
+    LogMessage Logger::operator()(eLogCategory category, const char* filename, int line) {
+        LogSite* site  = t_AdmittedSite;
+        t_AdmittedSite = nullptr;
+
+        return LogMessage(this, category, filename, line, site);
+    }
+
+    bool Logger::admit(LogSite& site) {
+        const auto& limit = m_RateLimits[selectRateLimit(site.getCategory())];
+
+        if (limit.m_MaxMessages > 0) {
+            auto now = LogSite::Clock::now();
+
+            std::lock_guard<std::mutex> guard(site.m_Mutex);
+
+            if (now - site.m_WindowStart >= limit.m_Interval) {
+                site.m_WindowStart = now;
+                site.m_NumInWindow = 0;
+            }
+
+            if (site.m_NumInWindow >= limit.m_MaxMessages) {
+                ++site.m_PendingRateLimited;
+                ++site.m_NumRateLimited;
+                ++m_NumRateLimited;
+
+                m_HasPending = true;
+
+                return false;
+            }
+
+            ++site.m_NumInWindow;
+        }
+
+        t_AdmittedSite = &site;
+
+        return true;
     }
 
     void Logger::add(LogSink sink) {
         using namespace std;
 
-        auto it = find(begin(m_Sinks), end(m_Sinks), sink);
+        lock_guard<mutex> guard(m_SinkMutex);
 
-        if (it == end(m_Sinks))
-            m_Sinks.push_back(std::forward<LogSink>(sink));
+        const auto* current = m_Sinks.load();
+        auto        it = find_if(begin(*current), end(*current), [&](const auto& entry) { return entry->m_Sink == sink; });
+
+        if (it == end(*current)) {
+            auto sinks = make_unique<SinkList>(*current);
+            sinks->push_back(make_shared<SinkEntry>(std::move(sink)));
+
+            replaceSinks(std::move(sinks));
+        }
         // else // silently fail if the sink is already present
     }
 
     void Logger::remove(LogSink sink) {
         using namespace std;
 
-        auto it = find(begin(m_Sinks), end(m_Sinks), sink);
+        lock_guard<mutex> guard(m_SinkMutex);
+
+        const auto* current = m_Sinks.load();
+        auto        it = find_if(begin(*current), end(*current), [&](const auto& entry) { return entry->m_Sink == sink; });
 
-        if (it != end(m_Sinks))
-            m_Sinks.erase(it);
+        if (it != end(*current)) {
+            auto sinks = make_unique<SinkList>(*current);
+            sinks->erase(sinks->begin() + distance(begin(*current), it));
+
+            replaceSinks(std::move(sinks));
+        }
         // else // silently fail if the sink is not actually present
     }
 
     void Logger::removeAll() {
-        m_Sinks.clear();
+        std::lock_guard<std::mutex> guard(m_SinkMutex);
+        replaceSinks(std::make_unique<const SinkList>());
     }
 
     size_t Logger::getNumSinks() const {
-        return m_Sinks.size();
+        util::GracePeriod::ReadGuard guard(m_SinkGrace);
+        return m_Sinks.load()->size();
     }
 
     void Logger::flush(const LogMessage* message) {
-        std::string msg = message->m_Buffer.str();  // collapse the buffer into a regular string
+        // messages that didn't go through the macros may still be for a disabled category
+        if (!isLogCategoryActive(message->m_MetaInfo.m_Category))
+            return;
+
+        DJINN_PROFILE_ZONE("Logger::flush");
+
+        auto* site = message->m_Site;
+
+        // with the default (unlimited) settings there is nothing to track for the site, unless
+        // an earlier limit left suppressed messages to report
+        if (site) {
+            const auto& limit = m_RateLimits[selectRateLimit(site->getCategory())];
+
+            if (limit.m_CollapseRepeats || (limit.m_MaxMessages > 0) || m_HasPending)
+                if (!track(*site, limit, message->m_Buffer.view()))
+                    return;
+        }
+
+        submit(message->m_MetaInfo, message->m_Buffer);
+    }
+
+    bool Logger::track(LogSite& site, const LogRateLimit& limit, std::string_view text) {
+        uint64_t numRateLimited = 0;
+        uint64_t numCollapsed   = 0;
+
+        // only hash the text when it is actually compared
+        LogSite::Clock::time_point now;
+        size_t                     hash = 0;
+
+        if (limit.m_CollapseRepeats) {
+            now  = LogSite::Clock::now();
+            hash = std::hash<std::string_view>()(text);
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(site.m_Mutex);
+
+            if (limit.m_CollapseRepeats && site.m_HasLast && (site.m_LastHash == hash) &&
+                (now - site.m_LastWritten < limit.m_Interval)) {
+                ++site.m_PendingCollapsed;
+                ++site.m_NumCollapsed;
+                ++m_NumCollapsed;
+
+                m_HasPending = true;
+
+                return false;
+            }
+
+            // without collapsing, forget the previous message so it isn't compared once collapsing is enabled
+            site.m_HasLast     = limit.m_CollapseRepeats;
+            site.m_LastHash    = hash;
+            site.m_LastWritten = now;
+
+            std::swap(numRateLimited, site.m_PendingRateLimited);
+            std::swap(numCollapsed, site.m_PendingCollapsed);
+        }
+
+        reportSuppressed(site, numRateLimited, numCollapsed);
+
+        return true;
+    }
+
+    void Logger::pollSinks() {
+        util::GracePeriod::ReadGuard guard(m_SinkGrace);
+
+        for (const auto& entry : *m_Sinks.load()) {
+            // a sink that is busy is being written to, which polls it anyway
+            std::unique_lock<std::mutex> lock(entry->m_Mutex, std::try_to_lock);
+
+            if (lock.owns_lock())
+                entry->m_Sink.poll();
+        }
+    }
+
+    void Logger::submit(const LogMessage::MetaInfo& meta, const LogBuffer& message) {
+        // [NOTE] only async mode copies the text, the sinks get to see the buffer of the message
+        if (m_Writer)
+            m_Writer->push(LogWriter::Record{meta, message});
+        else
+            write(meta, message.view());
+    }
+
+    void Logger::setAsync(bool enabled) {
+        if (enabled == isAsync())
+            return;
+
+        if (enabled)
+            m_Writer = std::make_unique<LogWriter>(
+                [this](const LogWriter::Record& record) { write(record.m_MetaInfo, record.m_Text.view()); },
+                m_QueueCapacity,
+                m_OverflowPolicy,
+                [this] { pollSinks(); });
+        else
+            m_Writer.reset();  // joins the writer thread after it has drained the queue
+    }
+
+    bool Logger::isAsync() const {
+        return m_Writer != nullptr;
+    }
+
+    void Logger::setQueueCapacity(size_t capacity) {
+        m_QueueCapacity = capacity;
+    }
+
+    size_t Logger::getQueueCapacity() const {
+        return m_QueueCapacity;
+    }
+
+    void Logger::setOverflowPolicy(eOverflowPolicy policy) {
+        m_OverflowPolicy = policy;
+    }
+
+    Logger::eOverflowPolicy Logger::getOverflowPolicy() const {
+        return m_OverflowPolicy;
+    }
+
+    size_t Logger::getNumDropped() const {
+        if (m_Writer)
+            return m_Writer->getNumDropped();
+
+        return 0;
+    }
+
+    void Logger::sync() {
+        if (m_Writer)
+            m_Writer->sync();
+    }
+
+    void Logger::setRateLimit(eLogCategory category, const LogRateLimit& limit) {
+        // FATAL messages are never limited
+        if (category == eLogCategory::FATAL)
+            return;
+
+        m_RateLimits[selectRateLimit(category)] = limit;
+    }
+
+    LogRateLimit Logger::getRateLimit(eLogCategory category) const {
+        return m_RateLimits[selectRateLimit(category)];
+    }
+
+    uint64_t Logger::getNumRateLimited() const {
+        return m_NumRateLimited;
+    }
+
+    uint64_t Logger::getNumCollapsed() const {
+        return m_NumCollapsed;
+    }
+
+    void Logger::reportSuppressed() {
+        m_HasPending = false;
+
+        for (auto* site = LogSite::getFirst(); site; site = site->getNext()) {
+            uint64_t numRateLimited = 0;
+            uint64_t numCollapsed   = 0;
+
+            {
+                std::lock_guard<std::mutex> guard(site->m_Mutex);
+
+                std::swap(numRateLimited, site->m_PendingRateLimited);
+                std::swap(numCollapsed, site->m_PendingCollapsed);
+            }
+
+            reportSuppressed(*site, numRateLimited, numCollapsed);
+        }
+    }
+
+    void Logger::reportExpired() {
+        // cheap when nothing was suppressed, so this may be called every frame
+        if (!m_HasPending.exchange(false))
+            return;
+
+        auto now = LogSite::Clock::now();
+
+        for (auto* site = LogSite::getFirst(); site; site = site->getNext()) {
+            const auto& limit = m_RateLimits[selectRateLimit(site->getCategory())];
+
+            uint64_t numRateLimited = 0;
+            uint64_t numCollapsed   = 0;
+
+            {
+                std::lock_guard<std::mutex> guard(site->m_Mutex);
+
+                if (site->m_PendingRateLimited > 0) {
+                    if (now - site->m_WindowStart >= limit.m_Interval)
+                        std::swap(numRateLimited, site->m_PendingRateLimited);
+                    else
+                        m_HasPending = true;  // check again later
+                }
+
+                if (site->m_PendingCollapsed > 0) {
+                    if (now - site->m_LastWritten >= limit.m_Interval)
+                        std::swap(numCollapsed, site->m_PendingCollapsed);
+                    else
+                        m_HasPending = true;
+                }
+            }
+
+            reportSuppressed(*site, numRateLimited, numCollapsed);
+        }
+    }
+
+    void Logger::reportSuppressed(const LogSite& site, uint64_t numRateLimited, uint64_t numCollapsed) {
+        LogMessage::MetaInfo meta{site.getCategory(), site.getSourceFile(), site.getSourceLine()};
+        LogBuffer            text;
+
+        if (numCollapsed > 0) {
+            text.append("last message repeated ");
+            text.appendInteger(numCollapsed);
+            text.append(" times");
+
+            submit(meta, text);
+        }
+
+        if (numRateLimited > 0) {
+            text.clear();
+            text.appendInteger(numRateLimited);
+            text.append(" messages were suppressed (rate limit)");
+
+            submit(meta, text);
+        }
+    }
+
+    void Logger::write(const LogMessage::MetaInfo& meta, std::string_view message) {
+        util::GracePeriod::ReadGuard guard(m_SinkGrace);  // keeps the snapshot alive
+
+        const auto& sinks = *m_Sinks.load();
+
+        // first write to the sinks that are available right away, then to the ones that were busy
+        // [NOTE] only the first 64 sinks are tracked; any others are simply waited for
+        constexpr size_t k_MaxTracked = 64;
+
+        size_t   numSinks   = sinks.size();
+        size_t   numTracked = std::min(numSinks, k_MaxTracked);
+        uint64_t pending    = (numTracked < k_MaxTracked) ? ((uint64_t(1) << numTracked) - 1) : ~uint64_t(0);
+
+        while (pending != 0) {
+            bool isProgressing = false;
+
+            for (size_t i = 0; i < numTracked; ++i) {
+                uint64_t bit = uint64_t(1) << i;
+
+                if (!(pending & bit))
+                    continue;
+
+                std::unique_lock<std::mutex> lock(sinks[i]->m_Mutex, std::try_to_lock);
+
+                if (lock.owns_lock()) {
+                    sinks[i]->m_Sink.write(meta, message);
+
+                    pending &= ~bit;
+                    isProgressing = true;
+                }
+            }
+
+            // everything that is left is busy, so wait for one of them
+            if (!isProgressing) {
+                size_t i = 0;
+
+                while (!(pending & (uint64_t(1) << i)))
+                    ++i;
+
+                std::lock_guard<std::mutex> lock(sinks[i]->m_Mutex);
+                sinks[i]->m_Sink.write(meta, message);
+
+                pending &= ~(uint64_t(1) << i);
+            }
+        }
+
+        for (size_t i = numTracked; i < numSinks; ++i) {
+            std::lock_guard<std::mutex> lock(sinks[i]->m_Mutex);
+            sinks[i]->m_Sink.write(meta, message);
+        }
+    }
+
+    void Logger::replaceSinks(std::unique_ptr<const SinkList> sinks) {
+        const auto* previous = m_Sinks.exchange(sinks.release());
+
+        // wait for the threads that may still be writing to the previous snapshot
+        m_SinkGrace.wait();
 
-        for (auto& sink : m_Sinks)
-            sink.write(message->m_MetaInfo, msg);
+        delete previous;
     }
 
     Logger& Logger::instance() {
@@ -2,19 +2,56 @@
 
 #include "log_category.h"
 #include "log_message.h"
+#include "log_site.h"
 #include "log_sink.h"
+#include "log_writer.h"
 
+#include "util/grace_period.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 namespace djinn::core {
+    // By default messages are written to every sink by the thread that logs them. In async
+    // mode they are queued instead and written by a background thread (see LogWriter), which
+    // keeps the cost of logging on the calling thread low.
+    //
+    // Sinks may be added or removed at any time; logging works on a snapshot of the sink list
+    // that is replaced as a whole on change. Loggers only announce themselves to a GracePeriod
+    // while using a snapshot, and a replaced snapshot is deleted once they're done with it, so
+    // the list is never locked (or reference counted) while logging.
+    // Each sink has a lock of its own, so a sink is only ever used by one thread at a time; a
+    // thread that finds a sink busy writes to the other sinks first and comes back to it later,
+    // so threads logging at the same time are spread over the sinks instead of all queueing up
+    // behind the first one. In async mode only the writer thread uses the sinks.
+    //
+    // Messages from the logging macros may be subject to a LogRateLimit per call site, configured
+    // per category; a site may then write a limited number of messages per interval, and
+    // identical consecutive messages can be collapsed into a 'last message repeated N times'
+    // line. By default nothing is limited, and FATAL messages never are. Suppressed messages
+    // are reported with the next message of the site, or by reportExpired() once the interval
+    // has passed.
+    //
+    // [NOTE] sinks are not written to anymore once remove() has returned, which also means that
+    //        sinks must not add or remove sinks themselves (that would deadlock)
+    // [NOTE] the async settings and rate limits should be changed while nothing else is logging
+    //        (at startup)
     class Logger {
     public:
+        using eOverflowPolicy = LogWriter::eOverflowPolicy;
+
         explicit Logger() = default;  // allow for default construction, but make it explicit
         Logger(const std::string&
                    filename);  // this is the real default -- log to both a file and std::cout
+        ~Logger();
 
-        LogMessage
-            operator()(eLogCategory category, const std::string& sourceFilename, int sourceLine);
+        LogMessage operator()(eLogCategory category, const char* sourceFilename, int sourceLine);
+
+        // yields false if the rate limit of the site doesn't allow another message right now;
+        // otherwise the next message created by this thread is associated with the site
+        bool admit(LogSite& site);
 
         void   add(LogSink sink);
         void   remove(LogSink sink);
@@ -23,25 +60,129 @@ namespace djinn::core {
 
         void flush(const LogMessage* message);
 
+        // gives the sinks a chance to write out text they're holding on to (see LogSink::poll);
+        // in async mode the writer thread does this whenever it is idle
+        void pollSinks();
+
+        // the queue capacity and overflow policy are applied when async mode is enabled
+        void            setAsync(bool enabled);
+        bool            isAsync() const;
+        void            setQueueCapacity(size_t capacity);
+        size_t          getQueueCapacity() const;
+        void            setOverflowPolicy(eOverflowPolicy policy);
+        eOverflowPolicy getOverflowPolicy() const;
+        size_t          getNumDropped() const;  // since async mode was enabled
+
+        void sync();  // waits until every message so far has been written (no-op if not async)
+
+        void         setRateLimit(eLogCategory category, const LogRateLimit& limit);  // ignored for FATAL
+        LogRateLimit getRateLimit(eLogCategory category) const;
+        uint64_t     getNumRateLimited() const;  // over all sites
+        uint64_t     getNumCollapsed() const;    // over all sites
+        void         reportSuppressed();         // writes the pending counts of every site
+        void         reportExpired();            // same, but only for sites whose interval has passed
+
         // this class is provided both as a singleton and a regular object; :instance()
         // yields the singleton, obviously
         static Logger& instance();
 
     private:
-        std::vector<LogSink> m_Sinks;
+        struct SinkEntry {
+            explicit SinkEntry(LogSink&& sink);
+
+            LogSink    m_Sink;
+            std::mutex m_Mutex;  // sinks are not required to be thread safe
+        };
+
+        using SinkList = std::vector<std::shared_ptr<SinkEntry>>;
+
+        void submit(const LogMessage::MetaInfo& meta, const LogBuffer& message);  // to the writer or the sinks
+        void write(const LogMessage::MetaInfo& meta, std::string_view message);
+
+        bool track(LogSite& site, const LogRateLimit& limit, std::string_view text);  // false if collapsed
+        void reportSuppressed(const LogSite& site, uint64_t numRateLimited, uint64_t numCollapsed);
+
+        void replaceSinks(std::unique_ptr<const SinkList> sinks);  // with m_SinkMutex held
+
+        std::mutex                   m_SinkMutex;  // serializes changes to the sink list
+        std::atomic<const SinkList*> m_Sinks = new const SinkList();
+        mutable util::GracePeriod    m_SinkGrace;  // covers every use of a snapshot
+
+        std::unique_ptr<LogWriter> m_Writer;  // only when async
+        size_t                     m_QueueCapacity  = 8192;
+        eOverflowPolicy            m_OverflowPolicy = eOverflowPolicy::BLOCK;
+
+        LogRateLimit m_RateLimits[5];  // per category, unlimited by default
+
+        std::atomic<uint64_t> m_NumRateLimited = 0;
+        std::atomic<uint64_t> m_NumCollapsed   = 0;
+        std::atomic_bool      m_HasPending     = false;  // some site has suppressed messages that weren't reported
     };
 }  // namespace djinn::core
 
+namespace djinn::core::detail {
+    // lets the logging macros be a single expression that yields void either way
+    struct LogVoidify {
+        void operator&(const LogMessage&) {}
+    };
+
+    // stands in for a LogMessage when a category was compiled out; never evaluated
+    struct NullLogMessage {
+        template <typename T>
+        NullLogMessage& operator<<(const T&) {
+            return *this;
+        }
+
+        NullLogMessage& operator<<(std::ostream& (*)(std::ostream&)) { return *this; }
+    };
+
+    struct NullLogVoidify {
+        void operator&(const NullLogMessage&) {}
+    };
+}  // namespace djinn::core::detail
+
 // some macros that make it as painless as possible to log something
+//
+// When a category is disabled (or the rate limit of the call site was reached) no LogMessage
+// is created and none of the streamed values are evaluated; categories below
+// DJINN_MIN_LOG_LEVEL (see compile_options.h) are removed entirely.
+// [NOTE] these expand to a conditional expression, so they can only be used as a statement
 #define gLogCategory(category)                                                                     \
-    (::djinn::core::Logger::instance()(::djinn::core::eLogCategory::category, __FILE__, __LINE__))
+    !::djinn::core::isLogCategoryActive(::djinn::core::eLogCategory::category) ||                  \
+            !::djinn::core::Logger::instance().admit(DJINN_LOG_SITE(category))                     \
+        ? (void)0                                                                                  \
+        : ::djinn::core::detail::LogVoidify() &                                                    \
+              ::djinn::core::Logger::instance()(::djinn::core::eLogCategory::category, DJINN_SOURCE_FILENAME, __LINE__)
 
-#define gLog (gLogCategory(MESSAGE))
+#define gLogDiscarded                                                                              \
+    true ? (void)0 : ::djinn::core::detail::NullLogVoidify() & ::djinn::core::detail::NullLogMessage()
 
 // clang-format off
-#define gLogDebug   (gLogCategory(DEBUG))
-#define gLogMessage (gLogCategory(MESSAGE))
-#define gLogError   (gLogCategory(ERROR_))
-#define gLogWarning (gLogCategory(WARNING))
-#define gLogFatal   (gLogCategory(FATAL))
+#if DJINN_MIN_LOG_LEVEL <= 0
+#define gLogDebug   gLogCategory(DEBUG)
+#else
+#define gLogDebug   gLogDiscarded
+#endif
+
+#if DJINN_MIN_LOG_LEVEL <= 1
+#define gLog        gLogCategory(MESSAGE)
+#define gLogMessage gLogCategory(MESSAGE)
+#else
+#define gLog        gLogDiscarded
+#define gLogMessage gLogDiscarded
+#endif
+
+#if DJINN_MIN_LOG_LEVEL <= 2
+#define gLogWarning gLogCategory(WARNING)
+#else
+#define gLogWarning gLogDiscarded
+#endif
+
+#if DJINN_MIN_LOG_LEVEL <= 3
+#define gLogError   gLogCategory(ERROR_)
+#else
+#define gLogError   gLogDiscarded
+#endif
+
+#define gLogFatal   gLogCategory(FATAL)
 // clang-format on
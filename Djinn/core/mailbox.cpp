@@ -0,0 +1,75 @@
+#include "mailbox.h"
+#include "profile_zone.h"
+
+#include <iterator>
+
+namespace djinn::core {
+    Mailbox::Mailbox():
+        m_Owner(std::this_thread::get_id()) {}
+
+    Mailbox::~Mailbox() {
+        delete m_Wakeup.load();
+    }
+
+    Mailbox& Mailbox::current() {
+        thread_local Mailbox t_Mailbox;
+        return t_Mailbox;
+    }
+
+    void Mailbox::post(Letter letter) {
+        m_Letters.enqueue(std::move(letter));
+
+        util::GracePeriod::ReadGuard reading(m_WakeupGrace);
+
+        if (const auto* wakeup = m_Wakeup.load())
+            (*wakeup)();
+    }
+
+    size_t Mailbox::drain() {
+        // only process what is there right now, letters posted while draining are left for next time
+        size_t count = m_Letters.size_approx();
+        if ((count == 0) || m_Draining)
+            return 0;
+
+        struct DrainGuard {
+            bool& m_Flag;
+
+            DrainGuard(bool& flag): m_Flag(flag) { m_Flag = true; }
+            ~DrainGuard() { m_Flag = false; }
+        } guard(m_Draining);
+
+        DJINN_PROFILE_ZONE("Mailbox::drain");
+
+        m_Batch.clear();
+        m_Batch.reserve(count);
+        count = m_Letters.try_dequeue_bulk(std::back_inserter(m_Batch), count);
+
+        for (auto& letter : m_Batch)
+            letter();
+
+        m_Batch.clear();
+
+        return count;
+    }
+
+    bool Mailbox::isEmpty() const {
+        return m_Letters.size_approx() == 0;
+    }
+
+    void Mailbox::setWakeup(Wakeup wakeup) {
+        const auto* previous = m_Wakeup.exchange(wakeup ? new Wakeup(std::move(wakeup)) : nullptr);
+
+        // wait for the posts that may still be calling the previous one
+        m_WakeupGrace.wait();
+
+        delete previous;
+    }
+
+    std::thread::id Mailbox::getOwner() const {
+        return m_Owner;
+    }
+
+    bool Mailbox::isOwnedByCurrentThread() const {
+        return m_Owner == std::this_thread::get_id();
+    }
+}  // namespace djinn::core
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "third_party.h"
+#include "util/grace_period.h"
+#include "util/inplace_function.h"
+
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace djinn::core {
+    // A lock-free queue of work for a specific thread. Every thread has its own mailbox, and
+    // message handlers may be registered with one; messages for such a handler that are
+    // broadcast on other threads are then delivered through the mailbox, when its thread
+    // calls drain().
+    //
+    // The engine drains the mailbox of the main thread at the start of every frame, and the
+    // scheduler workers drain theirs whenever they pick up work or are woken up by a letter.
+    // Any other thread that owns handlers should do so at a point where that is safe, and may
+    // install a wakeup callback to learn about new letters while it is idle.
+    //
+    // Letters are stored inline (see util::InplaceFunction), so posting small ones doesn't allocate.
+    // Posting never locks; the wakeup callback is published atomically as well, replacing it waits
+    // until no post() is still calling the previous one.
+    //
+    // [NOTE] handlers should be removed before the thread (and its mailbox) goes away
+    class Mailbox {
+    public:
+        using Letter = util::InplaceFunction<void(), 96>;
+        using Wakeup = std::function<void()>;
+
+        Mailbox();
+        ~Mailbox();
+
+        Mailbox(const Mailbox&) = delete;
+        Mailbox& operator=(const Mailbox&) = delete;
+        Mailbox(Mailbox&&)                 = delete;
+        Mailbox& operator=(Mailbox&&) = delete;
+
+        static Mailbox& current();  // the mailbox of the calling thread
+
+        void   post(Letter letter);  // may be called from any thread
+        size_t drain();              // [NOTE] owning thread only, not reentrant; yields the number of letters processed
+        bool   isEmpty() const;
+
+        void setWakeup(Wakeup wakeup);  // called after every post(), from the posting thread (so it should be cheap)
+
+        std::thread::id getOwner() const;
+        bool            isOwnedByCurrentThread() const;
+
+    private:
+        moodycamel::ConcurrentQueue<Letter> m_Letters;
+        std::vector<Letter>                 m_Batch;  // reused between drains
+        bool                                m_Draining = false;
+        std::thread::id                     m_Owner;
+
+        std::atomic<const Wakeup*> m_Wakeup = nullptr;
+        util::GracePeriod          m_WakeupGrace;  // posts that may still be calling the previous wakeup
+    };
+}  // namespace djinn::core
@@ -0,0 +1,68 @@
+#include "mediator.h"
+
+#include <algorithm>
+
+namespace djinn {
+    void dispatch() {
+        core::detail::dispatchAll();
+    }
+}  // namespace djinn
+
+namespace djinn::core::detail {
+    namespace {
+        // a copy-on-write list allows dispatchAll() to run without holding a lock while
+        // handlers are invoked; queues unregister themselves when they are destroyed (at
+        // static destruction), which waits for any dispatchAll() that may still use them
+        // [NOTE] function-local so it is available during static initialization as well;
+        //        it is constructed before the first queue, so it also outlives all of them
+        using QueueList = std::vector<MediatorQueueBase*>;
+
+        struct Registry {
+            std::mutex                       m_Mutex;
+            std::shared_ptr<const QueueList> m_Queues = std::make_shared<const QueueList>();
+            util::GracePeriod                m_Readers;
+        };
+
+        Registry& getRegistry() {
+            static Registry result;
+            return result;
+        }
+    }  // namespace
+
+    void registerQueue(MediatorQueueBase* queue) {
+        auto& registry = getRegistry();
+
+        std::lock_guard<std::mutex> guard(registry.m_Mutex);
+
+        auto list = std::make_shared<QueueList>(*std::atomic_load(&registry.m_Queues));
+        list->push_back(queue);
+
+        std::atomic_store(&registry.m_Queues, std::shared_ptr<const QueueList>(std::move(list)));
+    }
+
+    void unregisterQueue(MediatorQueueBase* queue) {
+        auto& registry = getRegistry();
+
+        {
+            std::lock_guard<std::mutex> guard(registry.m_Mutex);
+
+            auto list = std::make_shared<QueueList>(*std::atomic_load(&registry.m_Queues));
+            list->erase(std::remove(list->begin(), list->end(), queue), list->end());
+
+            std::atomic_store(&registry.m_Queues, std::shared_ptr<const QueueList>(std::move(list)));
+        }
+
+        registry.m_Readers.wait();
+    }
+
+    void dispatchAll() {
+        auto& registry = getRegistry();
+
+        util::GracePeriod::ReadGuard reading(registry.m_Readers);
+
+        auto queues = std::atomic_load(&registry.m_Queues);
+
+        for (auto* queue : *queues)
+            queue->dispatch();
+    }
+}  // namespace djinn::core::detail
@@ -3,9 +3,21 @@
 #include "mediator_queue.h"
 
 namespace djinn {
+    // By default handlers are invoked on the thread that broadcasts (or dispatches) a message.
+    // Handlers that should only be invoked on a specific thread may be registered with its
+    // mailbox; messages from other threads are then delivered when that mailbox is drained.
+    enum class eDelivery
+    {
+        ANY_THREAD,
+        OWNER_THREAD  // the thread that registered the handler
+    };
+
     template <typename T, typename H>
     void add_handler(H* handler);
 
+    template <typename T, typename H>
+    void add_handler(H* handler, core::Mailbox& mailbox);
+
     template <typename T, typename H>
     void remove_handler(H* handler);
 
@@ -13,13 +25,23 @@ namespace djinn {
     void remove_all_handlers();
 
     template <typename T>
-    void broadcast(const T& message);
+    void broadcast(const T& message);  // synchronous, handlers are invoked on the calling thread
+
+    // deferred; the message is queued until dispatch() is called (typically by the engine, once
+    // per frame) and then delivered in a batch together with the other messages of the same type
+    template <typename T>
+    void post(T&& message);
+
+    template <typename T>
+    void dispatch();  // just the messages of type T
+
+    void dispatch();  // all message types
 
     // [NOTE] this *can* be used as a base class, but it's not required
     template <typename T>
     class MessageHandler {
     public:
-        MessageHandler();
+        explicit MessageHandler(eDelivery delivery = eDelivery::ANY_THREAD);
         virtual ~MessageHandler();
 
         MessageHandler(const MessageHandler&) = default;
@@ -29,6 +51,21 @@ namespace djinn {
 
         virtual void operator()(const T& message) = 0;
     };
+
+    // Receives posted messages as a batch (a single message when broadcasted)
+    template <typename T>
+    class BatchMessageHandler {
+    public:
+        explicit BatchMessageHandler(eDelivery delivery = eDelivery::ANY_THREAD);
+        virtual ~BatchMessageHandler();
+
+        BatchMessageHandler(const BatchMessageHandler&) = default;
+        BatchMessageHandler& operator=(const BatchMessageHandler&) = default;
+        BatchMessageHandler(BatchMessageHandler&&)                 = default;
+        BatchMessageHandler& operator=(BatchMessageHandler&&) = default;
+
+        virtual void operator()(absl::Span<const T> messages) = 0;
+    };
 }  // namespace djinn
 
 #include "mediator.inl"
@@ -2,12 +2,19 @@
 
 #include "mediator.h"
 
+#include <type_traits>
+
 namespace djinn {
     template <typename T, typename H>
     void add_handler(H* handler) {
         core::detail::MediatorQueue<T>::instance().add(handler);
     }
 
+    template <typename T, typename H>
+    void add_handler(H* handler, core::Mailbox& mailbox) {
+        core::detail::MediatorQueue<T>::instance().add(handler, &mailbox);
+    }
+
     template <typename T, typename H>
     void remove_handler(H* handler) {
         core::detail::MediatorQueue<T>::instance().remove(handler);
@@ -24,12 +31,40 @@ namespace djinn {
     }
 
     template <typename T>
-    MessageHandler<T>::MessageHandler() {
-        add_handler<T>(this);
+    void post(T&& message) {
+        using Message = std::decay_t<T>;
+
+        core::detail::MediatorQueue<Message>::instance().post(std::forward<T>(message));
+    }
+
+    template <typename T>
+    void dispatch() {
+        core::detail::MediatorQueue<T>::instance().dispatch();
+    }
+
+    template <typename T>
+    MessageHandler<T>::MessageHandler(eDelivery delivery) {
+        if (delivery == eDelivery::OWNER_THREAD)
+            add_handler<T>(this, core::Mailbox::current());
+        else
+            add_handler<T>(this);
     }
 
     template <typename T>
     MessageHandler<T>::~MessageHandler() {
         remove_handler<T>(this);
     }
+
+    template <typename T>
+    BatchMessageHandler<T>::BatchMessageHandler(eDelivery delivery) {
+        if (delivery == eDelivery::OWNER_THREAD)
+            add_handler<T>(this, core::Mailbox::current());
+        else
+            add_handler<T>(this);
+    }
+
+    template <typename T>
+    BatchMessageHandler<T>::~BatchMessageHandler() {
+        remove_handler<T>(this);
+    }
 }  // namespace djinn
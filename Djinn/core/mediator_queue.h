@@ -1,20 +1,67 @@
 #pragma once
 
-#include <functional>
+#include "mailbox.h"
+#include "message_policy.h"
+#include "third_party.h"
+#include "util/delegate.h"
+#include "util/grace_period.h"
+
+#include <atomic>
 #include <mutex>
 #include <vector>
 
 namespace djinn::core::detail {
+    // type-erased interface, so all queues can be pumped at once (see djinn::dispatch)
+    class MediatorQueueBase {
+    public:
+        virtual ~MediatorQueueBase() = default;
+
+        virtual void dispatch() = 0;
+    };
+
+    void registerQueue(MediatorQueueBase* queue);
+    void unregisterQueue(MediatorQueueBase* queue);  // waits for dispatchAll() calls in progress
+    void dispatchAll();
+
+    // The handlers are kept in an immutable list that is replaced as a whole (copy-on-write)
+    // whenever a handler is added or removed. Broadcasting just grabs the current list and
+    // iterates it, so it never blocks on (or copies for) the registration of handlers.
+    //
+    // [NOTE] a broadcast that is in progress keeps using the list it started with; add(), remove()
+    //        and removeAll() wait (without spinning) until every broadcast, dispatch or mailbox
+    //        delivery that might still use an older list has completed, and only then delete it.
+    //        From within a handler they can't wait, so the old lists are kept until the next
+    //        change that is made outside of a handler. A handler must therefore never wait for a
+    //        thread that adds or removes handlers of the same message type.
+    //
+    // Messages may also be posted, in which case they're stored in a concurrent queue until
+    // dispatch() is called; then the whole batch is delivered to each handler in turn. Handlers
+    // that accept an absl::Span<const T> receive the batch in a single call.
+    //
+    // Posted messages may be coalesced into a single one per dispatch, see MessagePolicy.
+    //
+    // [NOTE] posted messages from a single thread are delivered in order, but there is no
+    //        ordering between messages posted from different threads
+    // [NOTE] no lock is held while the handlers run, so a handler may call dispatch() again;
+    //        that delivers whatever was posted after the current batch was taken
     template <typename T>
-    class MediatorQueue {
+    class MediatorQueue: public MediatorQueueBase {
     private:
-        MediatorQueue() = default;
+        MediatorQueue();
 
     public:
+        ~MediatorQueue() override;
+
+        MediatorQueue(const MediatorQueue&) = delete;
+        MediatorQueue& operator=(const MediatorQueue&) = delete;
+        MediatorQueue(MediatorQueue&&)                 = delete;
+        MediatorQueue& operator=(MediatorQueue&&) = delete;
+
         static MediatorQueue& instance();
 
+        // with a mailbox, messages broadcast on other threads are delivered through it
         template <typename H>
-        void add(H* handler);
+        void add(H* handler, Mailbox* mailbox = nullptr);
 
         // [NOTE] possibly the H template is not needed here, but I keep it for symmetry
         template <typename H>
@@ -22,16 +69,51 @@ namespace djinn::core::detail {
 
         void removeAll();
 
-        void broadcast(const T& message);
+        void broadcast(const T& message);  // delivers immediately, on the calling thread
+
+        void post(const T& message);
+        void post(T&& message);
+        void dispatch() override;  // delivers everything that was posted so far
 
     private:
+        template <typename H>
+        static void deliverEach(void* handler, absl::Span<const T> messages);
+
+        template <typename H>
+        static void deliverBatch(void* handler, absl::Span<const T> messages);
+
         using Mutex     = std::mutex;
         using LockGuard = std::lock_guard<Mutex>;
-        using Handler   = std::function<void(const T&)>;
+        // every handler is invoked with a span of messages; for handlers that take a
+        // single message the thunk loops over the span
+        using Handler = util::Delegate<void(absl::Span<const T>)>;
+
+        struct Entry {
+            Handler  m_Handler;
+            uint64_t m_Id;       // unique per registration, the handler address may be reused
+            Mailbox* m_Mailbox;  // nullptr if the handler may be invoked on any thread
+        };
+
+        using HandlerList = std::vector<Entry>;  // trivially copyable, contiguous
+
+        static void coalesce(std::vector<T>& batch);  // applies MessagePolicy<T>
+        void deliver(const Entry& entry, absl::Span<const T> messages);
+        bool isRegistered(uint64_t id) const;
+
+        void replaceHandlers(const HandlerList* list);  // [NOTE] expects m_Mutex to be locked
+        void waitForReaders();                          // then deletes the replaced lists, unless called from within a handler
+
+        Mutex                           m_Mutex;  // serializes modifications, broadcast doesn't need it
+        std::atomic<const HandlerList*> m_Handlers = new const HandlerList();
+        std::vector<const HandlerList*> m_Retired;  // replaced, but possibly still in use by a reader
+        uint64_t                        m_NextId = 1;
+        util::GracePeriod               m_Readers;  // everything that delivers messages counts as a reader
+
+        static thread_local int t_BroadcastDepth;  // nesting of broadcasts on the current thread
 
-        Mutex                m_Mutex;
-        std::vector<Handler> m_Handlers;
-        std::vector<void*>   m_Originals;
+        moodycamel::ConcurrentQueue<T> m_Pending;
+        Mutex                          m_SpareMutex;
+        std::vector<T>                 m_Spare;  // keeps the capacity of the last batch for the next dispatch
     };
 }  // namespace djinn::core::detail
 
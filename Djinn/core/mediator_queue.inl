@@ -2,12 +2,32 @@
 
 #include "logger.h"
 #include "mediator_queue.h"
+#include "profile_zone.h"
 #include "util/algorithm.h"
 
 #include <algorithm>
-#include <iterator>  // for std::distance
+#include <iterator>
+#include <type_traits>
 
 namespace djinn::core::detail {
+    template <typename T>
+    thread_local int MediatorQueue<T>::t_BroadcastDepth = 0;
+
+    template <typename T>
+    MediatorQueue<T>::MediatorQueue() {
+        registerQueue(this);
+    }
+
+    template <typename T>
+    MediatorQueue<T>::~MediatorQueue() {
+        unregisterQueue(this);
+
+        for (const auto* list : m_Retired)
+            delete list;
+
+        delete m_Handlers.load();
+    }
+
     template <typename T>
     MediatorQueue<T>& MediatorQueue<T>::instance() {
         static MediatorQueue<T> specific;
@@ -16,11 +36,25 @@ namespace djinn::core::detail {
 
     template <typename T>
     template <typename H>
-    void MediatorQueue<T>::add(H* handler) {
-        LockGuard guard(m_Mutex);
+    void MediatorQueue<T>::add(H* handler, Mailbox* mailbox) {
+        {
+            LockGuard guard(m_Mutex);
 
-        m_Handlers.push_back([handler](const T& message) { (*handler)(message); });
-        m_Originals.push_back(handler);
+            Entry entry{Handler(), m_NextId++, mailbox};
+
+            if constexpr (std::is_invocable_v<H&, absl::Span<const T>>)
+                entry.m_Handler = Handler(handler, &deliverBatch<H>);
+            else
+                entry.m_Handler = Handler(handler, &deliverEach<H>);
+
+            auto* list = new HandlerList(*m_Handlers.load());
+            list->push_back(entry);
+
+            replaceHandlers(list);
+        }
+
+        // so the previous list can be deleted
+        waitForReaders();
     }
 
     template <typename T>
@@ -28,38 +62,227 @@ namespace djinn::core::detail {
     void MediatorQueue<T>::remove(H* handler) {
         using namespace std;
 
-        LockGuard guard(m_Mutex);
+        {
+            LockGuard guard(m_Mutex);
+
+            const auto* previous = m_Handlers.load();
+
+            // [NOTE] matched by object only; H doesn't have to be the type the handler was added with
+            void* object = handler;
 
-        auto it = find(begin(m_Originals), end(m_Originals), handler);
+            auto it = find_if(begin(*previous), end(*previous), [object](const Entry& entry) {
+                return entry.m_Handler.getObject() == object;
+            });
 
-        if (it != end(m_Originals)) {
-            size_t index = distance(begin(m_Originals), it);
+            if (it == end(*previous)) {
+                gLogError << "Tried to remove an unregistered message handler";
+                return;
+            }
 
-            m_Originals.erase(it);
-            m_Handlers.erase(begin(m_Handlers) + index);
+            auto* list = new HandlerList();
+            list->reserve(previous->size() - 1);
+
+            for (const auto& entry : *previous)
+                if (entry.m_Handler.getObject() != object)
+                    list->push_back(entry);
+
+            replaceHandlers(list);
         }
-        else
-            gLogError << "Tried to remove an unregistered message handler";
+
+        // so the handler may be destroyed as soon as this returns
+        waitForReaders();
     }
 
     template <typename T>
     void MediatorQueue<T>::removeAll() {
-        LockGuard guard(m_Mutex);
+        {
+            LockGuard guard(m_Mutex);
 
-        m_Handlers.clear();
-        m_Originals.clear();
+            replaceHandlers(new const HandlerList());
+        }
+
+        waitForReaders();
     }
 
     template <typename T>
     void MediatorQueue<T>::broadcast(const T& message) {
-        std::vector<Handler> localCopy;
+        DJINN_PROFILE_ZONE("MediatorQueue::broadcast");
+
+        struct DepthGuard {
+            DepthGuard() { ++t_BroadcastDepth; }
+            ~DepthGuard() { --t_BroadcastDepth; }
+        } depth;
+
+        util::GracePeriod::ReadGuard reading(m_Readers);
+
+        const auto* snapshot = m_Handlers.load();
+
+        auto batch = absl::Span<const T>(&message, 1);
+
+        for (const auto& entry : *snapshot)
+            deliver(entry, batch);
+    }
+
+    template <typename T>
+    void MediatorQueue<T>::post(const T& message) {
+        m_Pending.enqueue(message);
+    }
+
+    template <typename T>
+    void MediatorQueue<T>::post(T&& message) {
+        m_Pending.enqueue(std::move(message));
+    }
+
+    template <typename T>
+    void MediatorQueue<T>::dispatch() {
+        // only take what is pending right now; anything posted by the handlers
+        // is delivered by the next dispatch
+        size_t count = m_Pending.size_approx();
+        if (count == 0)
+            return;
+
+        DJINN_PROFILE_ZONE("MediatorQueue::dispatch");
+
+        // the batch is local, so no lock is needed while delivering it (which also allows
+        // handlers to dispatch again); only the spare capacity is shared
+        std::vector<T> batch;
+
+        {
+            LockGuard guard(m_SpareMutex);
+            batch.swap(m_Spare);
+        }
+
+        batch.clear();
+        batch.reserve(count);
+        m_Pending.try_dequeue_bulk(std::back_inserter(batch), count);
+
+        // [NOTE] a concurrent dispatch may have taken the messages first
+        if (!batch.empty()) {
+            coalesce(batch);
+
+            struct DepthGuard {
+                DepthGuard() { ++t_BroadcastDepth; }
+                ~DepthGuard() { --t_BroadcastDepth; }
+            } depth;
+
+            util::GracePeriod::ReadGuard reading(m_Readers);
+
+            const auto* snapshot = m_Handlers.load();
+            auto        messages = absl::Span<const T>(batch);
+
+            // deliver the whole batch to one handler at a time
+            for (const auto& entry : *snapshot)
+                deliver(entry, messages);
+        }
+
+        LockGuard guard(m_SpareMutex);
+
+        if (batch.capacity() > m_Spare.capacity())
+            m_Spare.swap(batch);
+    }
+
+    template <typename T>
+    void MediatorQueue<T>::coalesce(std::vector<T>& batch) {
+        constexpr eCoalescing policy = MessagePolicy<T>::k_Coalescing;
+
+        if constexpr (policy == eCoalescing::KEEP_LATEST) {
+            if (batch.size() > 1) {
+                batch.front() = std::move(batch.back());
+                batch.erase(std::next(batch.begin()), batch.end());
+            }
+        }
+        else if constexpr (policy == eCoalescing::ACCUMULATE) {
+            if (batch.size() > 1) {
+                for (auto it = std::next(batch.begin()); it != batch.end(); ++it)
+                    MessagePolicy<T>::accumulate(batch.front(), *it);
+
+                batch.erase(std::next(batch.begin()), batch.end());
+            }
+        }
+    }
+
+    template <typename T>
+    void MediatorQueue<T>::deliver(const Entry& entry, absl::Span<const T> messages) {
+        if (!entry.m_Mailbox || entry.m_Mailbox->isOwnedByCurrentThread()) {
+            entry.m_Handler(messages);
+            return;
+        }
+
+        // copy the messages and let the owning thread take care of them
+        auto letter = [this, handler = entry.m_Handler, id = entry.m_Id](absl::Span<const T> copy) {
+            struct DepthGuard {
+                DepthGuard() { ++t_BroadcastDepth; }
+                ~DepthGuard() { --t_BroadcastDepth; }
+            } depth;
+
+            // the handler may have been removed in the meantime; if it is removed while
+            // this runs, remove() waits for it
+            util::GracePeriod::ReadGuard reading(m_Readers);
+
+            if (isRegistered(id))
+                handler(copy);
+        };
+
+        // a single (small) message fits in the letter itself
+        if (messages.size() == 1)
+            entry.m_Mailbox->post([letter, message = messages.front()] { letter(absl::Span<const T>(&message, 1)); });
+        else
+            entry.m_Mailbox->post([letter, copy = std::vector<T>(messages.begin(), messages.end())] {
+                letter(absl::Span<const T>(copy));
+            });
+    }
+
+    template <typename T>
+    void MediatorQueue<T>::replaceHandlers(const HandlerList* list) {
+        m_Retired.push_back(m_Handlers.exchange(list));
+    }
+
+    template <typename T>
+    void MediatorQueue<T>::waitForReaders() {
+        // [NOTE] from within a handler this would be waiting for itself; the caller then has to
+        //        make sure the handler outlives the deliveries that are in progress (and the
+        //        replaced lists stay around until the next change outside of a handler)
+        if (t_BroadcastDepth > 0)
+            return;
+
+        // every list that was replaced so far; readers that may still use one of them started
+        // before it was replaced, so these are covered by the wait
+        std::vector<const HandlerList*> retired;
 
         {
             LockGuard guard(m_Mutex);
-            localCopy = m_Handlers;
+            retired.swap(m_Retired);
         }
 
-        for (const auto& handler : localCopy)
-            handler(message);
+        m_Readers.wait();
+
+        for (const auto* list : retired)
+            delete list;
+    }
+
+    template <typename T>
+    bool MediatorQueue<T>::isRegistered(uint64_t id) const {
+        const auto* snapshot = m_Handlers.load();
+
+        for (const auto& entry : *snapshot)
+            if (entry.m_Id == id)
+                return true;
+
+        return false;
+    }
+
+    template <typename T>
+    template <typename H>
+    void MediatorQueue<T>::deliverEach(void* handler, absl::Span<const T> messages) {
+        auto* h = static_cast<H*>(handler);
+
+        for (const auto& message : messages)
+            (*h)(message);
+    }
+
+    template <typename T>
+    template <typename H>
+    void MediatorQueue<T>::deliverBatch(void* handler, absl::Span<const T> messages) {
+        (*static_cast<H*>(handler))(messages);
     }
 }  // namespace djinn::core::detail
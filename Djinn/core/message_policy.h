@@ -0,0 +1,36 @@
+#pragma once
+
+namespace djinn {
+    // How posted messages of a type are combined before they are dispatched:
+    //
+    // KEEP_ALL:    every message is delivered (default)
+    // KEEP_LATEST: only the most recently posted message is delivered
+    // ACCUMULATE:  the batch is folded into the first message, with
+    //              MessagePolicy<T>::accumulate(T& total, const T& next)
+    //
+    // This only applies to messages that are posted; broadcasts are always delivered
+    // immediately. Messages that should never be lost (button presses, key strokes)
+    // should just keep the default.
+    //
+    // [NOTE] coalescing is per message type, so this is only appropriate if a single
+    //        source posts them or if it doesn't matter where they came from
+    enum class eCoalescing
+    {
+        KEEP_ALL,
+        KEEP_LATEST,
+        ACCUMULATE
+    };
+
+    // specialize to opt in to coalescing, f.e.
+    //
+    // template <>
+    // struct MessagePolicy<MyMessage> {
+    //     static constexpr eCoalescing k_Coalescing = eCoalescing::ACCUMULATE;
+    //
+    //     static void accumulate(MyMessage& total, const MyMessage& next);
+    // };
+    template <typename T>
+    struct MessagePolicy {
+        static constexpr eCoalescing k_Coalescing = eCoalescing::KEEP_ALL;
+    };
+}  // namespace djinn
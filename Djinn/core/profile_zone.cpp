@@ -0,0 +1,160 @@
+#include "profile_zone.h"
+
+#include <algorithm>
+
+namespace djinn::util::detail {
+    // declared in util/profile_zone_macro.h
+    std::atomic_bool g_ZoneRecording = false;
+
+    void recordZone(
+        const char*                           name,
+        std::chrono::steady_clock::time_point begin,
+        std::chrono::steady_clock::time_point end) {
+        core::ZoneCollector::instance().record({name, begin, end, std::this_thread::get_id()});
+    }
+}  // namespace djinn::util::detail
+
+namespace djinn::core {
+    namespace detail {
+        ZoneBuffer::ZoneBuffer(std::thread::id owner):
+            m_Owner(owner) {}
+
+        void ZoneBuffer::drain(std::vector<ZoneEvent>& out) {
+            auto tail = m_Tail.load(std::memory_order_relaxed);
+            auto head = m_Head.load(std::memory_order_acquire);
+
+            for (; tail != head; ++tail)
+                out.push_back(m_Events[tail & (k_Capacity - 1)]);
+
+            m_Tail.store(tail, std::memory_order_release);
+        }
+
+        std::thread::id ZoneBuffer::getOwner() const {
+            return m_Owner;
+        }
+
+        uint64_t ZoneBuffer::getNumDropped() const {
+            return m_NumDropped.load(std::memory_order_relaxed);
+        }
+
+        void ZoneBuffer::markOrphaned() {
+            m_IsOrphaned.store(true, std::memory_order_release);
+        }
+
+        bool ZoneBuffer::isOrphaned() const {
+            return m_IsOrphaned.load(std::memory_order_acquire);
+        }
+
+        namespace {
+            // marks the buffer when its thread exits, so the collector knows when it is done with it
+            struct ZoneBufferOwner {
+                ~ZoneBufferOwner() {
+                    if (m_Buffer)
+                        m_Buffer->markOrphaned();
+                }
+
+                std::shared_ptr<ZoneBuffer> m_Buffer;
+            };
+        }  // namespace
+    }  // namespace detail
+
+    ZoneCollector& ZoneCollector::instance() {
+        static ZoneCollector result;
+        return result;
+    }
+
+    void ZoneCollector::setEnabled(bool enabled) {
+        util::detail::g_ZoneRecording = enabled;
+    }
+
+    void ZoneCollector::collect() {
+        std::lock_guard<std::mutex> guard(m_Mutex);
+
+        m_Scratch.clear();
+
+        for (auto it = m_Buffers.begin(); it != m_Buffers.end();) {
+            // a buffer whose thread has exited can go once it's drained
+            // [NOTE] check this *before* draining; the flag is set after the last push of the thread
+            bool orphaned = (*it)->isOrphaned();
+
+            (*it)->drain(m_Scratch);
+
+            if (orphaned) {
+                m_NumDiscarded += (*it)->getNumDropped();
+                it = m_Buffers.erase(it);
+            }
+            else
+                ++it;
+        }
+
+        // each stream is ordered by end time (zones are pushed when they close), so
+        // merge everything by starting time instead
+        std::sort(m_Scratch.begin(), m_Scratch.end(), [](const ZoneEvent& a, const ZoneEvent& b) {
+            return a.m_Begin < b.m_Begin;
+        });
+
+        m_Timeline.insert(m_Timeline.end(), m_Scratch.begin(), m_Scratch.end());
+
+        while (m_Timeline.size() > m_MaxEvents) {
+            m_Timeline.pop_front();
+            ++m_NumDiscarded;
+        }
+    }
+
+    std::vector<ZoneEvent> ZoneCollector::getTimeline() const {
+        std::lock_guard<std::mutex> guard(m_Mutex);
+
+        std::vector<ZoneEvent> result(m_Timeline.begin(), m_Timeline.end());
+
+        // successive collections may overlap in time slightly
+        std::stable_sort(result.begin(), result.end(), [](const ZoneEvent& a, const ZoneEvent& b) {
+            return a.m_Begin < b.m_Begin;
+        });
+
+        return result;
+    }
+
+    uint64_t ZoneCollector::getNumDropped() const {
+        std::lock_guard<std::mutex> guard(m_Mutex);
+
+        uint64_t result = m_NumDiscarded;
+
+        for (const auto& buffer : m_Buffers)
+            result += buffer->getNumDropped();
+
+        return result;
+    }
+
+    void ZoneCollector::setMaxEvents(size_t maxEvents) {
+        std::lock_guard<std::mutex> guard(m_Mutex);
+        m_MaxEvents = maxEvents;
+    }
+
+    void ZoneCollector::clear() {
+        std::lock_guard<std::mutex> guard(m_Mutex);
+
+        m_Scratch.clear();
+
+        for (auto& buffer : m_Buffers)
+            buffer->drain(m_Scratch);
+
+        m_Scratch.clear();
+        m_Timeline.clear();
+        m_NumDiscarded = 0;
+    }
+
+    detail::ZoneBuffer* ZoneCollector::getThreadBuffer() {
+        // the collector keeps a reference as well, so whatever was recorded just
+        // before a thread exits is still collected
+        thread_local detail::ZoneBufferOwner t_Owner;
+
+        if (!t_Owner.m_Buffer) {
+            t_Owner.m_Buffer = std::make_shared<detail::ZoneBuffer>(std::this_thread::get_id());
+
+            std::lock_guard<std::mutex> guard(m_Mutex);
+            m_Buffers.push_back(t_Owner.m_Buffer);
+        }
+
+        return t_Owner.m_Buffer.get();
+    }
+}  // namespace djinn::core
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "compile_options.h"
+#include "util/profile_zone_macro.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace djinn::core {
+    // Lightweight scoped timing for hot paths, see DJINN_PROFILE_ZONE in util/profile_zone_macro.h.
+    //
+    // Every thread that records a zone gets its own fixed size ring buffer (single producer,
+    // single consumer), so recording never takes a lock or allocates. The ZoneCollector
+    // periodically drains all of the buffers and merges them into a single timeline.
+    //
+    // [NOTE] zone names are not copied, so they should have static storage duration
+    //        (string literals or __func__)
+    // [NOTE] if a buffer fills up before it is drained, new zones are dropped (and counted)
+    struct ZoneEvent {
+        using Clock     = std::chrono::steady_clock;
+        using TimePoint = Clock::time_point;
+
+        const char*     m_Name;
+        TimePoint       m_Begin;
+        TimePoint       m_End;
+        std::thread::id m_Thread;
+    };
+
+    namespace detail {
+        class ZoneBuffer {
+        public:
+            static constexpr size_t k_Capacity = 1 << 13;  // should be a power of 2
+
+            explicit ZoneBuffer(std::thread::id owner);
+
+            void push(const ZoneEvent& evt);       // [NOTE] owning thread only
+            void drain(std::vector<ZoneEvent>& out);  // [NOTE] collector only
+
+            std::thread::id getOwner() const;
+            uint64_t        getNumDropped() const;
+
+            void markOrphaned();  // [NOTE] owning thread only, when it exits
+            bool isOrphaned() const;
+
+        private:
+            std::array<ZoneEvent, k_Capacity> m_Events;
+
+            alignas(64) std::atomic<uint64_t> m_Head = 0;  // written by the owner
+            alignas(64) std::atomic<uint64_t> m_Tail = 0;  // written by the collector
+            std::atomic<uint64_t> m_NumDropped = 0;
+            std::atomic_bool      m_IsOrphaned = false;
+
+            std::thread::id m_Owner;
+        };
+    }  // namespace detail
+
+    class ZoneCollector {
+    public:
+        static ZoneCollector& instance();
+
+        // runtime toggle, in addition to the compile time DJINN_PROFILING
+        void setEnabled(bool enabled);
+        bool isEnabled() const;
+
+        // moves everything that was recorded so far from the per-thread buffers into the timeline
+        void collect();
+
+        std::vector<ZoneEvent> getTimeline() const;  // sorted by starting time
+        uint64_t               getNumDropped() const;
+
+        void setMaxEvents(size_t maxEvents);  // the oldest events are discarded first
+        void clear();
+
+        void record(const ZoneEvent& evt);  // typically used via ProfileZone
+
+    private:
+        ZoneCollector() = default;
+
+        detail::ZoneBuffer* getThreadBuffer();
+
+        mutable std::mutex                               m_Mutex;
+        std::vector<std::shared_ptr<detail::ZoneBuffer>> m_Buffers;  // buffers outlive their threads until drained
+        std::deque<ZoneEvent>                            m_Timeline;
+        std::vector<ZoneEvent>                           m_Scratch;
+        size_t                                           m_MaxEvents = 1 << 20;
+        uint64_t                                         m_NumDiscarded = 0;  // dropped by buffers that are gone, or trimmed from the timeline
+    };
+
+    // the zone itself lives in util, so util can use DJINN_PROFILE_ZONE as well
+    using ProfileZone = util::ProfileZone;
+}  // namespace djinn::core
+
+#include "profile_zone.inl"
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "profile_zone.h"
+
+namespace djinn::core {
+    namespace detail {
+        inline void ZoneBuffer::push(const ZoneEvent& evt) {
+            auto head = m_Head.load(std::memory_order_relaxed);
+
+            if (head - m_Tail.load(std::memory_order_acquire) >= k_Capacity) {
+                m_NumDropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            m_Events[head & (k_Capacity - 1)] = evt;
+            m_Head.store(head + 1, std::memory_order_release);
+        }
+    }  // namespace detail
+
+    inline bool ZoneCollector::isEnabled() const {
+        return util::detail::g_ZoneRecording.load(std::memory_order_relaxed);
+    }
+
+    inline void ZoneCollector::record(const ZoneEvent& evt) {
+        getThreadBuffer()->push(evt);
+    }
+}  // namespace djinn::core
@@ -0,0 +1,427 @@
+#include "profiler.h"
+#include "logger.h"
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+
+namespace djinn::core {
+    namespace {
+        Profiler::Statistics computeStatistics(std::vector<double>& values) {
+            Profiler::Statistics result;
+
+            if (values.empty())
+                return result;
+
+            std::sort(values.begin(), values.end());
+
+            double total = 0.0;
+            for (auto v : values)
+                total += v;
+
+            // nearest rank, ceil(0.99 * n) - 1
+            size_t p99 = (values.size() * 99 + 99) / 100 - 1;
+
+            result.m_Min        = values.front();
+            result.m_Max        = values.back();
+            result.m_Average    = total / static_cast<double>(values.size());
+            result.m_P99        = values[p99];
+            result.m_NumSamples = values.size();
+
+            return result;
+        }
+
+        double toMilliseconds(Profiler::TimePoint begin, Profiler::TimePoint end) {
+            return std::chrono::duration<double, std::milli>(end - begin).count();
+        }
+    }  // namespace
+
+    namespace {
+        std::atomic<uint64_t> s_NextInstance = 1;
+    }  // namespace
+
+    struct Profiler::SampleBuffer {
+        static constexpr size_t k_Capacity = 1024;  // should be a power of 2
+
+        // [NOTE] owning thread only
+        void push(const Sample& sample) {
+            auto head = m_Head.load(std::memory_order_relaxed);
+
+            if (head - m_Tail.load(std::memory_order_acquire) >= k_Capacity) {
+                m_NumDropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            m_Samples[head & (k_Capacity - 1)] = sample;
+            m_Head.store(head + 1, std::memory_order_release);
+        }
+
+        // [NOTE] with m_Mutex of the profiler locked; discards the samples if there's no output
+        void drain(std::vector<Sample>* out) {
+            auto tail = m_Tail.load(std::memory_order_relaxed);
+            auto head = m_Head.load(std::memory_order_acquire);
+
+            if (out)
+                for (; tail != head; ++tail)
+                    out->push_back(m_Samples[tail & (k_Capacity - 1)]);
+
+            m_Tail.store(head, std::memory_order_release);
+        }
+
+        std::array<Sample, k_Capacity> m_Samples;
+
+        alignas(64) std::atomic<uint64_t> m_Head = 0;  // written by the owner
+        alignas(64) std::atomic<uint64_t> m_Tail = 0;  // written while draining
+        std::atomic<uint64_t> m_NumDropped = 0;
+        std::atomic_bool      m_IsOrphaned = false;  // the owner is done with it
+    };
+
+    // [NOTE] a thread only keeps the state for one profiler at a time (typically there is
+    //        just the one of the engine)
+    struct Profiler::ThreadState {
+        ~ThreadState() { release(); }
+
+        void release() {
+            if (m_Buffer)
+                m_Buffer->m_IsOrphaned = true;
+
+            m_Buffer.reset();
+            m_Names.clear();
+        }
+
+        uint64_t                                  m_Instance = 0;
+        std::shared_ptr<SampleBuffer>             m_Buffer;
+        std::unordered_map<std::string, uint32_t> m_Names;  // cached from the shared table
+    };
+
+    Profiler::Profiler(size_t numFrames):
+        m_Frames(std::max<size_t>(numFrames, 1)),
+        m_Instance(s_NextInstance++),
+        m_Epoch(Clock::now()) {}
+
+    void Profiler::setEnabled(bool enabled) {
+        m_Enabled = enabled;
+
+        ZoneCollector::instance().setEnabled(enabled);
+    }
+
+    bool Profiler::isEnabled() const {
+        return m_Enabled;
+    }
+
+    void Profiler::beginFrame(uint64_t frameIndex) {
+        if (!m_Enabled)
+            return;
+
+        std::lock_guard<std::mutex> guard(m_Mutex);
+
+        auto& frame = m_Frames[m_CurrentFrame];
+
+        frame.m_Index = frameIndex;
+        frame.m_Begin = Clock::now();
+        frame.m_End   = frame.m_Begin;
+        frame.m_Samples.clear();  // keeps the capacity, so this doesn't allocate after warming up
+
+        m_InFrame = true;
+    }
+
+    void Profiler::endFrame() {
+        {
+            std::lock_guard<std::mutex> guard(m_Mutex);
+
+            if (!m_InFrame)
+                return;
+
+            m_Frames[m_CurrentFrame].m_End = Clock::now();
+            m_InFrame                      = false;
+
+            drainBuffers(&m_Frames[m_CurrentFrame].m_Samples);
+
+            m_CurrentFrame = (m_CurrentFrame + 1) % m_Frames.size();
+            m_NumFrames    = std::min(m_NumFrames + 1, m_Frames.size());
+        }
+
+        // drain the per-thread zone buffers before they fill up
+        ZoneCollector::instance().collect();
+    }
+
+    void Profiler::record(const std::string& name, ePhase phase, TimePoint begin, TimePoint end) {
+        if (!m_Enabled)
+            return;
+
+        bool isPerFrame = (phase == ePhase::UPDATE) || (phase == ePhase::FIXED_UPDATE);
+
+        if (!isPerFrame) {
+            // init/shutdown only happen once, so these may just as well lock
+            std::lock_guard<std::mutex> guard(m_Mutex);
+
+            m_LifetimeSamples.push_back({internName(name), phase, begin, end, std::this_thread::get_id()});
+            return;
+        }
+
+        auto& state = getThreadState();
+        auto  it    = state.m_Names.find(name);
+
+        if (it == state.m_Names.end()) {
+            std::lock_guard<std::mutex> guard(m_Mutex);
+            it = state.m_Names.emplace(name, internName(name)).first;
+        }
+
+        state.m_Buffer->push({it->second, phase, begin, end, std::this_thread::get_id()});
+    }
+
+    Profiler::Statistics Profiler::getStatistics(const std::string& name, ePhase phase) const {
+        std::lock_guard<std::mutex> guard(m_Mutex);
+
+        auto it = m_NameLookup.find(name);
+        if (it == m_NameLookup.end())
+            return {};
+
+        std::vector<double> values;
+
+        if ((phase == ePhase::INIT) || (phase == ePhase::SHUTDOWN)) {
+            for (const auto& sample : m_LifetimeSamples)
+                if ((sample.m_NameId == it->second) && (sample.m_Phase == phase))
+                    values.push_back(toMilliseconds(sample.m_Begin, sample.m_End));
+        }
+        else {
+            // only consider completed frames
+            for (size_t i = 0; i < m_NumFrames; ++i) {
+                const auto& frame = m_Frames[(m_CurrentFrame + m_Frames.size() - m_NumFrames + i) % m_Frames.size()];
+
+                double total = 0.0;
+                bool   found = false;
+
+                for (const auto& sample : frame.m_Samples) {
+                    if ((sample.m_NameId == it->second) && (sample.m_Phase == phase)) {
+                        total += toMilliseconds(sample.m_Begin, sample.m_End);
+                        found = true;
+                    }
+                }
+
+                if (found)
+                    values.push_back(total);
+            }
+        }
+
+        return computeStatistics(values);
+    }
+
+    Profiler::Statistics Profiler::getFrameStatistics() const {
+        std::lock_guard<std::mutex> guard(m_Mutex);
+
+        std::vector<double> values;
+
+        for (size_t i = 0; i < m_NumFrames; ++i) {
+            const auto& frame = m_Frames[(m_CurrentFrame + m_Frames.size() - m_NumFrames + i) % m_Frames.size()];
+            values.push_back(toMilliseconds(frame.m_Begin, frame.m_End));
+        }
+
+        return computeStatistics(values);
+    }
+
+    std::vector<std::string> Profiler::getNames() const {
+        std::lock_guard<std::mutex> guard(m_Mutex);
+        return m_Names;
+    }
+
+    uint64_t Profiler::getNumDropped() const {
+        std::lock_guard<std::mutex> guard(m_Mutex);
+
+        uint64_t result = m_NumDropped;
+
+        for (const auto& buffer : m_Buffers)
+            result += buffer->m_NumDropped;
+
+        return result;
+    }
+
+    nlohmann::json Profiler::toChromeTrace() const {
+        using namespace std::chrono;
+
+        ZoneCollector::instance().collect();  // include whatever was recorded since the last frame
+
+        std::lock_guard<std::mutex> guard(m_Mutex);
+
+        // chrome wants small integers for thread ids
+        std::unordered_map<std::thread::id, int> threadIds;
+
+        auto tid = [&](std::thread::id id) {
+            auto it = threadIds.find(id);
+            if (it != threadIds.end())
+                return it->second;
+
+            int result    = static_cast<int>(threadIds.size());
+            threadIds[id] = result;
+            return result;
+        };
+
+        auto micros = [this](TimePoint t) {
+            return duration<double, std::micro>(t - m_Epoch).count();
+        };
+
+        nlohmann::json events = nlohmann::json::array();
+
+        auto addSample = [&](const Sample& sample) {
+            std::stringstream category;
+            category << sample.m_Phase;
+
+            events.push_back({{"name", m_Names[sample.m_NameId]},
+                              {"cat", category.str()},
+                              {"ph", "X"},
+                              {"ts", micros(sample.m_Begin)},
+                              {"dur", micros(sample.m_End) - micros(sample.m_Begin)},
+                              {"pid", 0},
+                              {"tid", tid(sample.m_Thread)}});
+        };
+
+        for (const auto& sample : m_LifetimeSamples)
+            addSample(sample);
+
+        for (size_t i = 0; i < m_NumFrames; ++i) {
+            const auto& frame = m_Frames[(m_CurrentFrame + m_Frames.size() - m_NumFrames + i) % m_Frames.size()];
+
+            // frames are shown as their own track
+            events.push_back({{"name", "Frame " + std::to_string(frame.m_Index)},
+                              {"cat", "frame"},
+                              {"ph", "X"},
+                              {"ts", micros(frame.m_Begin)},
+                              {"dur", micros(frame.m_End) - micros(frame.m_Begin)},
+                              {"pid", 1},
+                              {"tid", 0}});
+
+            for (const auto& sample : frame.m_Samples)
+                addSample(sample);
+        }
+
+        for (const auto& zone : ZoneCollector::instance().getTimeline()) {
+            events.push_back({{"name", zone.m_Name},
+                              {"cat", "zone"},
+                              {"ph", "X"},
+                              {"ts", micros(zone.m_Begin)},
+                              {"dur", micros(zone.m_End) - micros(zone.m_Begin)},
+                              {"pid", 0},
+                              {"tid", tid(zone.m_Thread)}});
+        }
+
+        nlohmann::json result;
+
+        result["traceEvents"]     = std::move(events);
+        result["displayTimeUnit"] = "ms";
+
+        return result;
+    }
+
+    void Profiler::exportChromeTrace(const std::filesystem::path& path) const {
+        std::ofstream out(path.string());
+
+        if (!out.good()) {
+            gLogError << "Failed to open " << path.string() << ", discarding profile capture";
+            return;
+        }
+
+        out << toChromeTrace().dump();
+
+        gLog << "Saved profile capture to " << path.string();
+    }
+
+    void Profiler::clear() {
+        ZoneCollector::instance().clear();
+
+        std::lock_guard<std::mutex> guard(m_Mutex);
+
+        drainBuffers(nullptr);
+
+        for (auto& frame : m_Frames)
+            frame.m_Samples.clear();
+
+        m_LifetimeSamples.clear();
+        m_CurrentFrame = 0;
+        m_NumFrames    = 0;
+        m_InFrame      = false;
+    }
+
+    Profiler::ThreadState& Profiler::getThreadState() {
+        thread_local ThreadState t_State;
+
+        if (t_State.m_Instance != m_Instance) {
+            // whatever is left in the buffer of another profiler is still drained by that one
+            t_State.release();
+
+            t_State.m_Instance = m_Instance;
+            t_State.m_Buffer   = std::make_shared<SampleBuffer>();
+
+            std::lock_guard<std::mutex> guard(m_Mutex);
+            m_Buffers.push_back(t_State.m_Buffer);
+        }
+
+        return t_State;
+    }
+
+    void Profiler::drainBuffers(std::vector<Sample>* samples) {
+        for (auto it = m_Buffers.begin(); it != m_Buffers.end();) {
+            // [NOTE] check this *before* draining; the flag is set after the last push of the thread
+            bool isOrphaned = (*it)->m_IsOrphaned;
+
+            (*it)->drain(samples);
+
+            if (isOrphaned) {
+                m_NumDropped += (*it)->m_NumDropped;
+                it = m_Buffers.erase(it);
+            }
+            else
+                ++it;
+        }
+    }
+
+    uint32_t Profiler::internName(const std::string& name) {
+        auto it = m_NameLookup.find(name);
+
+        if (it != m_NameLookup.end())
+            return it->second;
+
+        auto id = static_cast<uint32_t>(m_Names.size());
+
+        m_Names.push_back(name);
+        m_NameLookup[name] = id;
+
+        return id;
+    }
+
+    std::ostream& operator<<(std::ostream& os, const Profiler::ePhase& phase) {
+        switch (phase) {
+        case Profiler::ePhase::INIT: os << "init"; break;
+        case Profiler::ePhase::UPDATE: os << "update"; break;
+        case Profiler::ePhase::FIXED_UPDATE: os << "fixedUpdate"; break;
+        case Profiler::ePhase::SHUTDOWN: os << "shutdown"; break;
+        }
+
+        return os;
+    }
+
+    std::ostream& operator<<(std::ostream& os, const Profiler& profiler) {
+        auto printRow = [&os](const std::string& name, const Profiler::Statistics& stats) {
+            os << "\t" << std::left << std::setw(24) << name << std::right << std::fixed
+               << std::setprecision(3) << " min " << std::setw(8) << stats.m_Min << " avg "
+               << std::setw(8) << stats.m_Average << " p99 " << std::setw(8) << stats.m_P99
+               << " max " << std::setw(8) << stats.m_Max << " (ms, " << stats.m_NumSamples
+               << " frames)\n";
+        };
+
+        os << "[Profiler]:\n";
+
+        printRow("<frame>", profiler.getFrameStatistics());
+
+        for (const auto& name : profiler.getNames()) {
+            auto stats = profiler.getStatistics(name);
+
+            if (stats.m_NumSamples > 0)
+                printRow(name, stats);
+        }
+
+        return os;
+    }
+}  // namespace djinn::core
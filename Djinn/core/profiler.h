@@ -0,0 +1,133 @@
+#pragma once
+
+#include "profile_zone.h"
+#include "third_party.h"
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace djinn::core {
+    // Collects timing samples for the init/update/shutdown of every system (and the application).
+    //
+    // Samples for update phases are kept in a ring buffer of recent frames, which is used
+    // to derive rolling statistics per system. Init and shutdown samples are kept separately,
+    // as they only happen once. Everything can be exported in the chrome trace_event format,
+    // which can be opened in chrome://tracing or https://ui.perfetto.dev
+    //
+    // Zones recorded with DJINN_PROFILE_ZONE are collected at the end of every frame and
+    // included in the trace as well; enabling the profiler also enables the ZoneCollector.
+    //
+    // Samples of the update phases are recorded into a buffer of the calling thread (single
+    // producer, single consumer), so systems that are updated concurrently don't contend on a
+    // lock; the buffers are drained into the frame by endFrame(). Names are looked up through a
+    // cache of the thread as well, the shared name table is only locked for new names.
+    //
+    // [NOTE] record() may be called from any thread; update samples that arrive after
+    //        endFrame() has drained the buffers (including those in between frames) are
+    //        counted towards the next frame
+    // [NOTE] if a thread records more samples in a frame than its buffer can hold, the
+    //        excess is dropped (and counted)
+    // [NOTE] when disabled, measure() just invokes the function
+    class Profiler {
+    public:
+        using Clock     = std::chrono::steady_clock;
+        using TimePoint = Clock::time_point;
+
+        enum class ePhase
+        {
+            INIT,
+            UPDATE,
+            FIXED_UPDATE,
+            SHUTDOWN
+        };
+
+        struct Sample {
+            uint32_t        m_NameId;
+            ePhase          m_Phase;
+            TimePoint       m_Begin;
+            TimePoint       m_End;
+            std::thread::id m_Thread;
+        };
+
+        struct Frame {
+            uint64_t            m_Index = 0;
+            TimePoint           m_Begin;
+            TimePoint           m_End;
+            std::vector<Sample> m_Samples;
+        };
+
+        // in milliseconds, per frame (multiple samples within a frame are summed)
+        struct Statistics {
+            double m_Min        = 0.0;
+            double m_Average    = 0.0;
+            double m_P99        = 0.0;
+            double m_Max        = 0.0;
+            size_t m_NumSamples = 0;
+        };
+
+        explicit Profiler(size_t numFrames = 300);
+
+        void setEnabled(bool enabled);
+        bool isEnabled() const;
+
+        void beginFrame(uint64_t frameIndex);
+        void endFrame();
+
+        void record(const std::string& name, ePhase phase, TimePoint begin, TimePoint end);
+
+        template <typename Fn>
+        void measure(const std::string& name, ePhase phase, Fn&& fn);
+
+        Statistics               getStatistics(const std::string& name, ePhase phase = ePhase::UPDATE) const;
+        Statistics               getFrameStatistics() const;
+        std::vector<std::string> getNames() const;
+
+        uint64_t getNumDropped() const;  // update samples that didn't fit in the buffer of their thread
+
+        nlohmann::json toChromeTrace() const;
+        void           exportChromeTrace(const std::filesystem::path& path) const;
+
+        void clear();
+
+    private:
+        struct SampleBuffer;
+        struct ThreadState;
+
+        uint32_t     internName(const std::string& name);  // [NOTE] expects m_Mutex to be locked
+        ThreadState& getThreadState();                     // of the calling thread, for this profiler
+        void         drainBuffers(std::vector<Sample>* samples);  // [NOTE] expects m_Mutex to be locked
+
+        mutable std::mutex m_Mutex;
+
+        std::atomic_bool m_Enabled = false;
+
+        std::vector<Frame> m_Frames;  // ring buffer
+        size_t             m_CurrentFrame = 0;
+        size_t             m_NumFrames    = 0;  // number of completed frames in the buffer
+        std::atomic_bool   m_InFrame      = false;
+
+        uint64_t                                   m_Instance;  // tells the thread states of different profilers apart
+        std::vector<std::shared_ptr<SampleBuffer>> m_Buffers;   // per thread, outlive their threads until drained
+        uint64_t                                   m_NumDropped = 0;  // by buffers that are gone
+
+        std::vector<Sample> m_LifetimeSamples;  // init/shutdown, outside of the frame ring
+
+        std::vector<std::string>                  m_Names;
+        std::unordered_map<std::string, uint32_t> m_NameLookup;
+
+        TimePoint m_Epoch;  // timestamps in the trace are relative to this
+    };
+
+    std::ostream& operator<<(std::ostream& os, const Profiler::ePhase& phase);
+    std::ostream& operator<<(std::ostream& os, const Profiler& profiler);  // table of statistics per system
+}  // namespace djinn::core
+
+#include "profiler.inl"
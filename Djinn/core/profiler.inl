@@ -0,0 +1,17 @@
+#pragma once
+
+#include "profiler.h"
+
+namespace djinn::core {
+    template <typename Fn>
+    void Profiler::measure(const std::string& name, ePhase phase, Fn&& fn) {
+        if (!isEnabled()) {
+            fn();
+            return;
+        }
+
+        auto begin = Clock::now();
+        fn();
+        record(name, phase, begin, Clock::now());
+    }
+}  // namespace djinn::core
@@ -11,6 +11,8 @@ namespace djinn::core {
 
     void System::update() {}
 
+    void System::fixedUpdate(double) {}
+
     void System::shutdown() {
         gLog << "Shutting down [" << getName() << "]";
     }
@@ -32,10 +34,18 @@ namespace djinn::core {
             gLogWarning << getName() << " ~ ignoring duplicate dependency: " << systemName;
     }
 
+    void System::setThreadAffinity(eThreadAffinity affinity) {
+        m_ThreadAffinity = affinity;
+    }
+
     const System::Settings& System::getSettings() const {
         return m_Settings;
     }
 
+    System::eThreadAffinity System::getThreadAffinity() const {
+        return m_ThreadAffinity;
+    }
+
     bool System::isInitialized() const {
         return (m_Engine != nullptr);
     }
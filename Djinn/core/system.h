@@ -25,12 +25,21 @@ namespace djinn::core {
         };
 
     public:
-        friend class Engine;
+        friend class djinn::Engine;
         friend class Settings;
 
         using Dependencies = std::vector<std::string>;
         using Settings     = std::vector<VariableEntry>;
 
+        // Systems are updated concurrently where their dependencies allow for it;
+        // MAIN restricts a system to the thread that calls Engine::run()
+        // (for example, anything that pumps OS window messages)
+        enum class eThreadAffinity
+        {
+            ANY,
+            MAIN
+        };
+
         System(const std::string& systemName);
         virtual ~System() = default;
 
@@ -41,17 +50,20 @@ namespace djinn::core {
 
         virtual void init();
         virtual void update();
+        virtual void fixedUpdate(double timestep);  // called zero or more times per frame, see Engine
         virtual void shutdown();
 
         const std::string&  getName() const;
         const Dependencies& getDependencies() const;
         const Settings&     getSettings() const;
+        eThreadAffinity     getThreadAffinity() const;
         bool                isInitialized() const;
 
         Engine* getEngine() const;
 
     protected:
         void addDependency(const std::string& systemName);
+        void setThreadAffinity(eThreadAffinity affinity);
 
         template <typename T>
         void registerSetting(const std::string& jsonKey, T* variable);
@@ -59,9 +71,10 @@ namespace djinn::core {
         Engine* m_Engine = nullptr;
 
     private:
-        std::string  m_Name;
-        Dependencies m_Dependencies;
-        Settings     m_Settings;
+        std::string     m_Name;
+        Dependencies    m_Dependencies;
+        Settings        m_Settings;
+        eThreadAffinity m_ThreadAffinity = eThreadAffinity::ANY;
     };
 
     std::ostream& operator<<(std::ostream& os, const System& s);
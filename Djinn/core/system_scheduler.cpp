@@ -0,0 +1,281 @@
+#include "system_scheduler.h"
+#include "mailbox.h"
+#include "system.h"
+#include <cassert>
+
+namespace djinn::core {
+    namespace {
+        // the pool (and the index within it) of the current thread
+        thread_local const SystemScheduler* t_Scheduler   = nullptr;
+        thread_local int                    t_WorkerIndex = -1;
+    }  // namespace
+
+    SystemScheduler::SystemScheduler(unsigned numWorkers) {
+        startWorkers(numWorkers);
+    }
+
+    SystemScheduler::~SystemScheduler() {
+        stopWorkers();
+    }
+
+    void SystemScheduler::build(const DependencyGraph& graph) {
+        Lock lock(m_Mutex);
+
+        m_Nodes.clear();
+        m_Nodes.reserve(graph.size());
+
+        for (DependencyGraph::SystemId id = 0; id < graph.size(); ++id) {
+            const auto& node = graph[id];
+
+            m_Nodes.push_back(Node{node.m_System, {}});
+            m_Nodes.back().m_Dependents.assign(node.m_Dependents.begin(), node.m_Dependents.end());
+            m_Nodes.back().m_NumDependencies = node.m_Dependencies.size();
+        }
+    }
+
+    void SystemScheduler::execute(const Task& task) {
+        Lock lock(m_Mutex);
+
+        if (m_Nodes.empty())
+            return;
+
+        m_CurrentTask = &task;
+        m_Pending     = m_Nodes.size();
+        m_Error       = nullptr;
+
+        for (auto& node : m_Nodes)
+            node.m_Remaining = node.m_NumDependencies;
+
+        for (size_t i = 0; i < m_Nodes.size(); ++i)
+            if (m_Nodes[i].m_NumDependencies == 0)
+                enqueue(i);
+
+        while (m_Pending > 0) {
+            if (!m_MainQueue.empty()) {
+                size_t idx = m_MainQueue.front();
+                m_MainQueue.pop_front();
+                run(idx, lock);
+            }
+            else if (!m_WorkerQueue.empty()) {
+                // help out instead of idling
+                size_t idx = m_WorkerQueue.front();
+                m_WorkerQueue.pop_front();
+                run(idx, lock);
+            }
+            else
+                m_MainSignal.wait(lock);
+        }
+
+        m_CurrentTask = nullptr;
+
+        if (m_Error) {
+            auto error = m_Error;
+            m_Error    = nullptr;
+
+            lock.unlock();
+            std::rethrow_exception(error);
+        }
+    }
+
+    void SystemScheduler::setIdleTask(IdleTask task) {
+        Lock lock(m_Mutex);
+
+        m_IdleSignal.wait(lock, [this] { return m_NumIdleRunning == 0; });
+
+        m_IdleTask        = std::move(task);
+        m_NumIdleRequests = 0;
+    }
+
+    void SystemScheduler::notifyIdleTask() {
+        Lock lock(m_Mutex);
+
+        ++m_NumIdleRequests;
+        wakeWorker();
+    }
+
+    void SystemScheduler::setNumWorkers(unsigned numWorkers) {
+        if (numWorkers == getNumWorkers())
+            return;
+
+        assert(!m_CurrentTask && !m_IdleTask);
+
+        stopWorkers();
+        startWorkers(numWorkers);
+    }
+
+    size_t SystemScheduler::getNumSystems() const {
+        return m_Nodes.size();
+    }
+
+    unsigned SystemScheduler::getNumWorkers() const {
+        return static_cast<unsigned>(m_Workers.size());
+    }
+
+    int SystemScheduler::getCurrentWorkerIndex() const {
+        return (t_Scheduler == this) ? t_WorkerIndex : -1;
+    }
+
+    unsigned SystemScheduler::getDefaultWorkerCount() {
+        unsigned hw = std::thread::hardware_concurrency();
+
+        return (hw > 1) ? (hw - 1) : 0;
+    }
+
+    void SystemScheduler::startWorkers(unsigned numWorkers) {
+        m_Quit = false;
+
+        // create all of them before starting any, a worker may wake up the others
+        for (unsigned i = 0; i < numWorkers; ++i)
+            m_Workers.push_back(std::make_unique<Worker>());
+
+        for (unsigned i = 0; i < numWorkers; ++i)
+            m_Workers[i]->m_Thread = std::thread([this, i] { workerLoop(static_cast<int>(i)); });
+    }
+
+    void SystemScheduler::stopWorkers() {
+        {
+            Lock lock(m_Mutex);
+            m_Quit = true;
+
+            for (auto& worker : m_Workers)
+                worker->m_Signal.notify_one();
+        }
+
+        for (auto& worker : m_Workers)
+            worker->m_Thread.join();
+
+        m_Workers.clear();
+    }
+
+    void SystemScheduler::workerLoop(int workerIndex) {
+        t_Scheduler   = this;
+        t_WorkerIndex = workerIndex;
+
+        auto& worker = *m_Workers[workerIndex];
+
+        // handlers registered from within a system update may belong to this thread,
+        // so deliver their letters as well (and wake up for them)
+        auto& mailbox = Mailbox::current();
+
+        // [NOTE] the worker announces that it is going to sleep before it checks its mailbox for
+        //        the last time, and the letter was queued before the flag is checked here; so
+        //        either the worker sees the letter or this sees the flag. Taking the mutex then
+        //        ensures that the worker is actually waiting before it is notified.
+        mailbox.setWakeup([this, &worker] {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            if (worker.m_IsSleeping) {
+                Lock lock(m_Mutex);
+                worker.m_Signal.notify_one();
+            }
+        });
+
+        Lock lock(m_Mutex);
+
+        while (true) {
+            worker.m_IsSleeping = true;
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            bool hasWork = m_Quit || !m_WorkerQueue.empty() || !mailbox.isEmpty() ||
+                           ((m_NumIdleRequests > 0) && m_IdleTask);
+
+            if (!hasWork) {
+                worker.m_Signal.wait(lock);
+                continue;
+            }
+
+            worker.m_IsSleeping = false;
+
+            if (m_Quit)
+                break;
+
+            if (!mailbox.isEmpty()) {
+                lock.unlock();
+                mailbox.drain();
+                lock.lock();
+                continue;
+            }
+
+            if (!m_WorkerQueue.empty()) {
+                size_t idx = m_WorkerQueue.front();
+                m_WorkerQueue.pop_front();
+
+                run(idx, lock);
+                continue;
+            }
+
+            // [NOTE] setIdleTask() doesn't replace the task while it is running
+            --m_NumIdleRequests;
+            ++m_NumIdleRunning;
+
+            lock.unlock();
+            m_IdleTask();
+            lock.lock();
+
+            if (--m_NumIdleRunning == 0)
+                m_IdleSignal.notify_all();
+        }
+
+        lock.unlock();
+        mailbox.setWakeup(nullptr);
+
+        t_Scheduler   = nullptr;
+        t_WorkerIndex = -1;
+    }
+
+    void SystemScheduler::wakeWorker() {
+        for (auto& worker : m_Workers) {
+            if (worker->m_IsSleeping) {
+                // so the next call picks another one, the worker sets it again before sleeping
+                worker->m_IsSleeping = false;
+                worker->m_Signal.notify_one();
+                return;
+            }
+        }
+    }
+
+    void SystemScheduler::enqueue(size_t nodeIndex) {
+        auto* system = m_Nodes[nodeIndex].m_System;
+
+        if (m_Workers.empty() || (system->getThreadAffinity() == System::eThreadAffinity::MAIN)) {
+            m_MainQueue.push_back(nodeIndex);
+        }
+        else {
+            m_WorkerQueue.push_back(nodeIndex);
+            wakeWorker();
+        }
+
+        m_MainSignal.notify_one();
+    }
+
+    void SystemScheduler::run(size_t nodeIndex, Lock& lock) {
+        const Task* task = m_CurrentTask;
+
+        lock.unlock();
+
+        std::exception_ptr error;
+
+        try {
+            (*task)(m_Nodes[nodeIndex].m_System);
+        }
+        catch (...) {
+            error = std::current_exception();
+        }
+
+        lock.lock();
+
+        if (error && !m_Error)
+            m_Error = error;
+
+        complete(nodeIndex);
+    }
+
+    void SystemScheduler::complete(size_t nodeIndex) {
+        for (auto dependent : m_Nodes[nodeIndex].m_Dependents)
+            if (--m_Nodes[dependent].m_Remaining == 0)
+                enqueue(dependent);
+
+        if (--m_Pending == 0)
+            m_MainSignal.notify_one();
+    }
+}  // namespace djinn::core
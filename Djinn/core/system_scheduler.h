@@ -0,0 +1,107 @@
+#pragma once
+
+#include "dependency_graph.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace djinn::core {
+    // Applies a task (typically System::update or System::init) to a set of systems,
+    // following the dependency graph described by System::getDependencies(). Systems that don't
+    // depend on each other may be processed concurrently on a small pool of worker
+    // threads, so the cost of a frame is the critical path instead of the sum of all systems.
+    //
+    // Systems with MAIN thread affinity are always executed on the thread that calls
+    // execute(); that thread also helps out with the other work while it is waiting.
+    //
+    // [NOTE] build() must be called again whenever the set of systems changes; a graph built
+    //        with 'available' systems will simply not wait for those
+    // [NOTE] if a task throws, the remaining systems are still processed and the
+    //        first exception is rethrown from execute()
+    // [NOTE] workers drain their own mailbox (see Mailbox) while they're idle; a letter only
+    //        wakes up the worker that owns the mailbox
+    //
+    // The pool can be shared with other work (see JobSystem) through an idle task; idle workers
+    // invoke it once for every notifyIdleTask(), so it should execute (at most) a single unit
+    // of work. Systems take precedence over the idle task.
+    class SystemScheduler {
+    public:
+        using Task     = std::function<void(System*)>;
+        using IdleTask = std::function<void()>;
+
+        explicit SystemScheduler(unsigned numWorkers = getDefaultWorkerCount());
+        ~SystemScheduler();
+
+        SystemScheduler(const SystemScheduler&) = delete;
+        SystemScheduler& operator=(const SystemScheduler&) = delete;
+        SystemScheduler(SystemScheduler&&)                 = delete;
+        SystemScheduler& operator=(SystemScheduler&&) = delete;
+
+        void build(const DependencyGraph& graph);
+        void execute(const Task& task);  // blocks until the task was applied to all systems
+
+        void setIdleTask(IdleTask task);  // waits until no worker is executing the previous one
+        void notifyIdleTask();            // one more unit of work is available
+
+        // restarts the pool with a different number of workers (if it is different)
+        // [NOTE] not while execute() is running or while an idle task is set
+        void setNumWorkers(unsigned numWorkers);
+
+        size_t   getNumSystems() const;
+        unsigned getNumWorkers() const;
+        int      getCurrentWorkerIndex() const;  // -1 if the calling thread is not a worker of this pool
+
+        static unsigned getDefaultWorkerCount();  // hardware concurrency minus the main thread
+
+    private:
+        using Mutex = std::mutex;
+        using Lock  = std::unique_lock<Mutex>;
+
+        struct Node {
+            System*             m_System;
+            std::vector<size_t> m_Dependents;           // indices of the nodes waiting for this one
+            size_t              m_NumDependencies = 0;  // number of nodes this one is waiting for
+            size_t              m_Remaining       = 0;  // per-execute countdown
+        };
+
+        // every worker sleeps on its own signal, so it can be woken up individually
+        struct Worker {
+            std::thread             m_Thread;
+            std::condition_variable m_Signal;
+            std::atomic_bool        m_IsSleeping = false;  // set before the last check for work, see workerLoop
+        };
+
+        void startWorkers(unsigned numWorkers);
+        void stopWorkers();
+        void workerLoop(int workerIndex);
+        void wakeWorker();                            // [NOTE] expects m_Mutex to be locked
+        void enqueue(size_t nodeIndex);               // [NOTE] expects m_Mutex to be locked
+        void run(size_t nodeIndex, Lock& lock);       // [NOTE] expects m_Mutex to be locked
+        void complete(size_t nodeIndex);              // [NOTE] expects m_Mutex to be locked
+
+        std::vector<Node>                    m_Nodes;
+        std::vector<std::unique_ptr<Worker>> m_Workers;
+
+        Mutex                   m_Mutex;
+        std::condition_variable m_MainSignal;    // work is available for the main thread, or all work is done
+        std::condition_variable m_IdleSignal;    // no worker is executing the idle task anymore
+        std::deque<size_t>      m_WorkerQueue;
+        std::deque<size_t>      m_MainQueue;
+
+        IdleTask m_IdleTask;
+        size_t   m_NumIdleRequests = 0;
+        size_t   m_NumIdleRunning  = 0;
+
+        const Task*        m_CurrentTask = nullptr;
+        size_t             m_Pending     = 0;
+        std::exception_ptr m_Error;
+        bool               m_Quit = false;
+    };
+}  // namespace djinn::core
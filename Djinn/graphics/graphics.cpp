@@ -1,5 +1,6 @@
 #include "graphics.h"
 #include "core/engine.h"
+#include "core/profile_zone.h"
 #include "extensions.h"
 #include "math/trigonometry.h"
 #include "swapchain.h"
@@ -86,20 +87,54 @@ namespace djinn {
         registerSetting("Height", &m_MainWindowSettings.m_Height);
         registerSetting("Windowed", &m_MainWindowSettings.m_Windowed);
         registerSetting("DisplayDevice", &m_MainWindowSettings.m_DisplayDevice);
+        registerSetting("HeadlessVulkan", &m_HeadlessVulkan);
+
+        // window messages need to be pumped by the thread that created the window
+        setThreadAffinity(eThreadAffinity::MAIN);
     }
 
     void Graphics::init() {
+        DJINN_PROFILE_ZONE("Graphics::init");
+
         System::init();
 
-        initVulkan();
+        const bool headless = m_Engine->isHeadless();
+
+        if (headless && !m_HeadlessVulkan) {
+            gLog << "Running headless, Vulkan is disabled";
+            return;
+        }
+
+        {
+            DJINN_PROFILE_ZONE("Graphics::initVulkan");
+            initVulkan();
+        }
+
+        if (headless) {
+            // offscreen only; no window, surface, swapchain or framebuffers
+            initLogicalDevice();
+            initUniformBuffer();
+            initPipelineLayouts();
+            initRenderPass();
+
+            return;
+        }
+
+        {
+            DJINN_PROFILE_ZONE("Graphics::createWindow");
+
+            createWindow(
+                m_MainWindowSettings.m_Width,
+                m_MainWindowSettings.m_Height,
+                m_MainWindowSettings.m_Windowed,
+                m_MainWindowSettings.m_DisplayDevice);
+        }
 
-        createWindow(
-            m_MainWindowSettings.m_Width,
-            m_MainWindowSettings.m_Height,
-            m_MainWindowSettings.m_Windowed,
-            m_MainWindowSettings.m_DisplayDevice);
+        {
+            DJINN_PROFILE_ZONE("Graphics::initLogicalDevice");
+            initLogicalDevice();  // depends on having an output surface
+        }
 
-        initLogicalDevice();  // depends on having an output surface
         initUniformBuffer();
         initPipelineLayouts();
         initRenderPass();
@@ -228,9 +263,12 @@ namespace djinn {
             // [NOTE] possibly the debug report should be optional
 
             std::vector<const char*> requiredLayers     = {};
-            std::vector<const char*> requiredExtensions = {VK_KHR_SURFACE_EXTENSION_NAME,
-                                                           VK_KHR_WIN32_SURFACE_EXTENSION_NAME,
-                                                           VK_EXT_DEBUG_REPORT_EXTENSION_NAME};
+            std::vector<const char*> requiredExtensions = {VK_EXT_DEBUG_REPORT_EXTENSION_NAME};
+
+            if (!m_Engine->isHeadless()) {
+                requiredExtensions.push_back(VK_KHR_SURFACE_EXTENSION_NAME);
+                requiredExtensions.push_back(VK_KHR_WIN32_SURFACE_EXTENSION_NAME);
+            }
 
             checkInstanceLayers(requiredLayers, availableLayers);
             checkInstanceExtensions(requiredExtensions, availableExtensions);
@@ -313,6 +351,8 @@ namespace djinn {
     void Graphics::initLogicalDevice() {
         // setup a draw queue, init logical device
         // [TODO] add compute, transfer queues etc
+        const bool headless = m_Engine->isHeadless();
+
         {
             auto queueFamilyProps = m_PhysicalDevice.getQueueFamilyProperties();
             if (queueFamilyProps.empty())
@@ -328,9 +368,10 @@ namespace djinn {
             };
 
             // try to find a graphics queue family that also supports presenting
+            // (when headless there is nothing to present to)
             for (uint32_t i = 0; i < queueFamilyProps.size(); ++i) {
                 if (hasFlags(queueFamilyProps[i], vk::QueueFlagBits::eGraphics)
-                    && supportsPresent(i, getMainWindow()->getSurface())) {
+                    && (headless || supportsPresent(i, getMainWindow()->getSurface()))) {
                     m_GraphicsFamilyIdx = i;
                     m_PresentFamilyIdx  = i;
                     break;
@@ -348,6 +389,9 @@ namespace djinn {
             std::vector<const char*>               deviceExtensions = {VK_KHR_SWAPCHAIN_EXTENSION_NAME};
             std::vector<const char*>               deviceLayers     = {};
 
+            if (headless)
+                deviceExtensions.clear();
+
             queueInfos.emplace_back();
             queueInfos.back()
                 .setQueueCount(1)
@@ -385,7 +429,9 @@ namespace djinn {
 
         // try and select an appropriate format, colorspace
         // [NOTE] again, we're using the primary window surface here; prefer BGRA32
-        {
+        if (headless)
+            m_SurfaceFormat = {vk::Format::eB8G8R8A8Unorm, vk::ColorSpaceKHR::eSrgbNonlinear};
+        else {
             auto allFormats = m_PhysicalDevice.getSurfaceFormatsKHR(getMainWindow()->getSurface());
 
             if (allFormats.empty())
@@ -421,7 +467,8 @@ namespace djinn {
             else
                 m_PresentQueue = m_Device->getQueue(m_PresentFamilyIdx, 0);
 
-            getMainWindow()->initSwapchain();
+            if (!headless)
+                getMainWindow()->initSwapchain();
 
             m_CommandBuffer->end();
         }
@@ -431,8 +478,13 @@ namespace djinn {
         // setup common camera matrices
         {
             float fov = glm::radians(45.0f);
-            float w   = static_cast<float>(getMainWindow()->getWidth());
-            float h   = static_cast<float>(getMainWindow()->getHeight());
+            float w   = static_cast<float>(m_MainWindowSettings.m_Width);
+            float h   = static_cast<float>(m_MainWindowSettings.m_Height);
+
+            if (!m_Windows.empty()) {
+                w = static_cast<float>(getMainWindow()->getWidth());
+                h = static_cast<float>(getMainWindow()->getHeight());
+            }
 
             if (w > h)
                 fov *= h / w;
@@ -541,7 +593,9 @@ namespace djinn {
             .setStencilLoadOp(vk::AttachmentLoadOp::eDontCare)
             .setStencilStoreOp(vk::AttachmentStoreOp::eDontCare)
             .setInitialLayout(vk::ImageLayout::eUndefined)
-            .setFinalLayout(vk::ImageLayout::ePresentSrcKHR);
+            .setFinalLayout(
+                m_Engine->isHeadless() ? vk::ImageLayout::eTransferSrcOptimal  // read back instead of presenting
+                                       : vk::ImageLayout::ePresentSrcKHR);
 
         attachments[1]
             .setFormat(m_DepthFormat)
@@ -16,6 +16,11 @@
     - win32 presentation support
     [TODO] multi-GPU support... don't have the hardware for that tho
 	[TODO] multi-window support... the render pipeline is just one window for now
+
+    When the engine is headless no window or swapchain is created, and getMainWindow() may
+    not be used. Vulkan is skipped entirely unless 'HeadlessVulkan' is set, in which case an
+    offscreen device is created (for instance on a software implementation such as lavapipe,
+    which can be selected with the VK_ICD_FILENAMES environment variable).
 */
 
 namespace djinn {
@@ -64,9 +69,11 @@ namespace djinn {
             bool m_Windowed      = true;  // only supporting borderless fullscreen windows right now
         } m_MainWindowSettings;
 
+        bool m_HeadlessVulkan = false;  // only used when the engine is headless
+
         // vulkan-related items, mostly based on the official API samples
         void initVulkan();
-        void initLogicalDevice();  // [NOTE] depends on the existance of a window surface
+        void initLogicalDevice();  // [NOTE] depends on the existance of a window surface (unless headless)
         void initUniformBuffer();
         void initPipelineLayouts();
         void initRenderPass();
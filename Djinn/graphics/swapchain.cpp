@@ -10,7 +10,8 @@ namespace djinn::graphics {
         vk::Format         imageFormat,
         vk::Format         depthFormat,
         uint32_t           presentFamilyIdx,
-        Swapchain*         oldSwapchain):
+        Swapchain*         oldSwapchain,
+        bool               vsync):
         m_ImageFormat(imageFormat),
         m_DepthFormat(depthFormat) {
         vk::SwapchainCreateInfoKHR info;
@@ -32,12 +33,15 @@ namespace djinn::graphics {
         else
             throw std::runtime_error("No composite alpha is supported");
 
-        auto preferredPresentMode = *util::prefer(
-            physical.getSurfacePresentModesKHR(surface),
-            vk::PresentModeKHR::eMailbox,
-            vk::PresentModeKHR::eImmediate,
-            vk::PresentModeKHR::eFifoRelaxed,
-            vk::PresentModeKHR::eFifo);
+        // FIFO is the only mode that is guaranteed to be available
+        auto preferredPresentMode = vsync
+            ? vk::PresentModeKHR::eFifo
+            : *util::prefer(
+                physical.getSurfacePresentModesKHR(surface),
+                vk::PresentModeKHR::eMailbox,
+                vk::PresentModeKHR::eImmediate,
+                vk::PresentModeKHR::eFifoRelaxed,
+                vk::PresentModeKHR::eFifo);
 
         info.setSurface(surface)
             .setMinImageCount(std::max(caps.minImageCount, 2u))
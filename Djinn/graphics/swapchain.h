@@ -13,7 +13,8 @@ namespace djinn::graphics {
             vk::Format         imageFormat,
             vk::Format         depthFormat,
             uint32_t           presentFamilyIdx,
-            Swapchain*         oldSwapchain = nullptr);
+            Swapchain*         oldSwapchain = nullptr,
+            bool               vsync        = false);  // FIFO presentation, blocks on the vertical blank
 
         vk::SwapchainKHR getHandle() const;
         vk::Extent2D     getExtent() const noexcept;
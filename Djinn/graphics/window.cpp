@@ -6,6 +6,8 @@
 #include "input/mouse.h"
 #include "swapchain.h"
 
+#if DJINN_PLATFORM == DJINN_PLATFORM_WINDOWS
+
 namespace {
     static std::unordered_map<WPARAM, djinn::input::Keyboard::eKey> g_KeyMapping;
 
@@ -470,7 +472,9 @@ namespace djinn::graphics {
             *m_Surface,
             m_Owner->getSurfaceFormat().format,
             m_Owner->getDepthFormat(),
-            m_Owner->getPresentFamilyIdx());
+            m_Owner->getPresentFamilyIdx(),
+            nullptr,
+            m_Owner->getEngine()->getFramePacer().getMode() == core::FramePacer::eMode::VSYNC);
     }
 
     vk::SurfaceKHR Window::getSurface() const {
@@ -513,3 +517,5 @@ namespace djinn::graphics {
         return mode;
     }
 }  // namespace djinn::graphics
+
+#endif
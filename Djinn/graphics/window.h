@@ -13,6 +13,8 @@
     [NOTE] maybe switch to the raw input model instead of window message translation?
 */
 
+#if DJINN_PLATFORM == DJINN_PLATFORM_WINDOWS
+
 namespace djinn {
     class Graphics;
 
@@ -84,3 +86,5 @@ namespace djinn {
         };
     }  // namespace graphics
 }  // namespace djinn
+
+#endif
@@ -0,0 +1,144 @@
+#include "input_record.h"
+
+namespace djinn::input::record {
+    void append(std::vector<uint8_t>& buffer, const FileHeader& header) {
+        append(buffer, header.m_Magic);
+        append(buffer, header.m_Version);
+    }
+
+    void append(std::vector<uint8_t>& buffer, const RecordHeader& header) {
+        append(buffer, header.m_Frame);
+        append(buffer, header.m_Timestamp);
+        append(buffer, header.m_Type);
+        append(buffer, header.m_Size);
+    }
+
+    bool extract(const uint8_t*& cursor, const uint8_t* end, FileHeader& header) {
+        return extract(cursor, end, header.m_Magic) &&
+               extract(cursor, end, header.m_Version);
+    }
+
+    bool extract(const uint8_t*& cursor, const uint8_t* end, RecordHeader& header) {
+        return extract(cursor, end, header.m_Frame) &&
+               extract(cursor, end, header.m_Timestamp) &&
+               extract(cursor, end, header.m_Type) &&
+               extract(cursor, end, header.m_Size);
+    }
+
+    // ----- keyboard -----
+    void EventTraits<Keyboard::OnKeyPressed>::write(
+        std::vector<uint8_t>&         buffer,
+        const Keyboard::OnKeyPressed& evt) {
+        append(buffer, evt.key);
+    }
+
+    bool EventTraits<Keyboard::OnKeyPressed>::read(
+        const uint8_t*          cursor,
+        const uint8_t*          end,
+        Keyboard::OnKeyPressed& evt) {
+        return extract(cursor, end, evt.key);
+    }
+
+    void EventTraits<Keyboard::OnKeyReleased>::write(
+        std::vector<uint8_t>&          buffer,
+        const Keyboard::OnKeyReleased& evt) {
+        append(buffer, evt.key);
+    }
+
+    bool EventTraits<Keyboard::OnKeyReleased>::read(
+        const uint8_t*           cursor,
+        const uint8_t*           end,
+        Keyboard::OnKeyReleased& evt) {
+        return extract(cursor, end, evt.key);
+    }
+
+    // ----- mouse -----
+    void EventTraits<Mouse::OnMoved>::write(
+        std::vector<uint8_t>& buffer,
+        const Mouse::OnMoved& evt) {
+        append(buffer, evt.m_X);
+        append(buffer, evt.m_Y);
+        append(buffer, evt.m_DeltaX);
+        append(buffer, evt.m_DeltaY);
+    }
+
+    bool EventTraits<Mouse::OnMoved>::read(
+        const uint8_t*  cursor,
+        const uint8_t*  end,
+        Mouse::OnMoved& evt) {
+        return extract(cursor, end, evt.m_X) &&
+               extract(cursor, end, evt.m_Y) &&
+               extract(cursor, end, evt.m_DeltaX) &&
+               extract(cursor, end, evt.m_DeltaY);
+    }
+
+    void EventTraits<Mouse::OnButtonPressed>::write(
+        std::vector<uint8_t>&         buffer,
+        const Mouse::OnButtonPressed& evt) {
+        append(buffer, evt.m_X);
+        append(buffer, evt.m_Y);
+        append(buffer, evt.m_Button);
+    }
+
+    bool EventTraits<Mouse::OnButtonPressed>::read(
+        const uint8_t*          cursor,
+        const uint8_t*          end,
+        Mouse::OnButtonPressed& evt) {
+        return extract(cursor, end, evt.m_X) &&
+               extract(cursor, end, evt.m_Y) &&
+               extract(cursor, end, evt.m_Button);
+    }
+
+    void EventTraits<Mouse::OnButtonReleased>::write(
+        std::vector<uint8_t>&          buffer,
+        const Mouse::OnButtonReleased& evt) {
+        append(buffer, evt.m_X);
+        append(buffer, evt.m_Y);
+        append(buffer, evt.m_Button);
+    }
+
+    bool EventTraits<Mouse::OnButtonReleased>::read(
+        const uint8_t*           cursor,
+        const uint8_t*           end,
+        Mouse::OnButtonReleased& evt) {
+        return extract(cursor, end, evt.m_X) &&
+               extract(cursor, end, evt.m_Y) &&
+               extract(cursor, end, evt.m_Button);
+    }
+
+    void EventTraits<Mouse::OnDoubleClick>::write(
+        std::vector<uint8_t>&       buffer,
+        const Mouse::OnDoubleClick& evt) {
+        append(buffer, evt.m_X);
+        append(buffer, evt.m_Y);
+        append(buffer, evt.m_Button);
+    }
+
+    bool EventTraits<Mouse::OnDoubleClick>::read(
+        const uint8_t*        cursor,
+        const uint8_t*        end,
+        Mouse::OnDoubleClick& evt) {
+        return extract(cursor, end, evt.m_X) &&
+               extract(cursor, end, evt.m_Y) &&
+               extract(cursor, end, evt.m_Button);
+    }
+
+    void EventTraits<Mouse::OnScroll>::write(
+        std::vector<uint8_t>&  buffer,
+        const Mouse::OnScroll& evt) {
+        append(buffer, static_cast<int32_t>(evt.m_ScrollAmount));
+    }
+
+    bool EventTraits<Mouse::OnScroll>::read(
+        const uint8_t*   cursor,
+        const uint8_t*   end,
+        Mouse::OnScroll& evt) {
+        int32_t amount = 0;
+
+        if (!extract(cursor, end, amount))
+            return false;
+
+        evt.m_ScrollAmount = amount;
+        return true;
+    }
+}  // namespace djinn::input::record
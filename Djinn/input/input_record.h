@@ -0,0 +1,125 @@
+#pragma once
+
+#include "keyboard.h"
+#include "mouse.h"
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace djinn::input {
+    // Binary format shared by the InputRecorder and the InputReplayer
+    //
+    // file:   FileHeader, followed by any number of records
+    // record: RecordHeader, followed by m_Size bytes of payload
+    //
+    // Everything is stored in native byte order without padding. Device and window pointers
+    // are not stored; on replay the events refer to the first registered device (if any).
+    namespace record {
+        enum class eEventType: uint16_t
+        {
+            KEY_PRESSED = 1,
+            KEY_RELEASED,
+            MOUSE_MOVED,
+            MOUSE_BUTTON_PRESSED,
+            MOUSE_BUTTON_RELEASED,
+            MOUSE_DOUBLE_CLICK,
+            MOUSE_SCROLL
+        };
+
+        constexpr char     k_Magic[4] = {'D', 'J', 'I', 'R'};
+        constexpr uint32_t k_Version  = 1;
+
+        struct FileHeader {
+            char     m_Magic[4];
+            uint32_t m_Version;
+        };
+
+        struct RecordHeader {
+            uint64_t   m_Frame;      // relative to the first recorded frame
+            uint64_t   m_Timestamp;  // in nanoseconds, relative to the start of the recording
+            eEventType m_Type;
+            uint16_t   m_Size;  // of the payload
+        };
+
+        constexpr size_t k_FileHeaderSize   = sizeof(char[4]) + sizeof(uint32_t);
+        constexpr size_t k_RecordHeaderSize = 2 * sizeof(uint64_t) + 2 * sizeof(uint16_t);
+
+        // appends a trivially copyable value to a byte buffer
+        template <typename T>
+        void append(std::vector<uint8_t>& buffer, const T& value);
+
+        // reads a trivially copyable value; yields false if there are not enough bytes left
+        template <typename T>
+        bool extract(const uint8_t*& cursor, const uint8_t* end, T& value);
+
+        void append(std::vector<uint8_t>& buffer, const FileHeader& header);
+        void append(std::vector<uint8_t>& buffer, const RecordHeader& header);
+
+        bool extract(const uint8_t*& cursor, const uint8_t* end, FileHeader& header);
+        bool extract(const uint8_t*& cursor, const uint8_t* end, RecordHeader& header);
+
+        // Per event type: the type id and how the payload is (de)serialized
+        template <typename T>
+        struct EventTraits;
+
+        template <>
+        struct EventTraits<Keyboard::OnKeyPressed> {
+            static constexpr eEventType k_Type = eEventType::KEY_PRESSED;
+
+            static void write(std::vector<uint8_t>& buffer, const Keyboard::OnKeyPressed& evt);
+            static bool read(const uint8_t* cursor, const uint8_t* end, Keyboard::OnKeyPressed& evt);
+        };
+
+        template <>
+        struct EventTraits<Keyboard::OnKeyReleased> {
+            static constexpr eEventType k_Type = eEventType::KEY_RELEASED;
+
+            static void write(std::vector<uint8_t>& buffer, const Keyboard::OnKeyReleased& evt);
+            static bool read(const uint8_t* cursor, const uint8_t* end, Keyboard::OnKeyReleased& evt);
+        };
+
+        template <>
+        struct EventTraits<Mouse::OnMoved> {
+            static constexpr eEventType k_Type = eEventType::MOUSE_MOVED;
+
+            static void write(std::vector<uint8_t>& buffer, const Mouse::OnMoved& evt);
+            static bool read(const uint8_t* cursor, const uint8_t* end, Mouse::OnMoved& evt);
+        };
+
+        template <>
+        struct EventTraits<Mouse::OnButtonPressed> {
+            static constexpr eEventType k_Type = eEventType::MOUSE_BUTTON_PRESSED;
+
+            static void write(std::vector<uint8_t>& buffer, const Mouse::OnButtonPressed& evt);
+            static bool read(const uint8_t* cursor, const uint8_t* end, Mouse::OnButtonPressed& evt);
+        };
+
+        template <>
+        struct EventTraits<Mouse::OnButtonReleased> {
+            static constexpr eEventType k_Type = eEventType::MOUSE_BUTTON_RELEASED;
+
+            static void write(std::vector<uint8_t>& buffer, const Mouse::OnButtonReleased& evt);
+            static bool read(const uint8_t* cursor, const uint8_t* end, Mouse::OnButtonReleased& evt);
+        };
+
+        template <>
+        struct EventTraits<Mouse::OnDoubleClick> {
+            static constexpr eEventType k_Type = eEventType::MOUSE_DOUBLE_CLICK;
+
+            static void write(std::vector<uint8_t>& buffer, const Mouse::OnDoubleClick& evt);
+            static bool read(const uint8_t* cursor, const uint8_t* end, Mouse::OnDoubleClick& evt);
+        };
+
+        template <>
+        struct EventTraits<Mouse::OnScroll> {
+            static constexpr eEventType k_Type = eEventType::MOUSE_SCROLL;
+
+            static void write(std::vector<uint8_t>& buffer, const Mouse::OnScroll& evt);
+            static bool read(const uint8_t* cursor, const uint8_t* end, Mouse::OnScroll& evt);
+        };
+    }  // namespace record
+}  // namespace djinn::input
+
+#include "input_record.inl"
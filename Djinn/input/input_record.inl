@@ -0,0 +1,27 @@
+#pragma once
+
+#include "input_record.h"
+
+namespace djinn::input::record {
+    template <typename T>
+    void append(std::vector<uint8_t>& buffer, const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        size_t offset = buffer.size();
+        buffer.resize(offset + sizeof(T));
+        std::memcpy(buffer.data() + offset, &value, sizeof(T));
+    }
+
+    template <typename T>
+    bool extract(const uint8_t*& cursor, const uint8_t* end, T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        if (static_cast<size_t>(end - cursor) < sizeof(T))
+            return false;
+
+        std::memcpy(&value, cursor, sizeof(T));
+        cursor += sizeof(T);
+
+        return true;
+    }
+}  // namespace djinn::input::record
@@ -0,0 +1,90 @@
+#include "input_recorder.h"
+#include "core/mediator.h"
+
+namespace djinn {
+    namespace {
+        // applies fn to a (null) pointer of every recorded event type
+        template <typename Fn>
+        void forEachEventType(Fn&& fn) {
+            fn(static_cast<input::Keyboard::OnKeyPressed*>(nullptr));
+            fn(static_cast<input::Keyboard::OnKeyReleased*>(nullptr));
+            fn(static_cast<input::Mouse::OnMoved*>(nullptr));
+            fn(static_cast<input::Mouse::OnButtonPressed*>(nullptr));
+            fn(static_cast<input::Mouse::OnButtonReleased*>(nullptr));
+            fn(static_cast<input::Mouse::OnDoubleClick*>(nullptr));
+            fn(static_cast<input::Mouse::OnScroll*>(nullptr));
+        }
+    }  // namespace
+
+    InputRecorder::InputRecorder(): System("InputRecorder") {
+        registerSetting("Output", &m_Output);
+    }
+
+    void InputRecorder::init() {
+        System::init();
+
+        m_File.open(m_Output, std::ios::binary | std::ios::trunc);
+
+        if (!m_File.good()) {
+            gLogError << "Failed to open " << m_Output << ", input will not be recorded";
+            return;
+        }
+
+        m_Start      = Clock::now();
+        m_FirstFrame = m_Engine->getFrameIndex();
+
+        {
+            std::lock_guard<std::mutex> guard(m_Mutex);
+
+            input::record::FileHeader header;
+            std::copy(std::begin(input::record::k_Magic), std::end(input::record::k_Magic), header.m_Magic);
+            header.m_Version = input::record::k_Version;
+
+            input::record::append(m_Buffer, header);
+        }
+
+        forEachEventType([this](auto* type) {
+            using T = std::remove_pointer_t<decltype(type)>;
+            add_handler<T>(this);
+        });
+
+        gLog << "Recording input to " << m_Output;
+    }
+
+    void InputRecorder::update() {
+        flush();
+    }
+
+    void InputRecorder::shutdown() {
+        if (m_File.is_open()) {
+            forEachEventType([this](auto* type) {
+                using T = std::remove_pointer_t<decltype(type)>;
+                remove_handler<T>(this);
+            });
+
+            flush();
+            m_File.close();
+
+            gLog << "Recorded " << getNumRecorded() << " input events";
+        }
+
+        System::shutdown();
+    }
+
+    size_t InputRecorder::getNumRecorded() const {
+        std::lock_guard<std::mutex> guard(m_Mutex);
+        return m_NumRecorded;
+    }
+
+    void InputRecorder::flush() {
+        std::lock_guard<std::mutex> guard(m_Mutex);
+
+        if (m_Buffer.empty() || !m_File.is_open())
+            return;
+
+        m_File.write(reinterpret_cast<const char*>(m_Buffer.data()), static_cast<std::streamsize>(m_Buffer.size()));
+        m_File.flush();
+
+        m_Buffer.clear();
+    }
+}  // namespace djinn
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "core/system.h"
+#include "input_record.h"
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace djinn {
+    // Records keyboard and mouse events (with the frame in which they were delivered and a
+    // timestamp) into a compact binary file, see input_record.h for the format. The resulting
+    // file can be fed back through the mediator with the InputReplayer, for instance to get
+    // reproducible frame timings in headless mode.
+    //
+    // Recording starts when the system is initialized and ends at shutdown; the output file
+    // is set with 'Output' in the config file.
+    //
+    // [NOTE] window enter/leave events are not recorded, they only make sense with a live window
+    class InputRecorder: public core::System {
+    public:
+        using Keyboard = input::Keyboard;
+        using Mouse    = input::Mouse;
+
+        InputRecorder();
+
+        void init() override;
+        void update() override;  // writes the events of the previous frame to disk
+        void shutdown() override;
+
+        template <typename T>
+        void operator()(absl::Span<const T> events);  // message handler
+
+        size_t getNumRecorded() const;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        void flush();
+
+        std::string m_Output = "djinn_input.rec";
+
+        std::ofstream     m_File;
+        Clock::time_point m_Start;
+        uint64_t          m_FirstFrame = 0;
+
+        mutable std::mutex   m_Mutex;  // events may be delivered on any thread
+        std::vector<uint8_t> m_Buffer;   // records that haven't been written yet
+        std::vector<uint8_t> m_Payload;  // scratch space for a single event
+        size_t               m_NumRecorded = 0;
+    };
+}  // namespace djinn
+
+#include "input_recorder.inl"
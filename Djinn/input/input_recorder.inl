@@ -0,0 +1,31 @@
+#pragma once
+
+#include "core/engine.h"
+#include "input_recorder.h"
+
+namespace djinn {
+    template <typename T>
+    void InputRecorder::operator()(absl::Span<const T> events) {
+        using namespace std::chrono;
+        using Traits = input::record::EventTraits<T>;
+
+        input::record::RecordHeader header;
+        header.m_Frame     = m_Engine->getFrameIndex() - m_FirstFrame;
+        header.m_Timestamp = duration_cast<nanoseconds>(Clock::now() - m_Start).count();
+        header.m_Type      = Traits::k_Type;
+
+        std::lock_guard<std::mutex> guard(m_Mutex);
+
+        for (const auto& evt : events) {
+            m_Payload.clear();
+            Traits::write(m_Payload, evt);
+
+            header.m_Size = static_cast<uint16_t>(m_Payload.size());
+
+            input::record::append(m_Buffer, header);
+            m_Buffer.insert(m_Buffer.end(), m_Payload.begin(), m_Payload.end());
+        }
+
+        m_NumRecorded += events.size();
+    }
+}  // namespace djinn
@@ -0,0 +1,201 @@
+#include "input_replayer.h"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace djinn {
+    InputReplayer::InputReplayer(): System("InputReplayer") {
+        registerSetting("Input", &m_Input);
+        registerSetting("StopWhenDone", &m_StopWhenDone);
+
+        // the recorded events were delivered on the main thread as well
+        setThreadAffinity(eThreadAffinity::MAIN);
+    }
+
+    void InputReplayer::init() {
+        using namespace input::record;
+
+        System::init();
+
+        std::ifstream file(m_Input, std::ios::binary);
+
+        if (!file.good()) {
+            gLogError << "Failed to open " << m_Input << ", no input will be replayed";
+            return;
+        }
+
+        m_Recording.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+        const uint8_t* cursor = m_Recording.data();
+        const uint8_t* end    = cursor + m_Recording.size();
+
+        FileHeader header;
+
+        if (!extract(cursor, end, header) || (std::memcmp(header.m_Magic, k_Magic, sizeof(k_Magic)) != 0)) {
+            gLogError << m_Input << " is not an input recording";
+            m_Recording.clear();
+            return;
+        }
+
+        if (header.m_Version != k_Version) {
+            gLogError << m_Input << " has an unsupported version (" << header.m_Version << ")";
+            m_Recording.clear();
+            return;
+        }
+
+        m_Cursor = k_FileHeaderSize;
+
+        gLog << "Replaying input from " << m_Input;
+    }
+
+    void InputReplayer::update() {
+        if (m_Recording.empty() || m_Finished)
+            return;
+
+        if (!m_Started) {
+            m_FirstFrame = m_Engine->getFrameIndex();
+            m_Started    = true;
+        }
+
+        // stop one frame after the last events, so they've been processed
+        if (isDone()) {
+            gLog << "Replayed " << m_NumReplayed << " input events";
+
+            m_Finished = true;
+
+            if (m_StopWhenDone)
+                m_Engine->stop();
+
+            return;
+        }
+
+        uint64_t frame = m_Engine->getFrameIndex() - m_FirstFrame;
+
+        while (replayNext(frame, false))
+            ;
+
+        flushPending();
+
+        // [NOTE] the engine dispatches posted messages at the start of a frame, before any update;
+        //        posted events that were recorded before anything else in the next frame were
+        //        delivered by that dispatch, so they're queued now
+        while (replayNext(frame + 1, true))
+            ;
+
+        m_PendingTypes = 0;
+    }
+
+    bool InputReplayer::isPosted(input::record::eEventType type) {
+        using eEventType = input::record::eEventType;
+
+        switch (type) {
+        case eEventType::KEY_PRESSED: return k_IsPosted<Keyboard::OnKeyPressed>;
+        case eEventType::KEY_RELEASED: return k_IsPosted<Keyboard::OnKeyReleased>;
+        case eEventType::MOUSE_MOVED: return k_IsPosted<Mouse::OnMoved>;
+        case eEventType::MOUSE_BUTTON_PRESSED: return k_IsPosted<Mouse::OnButtonPressed>;
+        case eEventType::MOUSE_BUTTON_RELEASED: return k_IsPosted<Mouse::OnButtonReleased>;
+        case eEventType::MOUSE_DOUBLE_CLICK: return k_IsPosted<Mouse::OnDoubleClick>;
+        case eEventType::MOUSE_SCROLL: return k_IsPosted<Mouse::OnScroll>;
+
+        default: return false;
+        }
+    }
+
+    bool InputReplayer::replayNext(uint64_t frame, bool postedOnly) {
+        using namespace input::record;
+        using eEventType = input::record::eEventType;
+
+        if (isDone())
+            return false;
+
+        const uint8_t* end    = m_Recording.data() + m_Recording.size();
+        const uint8_t* cursor = m_Recording.data() + m_Cursor;
+
+        RecordHeader header;
+
+        if (!extract(cursor, end, header) || (static_cast<size_t>(end - cursor) < header.m_Size)) {
+            gLogWarning << "Truncated input recording, stopping replay";
+            m_Cursor = m_Recording.size();
+            return false;
+        }
+
+        if (header.m_Frame > frame)
+            return false;
+
+        // [NOTE] the dispatch at the start of a frame delivers just one message per posted type;
+        //        a second record of the same type came after it, so it waits for its own frame
+        if (postedOnly) {
+            uint32_t bit = 1u << static_cast<uint16_t>(header.m_Type);
+
+            if (!isPosted(header.m_Type) || (m_PendingTypes & bit))
+                return false;
+        }
+
+        const uint8_t* payloadEnd = cursor + header.m_Size;
+
+        switch (header.m_Type) {
+        case eEventType::KEY_PRESSED: replay<Keyboard::OnKeyPressed>(cursor, payloadEnd); break;
+        case eEventType::KEY_RELEASED: replay<Keyboard::OnKeyReleased>(cursor, payloadEnd); break;
+        case eEventType::MOUSE_MOVED: replay<Mouse::OnMoved>(cursor, payloadEnd); break;
+        case eEventType::MOUSE_BUTTON_PRESSED: replay<Mouse::OnButtonPressed>(cursor, payloadEnd); break;
+        case eEventType::MOUSE_BUTTON_RELEASED: replay<Mouse::OnButtonReleased>(cursor, payloadEnd); break;
+        case eEventType::MOUSE_DOUBLE_CLICK: replay<Mouse::OnDoubleClick>(cursor, payloadEnd); break;
+        case eEventType::MOUSE_SCROLL: replay<Mouse::OnScroll>(cursor, payloadEnd); break;
+
+        default:
+            // possibly recorded by a newer version, just skip it
+            gLogWarning << "Unknown input event type: " << static_cast<uint16_t>(header.m_Type);
+        }
+
+        m_Cursor = static_cast<size_t>(payloadEnd - m_Recording.data());
+
+        return true;
+    }
+
+    void InputReplayer::flushPending() {
+        using eEventType = input::record::eEventType;
+
+        // same order as the Mouse dispatches them
+        if (m_PendingTypes & (1u << static_cast<uint16_t>(eEventType::MOUSE_MOVED)))
+            dispatch<Mouse::OnMoved>();
+
+        if (m_PendingTypes & (1u << static_cast<uint16_t>(eEventType::MOUSE_SCROLL)))
+            dispatch<Mouse::OnScroll>();
+
+        m_PendingTypes = 0;
+    }
+
+    void InputReplayer::shutdown() {
+        flushPending();
+
+        m_Recording.clear();
+        m_Cursor = 0;
+
+        System::shutdown();
+    }
+
+    bool InputReplayer::isDone() const {
+        return m_Cursor >= m_Recording.size();
+    }
+
+    size_t InputReplayer::getNumReplayed() const {
+        return m_NumReplayed;
+    }
+
+    void InputReplayer::attachDevice(Keyboard::OnKeyPressed& evt) const {
+        evt.kbd = nullptr;
+
+        if (auto* inputSystem = m_Engine->get<Input>())
+            if (!inputSystem->getKeyboards().empty())
+                evt.kbd = inputSystem->getKeyboards().front();
+    }
+
+    void InputReplayer::attachDevice(Keyboard::OnKeyReleased& evt) const {
+        evt.kbd = nullptr;
+
+        if (auto* inputSystem = m_Engine->get<Input>())
+            if (!inputSystem->getKeyboards().empty())
+                evt.kbd = inputSystem->getKeyboards().front();
+    }
+}  // namespace djinn
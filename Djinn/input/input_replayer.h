@@ -0,0 +1,75 @@
+#pragma once
+
+#include "core/message_policy.h"
+#include "core/system.h"
+#include "input_record.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace djinn {
+    // Feeds a recording made with the InputRecorder back through the mediator. Events are
+    // delivered in the same (relative) frame as they were recorded in, so a replay in headless
+    // mode yields the same sequence of input every time, regardless of the actual frame times.
+    //
+    // Events that are posted live (the ones with a coalescing MessagePolicy, like mouse movement)
+    // are posted again; each record is delivered as a single message, in the order it was
+    // recorded relative to the broadcasted events. Records from the start of a frame were
+    // delivered by the engine's dispatch, so those are posted one frame early (only the first
+    // one of each type, the others are replayed during the frame itself).
+    //
+    // The recording is set with 'Input' in the config file; with 'StopWhenDone' the engine
+    // is stopped after the last event was replayed.
+    //
+    // [NOTE] replayed events refer to the first registered keyboard/mouse, or nullptr if there
+    //        are none (which is typical when headless)
+    class InputReplayer: public core::System {
+    public:
+        using Keyboard = input::Keyboard;
+        using Mouse    = input::Mouse;
+
+        InputReplayer();
+
+        void init() override;
+        void update() override;
+        void shutdown() override;
+
+        bool   isDone() const;
+        size_t getNumReplayed() const;
+
+    private:
+        template <typename T>
+        static constexpr bool k_IsPosted = (MessagePolicy<T>::k_Coalescing != eCoalescing::KEEP_ALL);
+
+        static bool isPosted(input::record::eEventType type);
+
+        // replays the next record if it was recorded in (or before) the given frame;
+        // yields false when there is nothing (more) to replay for that frame
+        bool replayNext(uint64_t frame, bool postedOnly);
+
+        template <typename T>
+        void replay(const uint8_t* payload, const uint8_t* end);
+
+        void flushPending();  // dispatches the events that were posted during replay
+
+        void attachDevice(Keyboard::OnKeyPressed& evt) const;
+        void attachDevice(Keyboard::OnKeyReleased& evt) const;
+
+        template <typename T>
+        void attachDevice(T& mouseEvent) const;
+
+        std::string m_Input        = "djinn_input.rec";
+        bool        m_StopWhenDone = true;
+
+        std::vector<uint8_t> m_Recording;
+        size_t               m_Cursor       = 0;  // offset of the next record
+        bool                 m_Started      = false;
+        bool                 m_Finished     = false;
+        uint64_t             m_FirstFrame   = 0;
+        size_t               m_NumReplayed  = 0;
+        uint32_t             m_PendingTypes = 0;  // bitmask of posted eEventTypes that weren't dispatched yet
+    };
+}  // namespace djinn
+
+#include "input_replayer.inl"
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "core/engine.h"
+#include "core/mediator.h"
+#include "input.h"
+#include "input_replayer.h"
+
+namespace djinn {
+    template <typename T>
+    void InputReplayer::replay(const uint8_t* payload, const uint8_t* end) {
+        T evt = {};
+
+        if (!input::record::EventTraits<T>::read(payload, end, evt)) {
+            gLogWarning << "Truncated input event in " << m_Input << ", skipping";
+            return;
+        }
+
+        attachDevice(evt);
+
+        if constexpr (k_IsPosted<T>) {
+            constexpr uint32_t bit = 1u << static_cast<uint16_t>(input::record::EventTraits<T>::k_Type);
+
+            // every record was a separate delivery, don't let them coalesce
+            if (m_PendingTypes & bit)
+                dispatch<T>();
+
+            post(std::move(evt));
+            m_PendingTypes |= bit;
+        }
+        else {
+            // the posted events that came before it were delivered before it as well
+            flushPending();
+            broadcast(evt);
+        }
+
+        ++m_NumReplayed;
+    }
+
+    template <typename T>
+    void InputReplayer::attachDevice(T& mouseEvent) const {
+        mouseEvent.m_Mouse = nullptr;
+
+        if (auto* inputSystem = m_Engine->get<Input>())
+            if (!inputSystem->getMice().empty())
+                mouseEvent.m_Mouse = inputSystem->getMice().front();
+    }
+}  // namespace djinn
@@ -31,6 +31,8 @@ namespace djinn::input {
         if (current != isPressed) {
             m_Buttons[static_cast<std::underlying_type_t<eButton>>(button)] = isPressed;
 
+            flushPending();
+
             if (isPressed)
                 broadcast(OnButtonPressed{this, m_X, m_Y, button});
             else
@@ -45,25 +47,35 @@ namespace djinn::input {
         m_X = x;
         m_Y = y;
 
-        broadcast(OnMoved{this, x, y, x - oldX, y - oldY});
+        post(OnMoved{this, x, y, x - oldX, y - oldY});
     }
 
     void Mouse::doDoubleClick(eButton button) {
+        flushPending();
         broadcast(OnDoubleClick{this, m_X, m_Y, button});
     }
 
     void Mouse::doScroll(int amount) {
-        broadcast(OnScroll{this, amount});
+        post(OnScroll{this, amount});
     }
 
     void Mouse::doEnter(Window* w) {
+        flushPending();
         broadcast(OnEnterWindow{this, w});
     }
 
     void Mouse::doLeave(Window* w) {
+        flushPending();
         broadcast(OnLeaveWindow{this, w});
     }
 
+    void Mouse::flushPending() {
+        // deliver the (accumulated) movement first, so handlers see the events in the
+        // order in which they happened
+        dispatch<OnMoved>();
+        dispatch<OnScroll>();
+    }
+
     std::ostream& operator<<(std::ostream& os, const Mouse::eButton& button) {
         using eButton = Mouse::eButton;
 
@@ -120,3 +132,21 @@ namespace djinn::input {
         return os;
     }
 }  // namespace djinn::input
+
+namespace djinn {
+    void MessagePolicy<input::Mouse::OnMoved>::accumulate(
+        input::Mouse::OnMoved&       total,
+        const input::Mouse::OnMoved& next) {
+        total.m_X = next.m_X;
+        total.m_Y = next.m_Y;
+
+        total.m_DeltaX += next.m_DeltaX;
+        total.m_DeltaY += next.m_DeltaY;
+    }
+
+    void MessagePolicy<input::Mouse::OnScroll>::accumulate(
+        input::Mouse::OnScroll&       total,
+        const input::Mouse::OnScroll& next) {
+        total.m_ScrollAmount += next.m_ScrollAmount;
+    }
+}  // namespace djinn
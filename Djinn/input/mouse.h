@@ -1,5 +1,7 @@
 #pragma once
 
+#include "core/message_policy.h"
+
 #include <iosfwd>
 #include <utility>
 
@@ -50,6 +52,9 @@ namespace djinn {
             void doLeave(Window* w);
 
             // --------------------- Events -----------------------
+            // [NOTE] OnMoved and OnScroll are posted, and accumulated into a single event per
+            //        dispatch (once per frame); the other events are broadcast immediately, after
+            //        dispatching any movement or scrolling that is still pending
             struct OnMoved {
                 Mouse* m_Mouse;
                 float  m_X;
@@ -96,6 +101,8 @@ namespace djinn {
             };
 
         private:
+            void flushPending();  // dispatches OnMoved and OnScroll
+
             Input* m_Manager;
 
             bool  m_Buttons[3] = {};
@@ -113,4 +120,19 @@ namespace djinn {
         std::ostream& operator<<(std::ostream& os, const Mouse::OnEnterWindow& ew);
         std::ostream& operator<<(std::ostream& os, const Mouse::OnLeaveWindow& lw);
     }  // namespace input
+
+    // the most recent position, with the deltas summed
+    template <>
+    struct MessagePolicy<input::Mouse::OnMoved> {
+        static constexpr eCoalescing k_Coalescing = eCoalescing::ACCUMULATE;
+
+        static void accumulate(input::Mouse::OnMoved& total, const input::Mouse::OnMoved& next);
+    };
+
+    template <>
+    struct MessagePolicy<input::Mouse::OnScroll> {
+        static constexpr eCoalescing k_Coalescing = eCoalescing::ACCUMULATE;
+
+        static void accumulate(input::Mouse::OnScroll& total, const input::Mouse::OnScroll& next);
+    };
 }  // namespace djinn
@@ -1,14 +1,16 @@
 #pragma once
 
-// Platform detection macros and platform specific definitions
-#include "preprocessor.h"
+// Platform detection macros, platform specific definitions and build switches
+#include "compile_options.h"
 
+#if DJINN_VULKAN
 // The C++ interface for Vulkan, SPIRV and shaderC
 #include <shaderc/shaderc.hpp>
 #include <vulkan/spirv.hpp>
 #include <vulkan/vulkan.hpp>  // https://vulkan.lunarg.com/doc/sdk/1.1.92.1/windows/vkspec.html
 
 #include "vk_ostream.h"
+#endif
 
 #pragma warning(push)
 #define GLM_FORCE_RADIANS
@@ -28,7 +30,7 @@
 // ~~ please follow https://vulkan.lunarg.com/doc/sdk/1.1.106.0/windows/spirv_toolchain.html to obtain debug-compatible
 // shaderc library builds
 
-#if DJINN_PLATFORM == DJINN_PLATFORM_WINDOWS
+#if DJINN_VULKAN && (DJINN_PLATFORM == DJINN_PLATFORM_WINDOWS)
 // this #pragma is really more MSVC specific, but close enough
 #pragma comment(lib, "vulkan-1.lib")
 
@@ -42,3 +44,10 @@
 
 // JSON interoperability
 #include <json.hpp>  // https://github.com/nlohmann/json
+
+// Lock-free MPMC queue
+#include <concurrentqueue.h>  // https://github.com/cameron314/concurrentqueue
+#include <blockingconcurrentqueue.h>
+
+// std::span is C++20, so use the abseil one for now
+#include <absl/types/span.h>  // https://github.com/abseil/abseil-cpp
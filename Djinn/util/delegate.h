@@ -0,0 +1,71 @@
+#pragma once
+
+#include <type_traits>
+
+namespace djinn::util {
+    // A non-owning callable reference: an object pointer plus a statically bound function that
+    // knows how to invoke it. Unlike std::function this never allocates, is trivially copyable
+    // and can be compared, which makes it suitable for (large) lists of callbacks.
+    //
+    // Usage:
+    //     Delegate<void(int)> d = Delegate<void(int)>::bind<&Foo::bar>(&foo); // member function
+    //     Delegate<void(int)> e = Delegate<void(int)>::bind(&functor);       // operator()
+    //     Delegate<void(int)> f = Delegate<void(int)>::bind<&freeFunction>(); // free function
+    //
+    // [NOTE] the delegate does not extend the lifetime of the bound object
+    // [NOTE] delegates compare by object and by the identity of the bound function, not by the
+    //        address of the thunk; identical thunks may be folded by the linker (/OPT:ICF)
+    template <typename Signature>
+    class Delegate;
+
+    namespace detail {
+        // the address of s_Tag identifies the bound function; it's a mutable variable
+        // so the linker can't fold it with another one
+        template <auto Target>
+        struct DelegateTarget {
+            static inline char s_Tag = 0;
+        };
+
+        template <typename T>
+        struct DelegateType {
+            static inline char s_Tag = 0;
+        };
+    }  // namespace detail
+
+    template <typename R, typename... tArgs>
+    class Delegate<R(tArgs...)> {
+    public:
+        using Thunk = R (*)(void*, tArgs...);
+
+        constexpr Delegate() = default;
+        Delegate(void* object, Thunk thunk);  // for custom thunks, identified by the thunk itself
+        constexpr Delegate(void* object, Thunk thunk, const void* identity);
+
+        template <auto Method, typename T>
+        static Delegate bind(T* object);  // member function
+
+        template <typename T>
+        static Delegate bind(T* object);  // T::operator()
+
+        template <auto Function>
+        static Delegate bind();  // free function
+
+        R operator()(tArgs... args) const;
+
+        explicit operator bool() const;
+
+        bool operator==(const Delegate& other) const;
+        bool operator!=(const Delegate& other) const;
+
+        void*       getObject() const;
+        Thunk       getThunk() const;
+        const void* getIdentity() const;
+
+    private:
+        void*       m_Object   = nullptr;
+        Thunk       m_Thunk    = nullptr;
+        const void* m_Identity = nullptr;
+    };
+}  // namespace djinn::util
+
+#include "delegate.inl"
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "delegate.h"
+
+#include <cassert>
+#include <utility>
+
+namespace djinn::util {
+    template <typename R, typename... tArgs>
+    Delegate<R(tArgs...)>::Delegate(void* object, Thunk thunk):
+        m_Object(object),
+        m_Thunk(thunk),
+        m_Identity(reinterpret_cast<const void*>(thunk)) {}
+
+    template <typename R, typename... tArgs>
+    constexpr Delegate<R(tArgs...)>::Delegate(void* object, Thunk thunk, const void* identity):
+        m_Object(object),
+        m_Thunk(thunk),
+        m_Identity(identity) {}
+
+    template <typename R, typename... tArgs>
+    template <auto Method, typename T>
+    Delegate<R(tArgs...)> Delegate<R(tArgs...)>::bind(T* object) {
+        static_assert(std::is_member_function_pointer_v<decltype(Method)>, "Expected a member function");
+
+        return Delegate(
+            const_cast<void*>(static_cast<const void*>(object)),
+            [](void* obj, tArgs... args) -> R { return (static_cast<T*>(obj)->*Method)(std::forward<tArgs>(args)...); },
+            &detail::DelegateTarget<Method>::s_Tag);
+    }
+
+    template <typename R, typename... tArgs>
+    template <typename T>
+    Delegate<R(tArgs...)> Delegate<R(tArgs...)>::bind(T* object) {
+        return Delegate(
+            const_cast<void*>(static_cast<const void*>(object)),
+            [](void* obj, tArgs... args) -> R { return (*static_cast<T*>(obj))(std::forward<tArgs>(args)...); },
+            &detail::DelegateType<T>::s_Tag);
+    }
+
+    template <typename R, typename... tArgs>
+    template <auto Function>
+    Delegate<R(tArgs...)> Delegate<R(tArgs...)>::bind() {
+        return Delegate(
+            nullptr,
+            [](void*, tArgs... args) -> R { return Function(std::forward<tArgs>(args)...); },
+            &detail::DelegateTarget<Function>::s_Tag);
+    }
+
+    template <typename R, typename... tArgs>
+    R Delegate<R(tArgs...)>::operator()(tArgs... args) const {
+        assert(m_Thunk);
+        return m_Thunk(m_Object, std::forward<tArgs>(args)...);
+    }
+
+    template <typename R, typename... tArgs>
+    Delegate<R(tArgs...)>::operator bool() const {
+        return m_Thunk != nullptr;
+    }
+
+    template <typename R, typename... tArgs>
+    bool Delegate<R(tArgs...)>::operator==(const Delegate& other) const {
+        return (m_Object == other.m_Object) && (m_Identity == other.m_Identity);
+    }
+
+    template <typename R, typename... tArgs>
+    bool Delegate<R(tArgs...)>::operator!=(const Delegate& other) const {
+        return !(*this == other);
+    }
+
+    template <typename R, typename... tArgs>
+    void* Delegate<R(tArgs...)>::getObject() const {
+        return m_Object;
+    }
+
+    template <typename R, typename... tArgs>
+    typename Delegate<R(tArgs...)>::Thunk Delegate<R(tArgs...)>::getThunk() const {
+        return m_Thunk;
+    }
+
+    template <typename R, typename... tArgs>
+    const void* Delegate<R(tArgs...)>::getIdentity() const {
+        return m_Identity;
+    }
+}  // namespace djinn::util
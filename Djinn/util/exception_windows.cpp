@@ -1,5 +1,7 @@
 #include "exception_windows.h"
 
+#if DJINN_PLATFORM == DJINN_PLATFORM_WINDOWS
+
 namespace djinn::util {
     namespace {
         // DWORD ~> unsigned long
@@ -78,3 +80,5 @@ namespace djinn::util {
             throw HresultException(result);
     }
 }  // namespace djinn::util
+
+#endif
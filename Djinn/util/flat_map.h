@@ -1,34 +1,144 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <initializer_list>
 #include <iosfwd>
+#include <iterator>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 namespace djinn::util {
+    // what to do when bulk operations encounter a key more than once
+    enum class eDuplicatePolicy
+    {
+        KEEP_FIRST,  // the existing entry (or the earliest in the range) wins, like insert()
+        KEEP_LAST    // the latest entry in the range wins, like assign()
+    };
+
+    namespace detail {
+        template <typename C, typename = void>
+        struct IsTransparent: std::false_type {};
+
+        template <typename C>
+        struct IsTransparent<C, std::void_t<typename C::is_transparent>>: std::true_type {};
+    }  // namespace detail
+
+    // Random access iterator over a FlatMap; keys and values are stored separately, so this
+    // yields a std::pair of references instead of a reference to a pair. Works with ranged-for
+    // (including structured bindings) and the non-modifying algorithms.
+    //
+    // [NOTE] V is const for a const_iterator
+    // [NOTE] because of the proxy reference, algorithms that swap elements (std::sort etc)
+    //        won't work -- the map is sorted anyway
+    template <typename K, typename V>
+    class FlatMapIterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = std::pair<K, std::remove_const_t<V>>;
+        using difference_type   = std::ptrdiff_t;
+        using reference         = std::pair<const K&, V&>;
+
+        struct pointer {
+            reference  m_Reference;
+            reference* operator->() { return &m_Reference; }
+        };
+
+        FlatMapIterator() = default;
+        FlatMapIterator(const K* key, V* value);
+
+        // iterator -> const_iterator
+        template <typename U, typename = std::enable_if_t<std::is_same_v<const U, V>>>
+        FlatMapIterator(const FlatMapIterator<K, U>& it);
+
+        reference operator*() const;
+        pointer   operator->() const;
+        reference operator[](difference_type offset) const;
+
+        const K& key() const;
+        V&       value() const;
+
+        FlatMapIterator& operator++();
+        FlatMapIterator  operator++(int);
+        FlatMapIterator& operator--();
+        FlatMapIterator  operator--(int);
+        FlatMapIterator& operator+=(difference_type offset);
+        FlatMapIterator& operator-=(difference_type offset);
+
+        FlatMapIterator operator+(difference_type offset) const;
+        FlatMapIterator operator-(difference_type offset) const;
+        difference_type operator-(const FlatMapIterator& it) const;
+
+        bool operator==(const FlatMapIterator& it) const;
+        bool operator!=(const FlatMapIterator& it) const;
+        bool operator<(const FlatMapIterator& it) const;
+        bool operator>(const FlatMapIterator& it) const;
+        bool operator<=(const FlatMapIterator& it) const;
+        bool operator>=(const FlatMapIterator& it) const;
+
+    private:
+        template <typename, typename>
+        friend class FlatMapIterator;
+
+        const K* m_Key   = nullptr;
+        V*       m_Value = nullptr;
+    };
+
+    template <typename K, typename V>
+    FlatMapIterator<K, V> operator+(typename FlatMapIterator<K, V>::difference_type offset, const FlatMapIterator<K, V>& it);
+
     // Thin wrapper around std::lower_bound and std::vector, should be pretty fast for
     // most 'normal' key-value lookups. Keeps the keys in sorted order.
     //
-    // [NOTE] Key must implement < (less) and == (equals). Value should be at least movable
+    // The order is determined by C (std::less by default); keys are considered equal when
+    // neither is ordered before the other. With a transparent comparator (such as std::less<>)
+    // lookups accept anything that can be compared with a key, so a map with std::string keys
+    // can be searched with a std::string_view or a string literal without a temporary.
+    //
+    // [NOTE] Value should be at least movable
     // [NOTE] not threadsafe, but should be fine
-    // [NOTE] could possibly customize the sorting order, but that would cause a bunch
-    //        of template noise
+    // [NOTE] assign/insert shift the tail of the map on every call; when building a map from
+    //        many entries use the range constructor, insert_range or merge instead, which sort
+    //        the new entries once and merge them in a single pass
+    // [NOTE] iterators are invalidated by anything that modifies the map (apart from the values)
     //
-    // [TODO] implement FlatMapIterator, compatibility with ranged-for loops
+    // Lookups in large maps that rarely change can be sped up with freeze(), which stores an
+    // extra copy of the keys in Eytzinger (breadth first) order. The top levels of that tree are
+    // next to each other in memory, so they tend to stay in the cache, and the search itself is
+    // branchless and prefetches a few levels ahead. Adding or removing keys unfreezes the map.
+    // Small maps with integer keys (and the default comparator) are searched linearly instead,
+    // with SSE2 where available.
     //
-    template <typename K, typename V>
+    template <typename K, typename V, typename C = std::less<K>>
     class FlatMap {
     public:
         using Key              = K;
         using Value            = V;
+        using Compare          = C;
         using KeyValueCallback = std::function<void(const K&, const V&)>;
+        using iterator         = FlatMapIterator<K, V>;
+        using const_iterator   = FlatMapIterator<K, const V>;
 
         FlatMap() = default;
+        explicit FlatMap(const C& compare);
+
+        // the ranges should yield std::pair<K, V> (or something similar)
+        template <typename tIterator>
+        FlatMap(tIterator first, tIterator last, eDuplicatePolicy policy = eDuplicatePolicy::KEEP_LAST);
+        FlatMap(std::initializer_list<std::pair<K, V>> values, eDuplicatePolicy policy = eDuplicatePolicy::KEEP_LAST);
 
         V*              operator[](const K& k);        // will return nullptr if not found (!)
         const V*        operator[](const K& k) const;  // will return nullptr if not found
         std::pair<K, V> at(int index) const;           // will throw if index is out of bounds
 
+        // heterogeneous versions, only available with a transparent comparator
+        template <typename tKey, typename tCompare = C, typename = std::enable_if_t<detail::IsTransparent<tCompare>::value>>
+        V* operator[](const tKey& key);
+        template <typename tKey, typename tCompare = C, typename = std::enable_if_t<detail::IsTransparent<tCompare>::value>>
+        const V* operator[](const tKey& key) const;
+
         void               assign(const K& key, const V& value);
         void               assign(const K& key, V&& value);
         [[nodiscard]] bool insert(
@@ -38,24 +148,92 @@ namespace djinn::util {
             const K& key,
             V&&      value);  // returns false if this would overwrite an entry
 
+        template <typename tIterator>
+        void insert_range(tIterator first, tIterator last, eDuplicatePolicy policy = eDuplicatePolicy::KEEP_LAST);
+        void merge(const FlatMap& other, eDuplicatePolicy policy = eDuplicatePolicy::KEEP_LAST);
+        void merge(FlatMap&& other, eDuplicatePolicy policy = eDuplicatePolicy::KEEP_LAST);
+
         bool contains(const K& key) const;
         void erase(const K& key);
         void clear() noexcept;
 
+        template <typename tKey, typename tCompare = C, typename = std::enable_if_t<detail::IsTransparent<tCompare>::value>>
+        bool contains(const tKey& key) const;
+
+        void freeze();             // builds the read optimized layout; has no effect on an empty map
+        void unfreeze() noexcept;  // drops it again
+        bool isFrozen() const noexcept;
+
+        iterator       find(const K& key);  // yields end() if not found
+        const_iterator find(const K& key) const;
+
+        template <typename tKey, typename tCompare = C, typename = std::enable_if_t<detail::IsTransparent<tCompare>::value>>
+        iterator find(const tKey& key);
+        template <typename tKey, typename tCompare = C, typename = std::enable_if_t<detail::IsTransparent<tCompare>::value>>
+        const_iterator find(const tKey& key) const;
+
+        iterator       begin() noexcept;
+        iterator       end() noexcept;
+        const_iterator begin() const noexcept;
+        const_iterator end() const noexcept;
+        const_iterator cbegin() const noexcept;
+        const_iterator cend() const noexcept;
+
+        void   reserve(size_t count);
+        void   shrink_to_fit();
+        size_t capacity() const noexcept;
+
         size_t size() const noexcept;
+        bool   empty() const noexcept;
 
         const std::vector<K>& getKeys() const noexcept;
         const std::vector<V>& getValues() const noexcept;
+        const C&              getCompare() const noexcept;
 
         void foreach (const KeyValueCallback& callback) const;
 
     private:
+        // integral keys in maps up to this size are searched linearly
+        static constexpr size_t k_LinearSearchLimit = 32;
+
+        template <typename tKey>
+        static constexpr bool k_UseLinearSearch = std::is_integral_v<K> && !std::is_same_v<K, bool> &&
+                                                  std::is_same_v<tKey, K> && std::is_same_v<C, std::less<K>>;
+
+        // yields size() if the key is not present
+        template <typename tKey>
+        size_t findIndex(const tKey& key) const;
+        template <typename tKey>
+        size_t frozenFindIndex(const tKey& key) const;
+
+        // yields the index of the first key that is not ordered before the given one
+        template <typename tKey>
+        size_t lowerBound(const tKey& key) const;
+        template <typename tKey>
+        size_t sortedLowerBound(const tKey& key) const;  // ignores the frozen layout
+
+        template <typename tKey>
+        bool useLinearSearch() const noexcept;
+
+        // yields the position in the frozen layout, or 0 if every key is ordered before the given one
+        template <typename tKey>
+        size_t frozenLowerBound(const tKey& key) const;
+        size_t buildFrozen(size_t sortedIndex, size_t position);  // yields the next sorted index
+
+        // combines sorted, unique keys (with their values) with the current contents
+        void mergeSorted(std::vector<K>&& keys, std::vector<V>&& values, eDuplicatePolicy policy);
+
         std::vector<Key>   m_Keys;
         std::vector<Value> m_Values;
+        C                  m_Compare;
+
+        // frozen layout; 1-based, [0] is unused for the keys and holds size() for the indices
+        std::vector<Key>      m_FrozenKeys;
+        std::vector<uint32_t> m_FrozenIndices;  // into m_Keys
     };
 
-    template <typename K, typename V>
-    std::ostream& operator<<(std::ostream& os, const FlatMap<K, V>& fm);
+    template <typename K, typename V, typename C>
+    std::ostream& operator<<(std::ostream& os, const FlatMap<K, V, C>& fm);
 }  // namespace djinn::util
 
 #include "flat_map.inl"
@@ -2,218 +2,804 @@
 
 #include "algorithm.h"
 #include "flat_map.h"
+#include <algorithm>
+#include <climits>
+#include <cstdint>
 #include <iterator>  // for std::distance
+#include <numeric>
 #include <ostream>
 
+#if defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)) || defined(__SSE2__)
+    #define DJINN_FLAT_MAP_SSE2 1
+    #include <emmintrin.h>
+#else
+    #define DJINN_FLAT_MAP_SSE2 0
+#endif
+
+#ifdef _MSC_VER
+    #include <intrin.h>
+#endif
+
 namespace djinn::util {
-    template <typename K, typename V>
-    V* FlatMap<K, V>::operator[](const K& k) {
-        // [NOTE] could make an util::algorithm version of lower_bound
-        using namespace std;
+    namespace detail {
+        // [NOTE] x must not be all ones
+        inline unsigned countTrailingOnes(size_t x) noexcept {
+#ifdef _MSC_VER
+            unsigned long index = 0;
+    #if defined(_M_X64) || defined(_M_ARM64)
+            _BitScanForward64(&index, ~static_cast<unsigned __int64>(x));
+    #else
+            _BitScanForward(&index, ~static_cast<unsigned long>(x));
+    #endif
+            return static_cast<unsigned>(index);
+#else
+            return static_cast<unsigned>(__builtin_ctzll(~static_cast<unsigned long long>(x)));
+#endif
+        }
 
-        auto it = lower_bound(begin(m_Keys), end(m_Keys), k);
+        // only a hint, so the address doesn't have to be valid
+        inline void prefetch(const void* address) noexcept {
+#if DJINN_FLAT_MAP_SSE2
+            _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#elif defined(__GNUC__)
+            __builtin_prefetch(address);
+#else
+            (void)address;
+#endif
+        }
 
-        if (it == end(m_Keys))
-            return nullptr;
-        else {
-            const auto index = distance(begin(m_Keys), it);
-            return &m_Values[index];
+        // number of keys that are less than the given one; the keys should be sorted,
+        // so this is the lower bound. Checks every key, which is faster than a binary
+        // search for small arrays (no unpredictable branches).
+        template <typename K>
+        size_t linearLowerBound(const K* keys, size_t count, K key) noexcept {
+            size_t result = 0;
+            size_t i      = 0;
+
+#if DJINN_FLAT_MAP_SSE2
+            if constexpr (sizeof(K) == 4) {
+                // SSE2 only has signed comparisons, so flip the sign bit for unsigned keys
+                const __m128i bias   = std::is_signed_v<K> ? _mm_setzero_si128() : _mm_set1_epi32(INT_MIN);
+                const __m128i needle = _mm_xor_si128(_mm_set1_epi32(static_cast<int>(key)), bias);
+
+                __m128i total = _mm_setzero_si128();
+
+                for (; i + 4 <= count; i += 4) {
+                    auto block = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i)), bias);
+                    total      = _mm_sub_epi32(total, _mm_cmplt_epi32(block, needle));  // 'true' lanes are -1
+                }
+
+                total  = _mm_add_epi32(total, _mm_shuffle_epi32(total, _MM_SHUFFLE(1, 0, 3, 2)));
+                total  = _mm_add_epi32(total, _mm_shuffle_epi32(total, _MM_SHUFFLE(2, 3, 0, 1)));
+                result = static_cast<size_t>(_mm_cvtsi128_si32(total));
+            }
+#endif
+
+            for (; i < count; ++i)
+                result += static_cast<size_t>(keys[i] < key);
+
+            return result;
         }
+    }  // namespace detail
+
+    template <typename K, typename V>
+    FlatMapIterator<K, V>::FlatMapIterator(const K* key, V* value):
+        m_Key(key),
+        m_Value(value) {}
+
+    template <typename K, typename V>
+    template <typename U, typename>
+    FlatMapIterator<K, V>::FlatMapIterator(const FlatMapIterator<K, U>& it):
+        m_Key(it.m_Key),
+        m_Value(it.m_Value) {}
+
+    template <typename K, typename V>
+    typename FlatMapIterator<K, V>::reference FlatMapIterator<K, V>::operator*() const {
+        return reference(*m_Key, *m_Value);
     }
 
     template <typename K, typename V>
-    const V* FlatMap<K, V>::operator[](const K& k) const {
-        // [NOTE] could make an util::algorithm version of lower_bound
-        using namespace std;
+    typename FlatMapIterator<K, V>::pointer FlatMapIterator<K, V>::operator->() const {
+        return pointer{**this};
+    }
 
-        auto it = lower_bound(begin(m_Keys), end(m_Keys), k);
+    template <typename K, typename V>
+    typename FlatMapIterator<K, V>::reference FlatMapIterator<K, V>::operator[](difference_type offset) const {
+        return reference(m_Key[offset], m_Value[offset]);
+    }
 
-        if (it == end(m_Keys))
-            return nullptr;
-        else {
-            auto index = distance(begin(m_Keys), it);
-            return &m_Values[index];
-        }
+    template <typename K, typename V>
+    const K& FlatMapIterator<K, V>::key() const {
+        return *m_Key;
     }
 
     template <typename K, typename V>
-    std::pair<K, V> FlatMap<K, V>::at(int index) const {
-        return std::make_pair(m_Keys[index], m_Values[index]);
+    V& FlatMapIterator<K, V>::value() const {
+        return *m_Value;
     }
 
     template <typename K, typename V>
-    void FlatMap<K, V>::assign(const K& key, const V& value) {
-        using namespace std;
+    FlatMapIterator<K, V>& FlatMapIterator<K, V>::operator++() {
+        ++m_Key;
+        ++m_Value;
+
+        return *this;
+    }
+
+    template <typename K, typename V>
+    FlatMapIterator<K, V> FlatMapIterator<K, V>::operator++(int) {
+        auto result = *this;
+        ++(*this);
+        return result;
+    }
+
+    template <typename K, typename V>
+    FlatMapIterator<K, V>& FlatMapIterator<K, V>::operator--() {
+        --m_Key;
+        --m_Value;
+
+        return *this;
+    }
+
+    template <typename K, typename V>
+    FlatMapIterator<K, V> FlatMapIterator<K, V>::operator--(int) {
+        auto result = *this;
+        --(*this);
+        return result;
+    }
+
+    template <typename K, typename V>
+    FlatMapIterator<K, V>& FlatMapIterator<K, V>::operator+=(difference_type offset) {
+        m_Key += offset;
+        m_Value += offset;
+
+        return *this;
+    }
+
+    template <typename K, typename V>
+    FlatMapIterator<K, V>& FlatMapIterator<K, V>::operator-=(difference_type offset) {
+        m_Key -= offset;
+        m_Value -= offset;
+
+        return *this;
+    }
+
+    template <typename K, typename V>
+    FlatMapIterator<K, V> FlatMapIterator<K, V>::operator+(difference_type offset) const {
+        auto result = *this;
+        result += offset;
+        return result;
+    }
+
+    template <typename K, typename V>
+    FlatMapIterator<K, V> FlatMapIterator<K, V>::operator-(difference_type offset) const {
+        auto result = *this;
+        result -= offset;
+        return result;
+    }
+
+    template <typename K, typename V>
+    typename FlatMapIterator<K, V>::difference_type FlatMapIterator<K, V>::operator-(const FlatMapIterator& it) const {
+        return m_Key - it.m_Key;
+    }
+
+    template <typename K, typename V>
+    bool FlatMapIterator<K, V>::operator==(const FlatMapIterator& it) const {
+        return m_Key == it.m_Key;
+    }
+
+    template <typename K, typename V>
+    bool FlatMapIterator<K, V>::operator!=(const FlatMapIterator& it) const {
+        return m_Key != it.m_Key;
+    }
+
+    template <typename K, typename V>
+    bool FlatMapIterator<K, V>::operator<(const FlatMapIterator& it) const {
+        return m_Key < it.m_Key;
+    }
+
+    template <typename K, typename V>
+    bool FlatMapIterator<K, V>::operator>(const FlatMapIterator& it) const {
+        return m_Key > it.m_Key;
+    }
 
-        // [NOTE] could make an util::algorithm version of lower_bound
-        auto lower = lower_bound(begin(m_Keys), end(m_Keys), key);
+    template <typename K, typename V>
+    bool FlatMapIterator<K, V>::operator<=(const FlatMapIterator& it) const {
+        return m_Key <= it.m_Key;
+    }
+
+    template <typename K, typename V>
+    bool FlatMapIterator<K, V>::operator>=(const FlatMapIterator& it) const {
+        return m_Key >= it.m_Key;
+    }
+
+    template <typename K, typename V>
+    FlatMapIterator<K, V> operator+(typename FlatMapIterator<K, V>::difference_type offset, const FlatMapIterator<K, V>& it) {
+        return it + offset;
+    }
+
+    template <typename K, typename V, typename C>
+    FlatMap<K, V, C>::FlatMap(const C& compare):
+        m_Compare(compare) {}
+
+    template <typename K, typename V, typename C>
+    template <typename tIterator>
+    FlatMap<K, V, C>::FlatMap(tIterator first, tIterator last, eDuplicatePolicy policy) {
+        insert_range(first, last, policy);
+    }
+
+    template <typename K, typename V, typename C>
+    FlatMap<K, V, C>::FlatMap(std::initializer_list<std::pair<K, V>> values, eDuplicatePolicy policy) {
+        insert_range(values.begin(), values.end(), policy);
+    }
+
+    template <typename K, typename V, typename C>
+    V* FlatMap<K, V, C>::operator[](const K& k) {
+        auto index = findIndex(k);
+
+        if (index == m_Keys.size())
+            return nullptr;
 
-        if (lower != end(m_Keys)) {
-            // lower_bound found some location that is either
+        return &m_Values[index];
+    }
+
+    template <typename K, typename V, typename C>
+    const V* FlatMap<K, V, C>::operator[](const K& k) const {
+        auto index = findIndex(k);
+
+        if (index == m_Keys.size())
+            return nullptr;
+
+        return &m_Values[index];
+    }
+
+    template <typename K, typename V, typename C>
+    template <typename tKey, typename, typename>
+    V* FlatMap<K, V, C>::operator[](const tKey& key) {
+        auto index = findIndex(key);
+
+        if (index == m_Keys.size())
+            return nullptr;
+
+        return &m_Values[index];
+    }
+
+    template <typename K, typename V, typename C>
+    template <typename tKey, typename, typename>
+    const V* FlatMap<K, V, C>::operator[](const tKey& key) const {
+        auto index = findIndex(key);
+
+        if (index == m_Keys.size())
+            return nullptr;
+
+        return &m_Values[index];
+    }
+
+    template <typename K, typename V, typename C>
+    std::pair<K, V> FlatMap<K, V, C>::at(int index) const {
+        return std::make_pair(m_Keys[index], m_Values[index]);
+    }
+
+    template <typename K, typename V, typename C>
+    void FlatMap<K, V, C>::assign(const K& key, const V& value) {
+        auto index = lowerBound(key);
+
+        if (index != m_Keys.size()) {
+            // lowerBound found some location that is either
             // 1) where the exact key was found
             //   or
             // 2) the insertion point where it should be
             //
-            auto index = distance(begin(m_Keys), lower);
-
-            if (*lower == key)
+            if (!m_Compare(key, m_Keys[index]))
                 m_Values[index] = value;
             else {
-                m_Keys.insert(lower, key);
-                m_Values.insert(begin(m_Values) + index, value);
+                unfreeze();
+                m_Keys.insert(m_Keys.begin() + index, key);
+                m_Values.insert(m_Values.begin() + index, value);
             }
 
             return;
         }
 
-        // lower_bound reached the end
+        // lowerBound reached the end
+        unfreeze();
         m_Keys.push_back(key);
         m_Values.push_back(value);
     }
 
-    template <typename K, typename V>
-    void FlatMap<K, V>::assign(const K& key, V&& value) {
-        using namespace std;
-
-        // [NOTE] could make an util::algorithm version of lower_bound
-        auto lower = lower_bound(begin(m_Keys), end(m_Keys), key);
+    template <typename K, typename V, typename C>
+    void FlatMap<K, V, C>::assign(const K& key, V&& value) {
+        auto index = lowerBound(key);
 
-        if (lower != end(m_Keys)) {
-            // lower_bound found some location that is either
+        if (index != m_Keys.size()) {
+            // lowerBound found some location that is either
             // 1) where the exact key was found
             //   or
             // 2) the insertion point where it should be
             //
-            const auto index = distance(begin(m_Keys), lower);
-
-            if (*lower == key)
+            if (!m_Compare(key, m_Keys[index]))
                 m_Values[index] = std::forward<V>(value);
             else {
-                m_Keys.insert(lower, key);
-                m_Values.insert(begin(m_Values) + index, std::forward<V>(value));
+                unfreeze();
+                m_Keys.insert(m_Keys.begin() + index, key);
+                m_Values.insert(m_Values.begin() + index, std::forward<V>(value));
             }
 
             return;
         }
 
-        // lower_bound reached the end
+        // lowerBound reached the end
+        unfreeze();
         m_Keys.push_back(key);
         m_Values.push_back(std::forward<V>(value));
     }
 
-    template <typename K, typename V>
-    bool FlatMap<K, V>::insert(const K& key, const V& value) {
-        using namespace std;
-
-        // [NOTE] could make an util::algorithm version of lower_bound
-        auto lower = lower_bound(begin(m_Keys), end(m_Keys), key);
+    template <typename K, typename V, typename C>
+    bool FlatMap<K, V, C>::insert(const K& key, const V& value) {
+        auto index = lowerBound(key);
 
-        if (lower != end(m_Keys)) {
-            // lower_bound found some location that is either
+        if (index != m_Keys.size()) {
+            // lowerBound found some location that is either
             // 1) where the exact key was found
             //   or
             // 2) the insertion point where it should be
             //
-            auto index = distance(begin(m_Keys), lower);
-
-            if (*lower == key)
+            if (!m_Compare(key, m_Keys[index]))
                 return false;
             else {
-                m_Keys.insert(lower, key);
-                m_Values.insert(begin(m_Values) + index, value);
+                unfreeze();
+                m_Keys.insert(m_Keys.begin() + index, key);
+                m_Values.insert(m_Values.begin() + index, value);
 
                 return true;
             }
         }
 
-        // lower_bound reached the end
+        // lowerBound reached the end
+        unfreeze();
         m_Keys.push_back(key);
         m_Values.push_back(value);
 
         return true;
     }
 
-    template <typename K, typename V>
-    bool FlatMap<K, V>::insert(const K& key, V&& value) {
-        using namespace std;
-
-        // [NOTE] could make an util::algorithm version of lower_bound
-        auto lower = lower_bound(begin(m_Keys), end(m_Keys), key);
+    template <typename K, typename V, typename C>
+    bool FlatMap<K, V, C>::insert(const K& key, V&& value) {
+        auto index = lowerBound(key);
 
-        if (lower != end(m_Keys)) {
-            // lower_bound found some location that is either
+        if (index != m_Keys.size()) {
+            // lowerBound found some location that is either
             // 1) where the exact key was found
             //   or
             // 2) the insertion point where it should be
             //
-            auto index = distance(begin(m_Keys), lower);
-
-            if (*lower == key)
+            if (!m_Compare(key, m_Keys[index]))
                 return false;
             else {
-                m_Keys.insert(lower, key);
-                m_Values.insert(begin(m_Values) + index, std::forward<V>(value));
+                unfreeze();
+                m_Keys.insert(m_Keys.begin() + index, key);
+                m_Values.insert(m_Values.begin() + index, std::forward<V>(value));
                 return true;
             }
         }
 
-        // lower_bound reached the end
+        // lowerBound reached the end
+        unfreeze();
         m_Keys.push_back(key);
         m_Values.push_back(std::forward<V>(value));
 
         return true;
     }
 
-    template <typename K, typename V>
-    bool FlatMap<K, V>::contains(const K& key) const {
-        return util::contains(m_Keys, key);
+    template <typename K, typename V, typename C>
+    template <typename tIterator>
+    void FlatMap<K, V, C>::insert_range(tIterator first, tIterator last, eDuplicatePolicy policy) {
+        using namespace std;
+
+        vector<K> keys;
+        vector<V> values;
+
+        if constexpr (is_base_of_v<forward_iterator_tag, typename iterator_traits<tIterator>::iterator_category>) {
+            auto count = static_cast<size_t>(distance(first, last));
+
+            keys.reserve(count);
+            values.reserve(count);
+        }
+
+        for (; first != last; ++first) {
+            auto&& entry = *first;  // moves the entries when given std::move_iterators
+
+            keys.push_back(std::forward<decltype(entry)>(entry).first);
+            values.push_back(std::forward<decltype(entry)>(entry).second);
+        }
+
+        // sort the new entries by key (via an index, keys and values are stored separately);
+        // the sort is stable so the policy can tell which duplicate came first
+        vector<size_t> order(keys.size());
+        iota(order.begin(), order.end(), size_t(0));
+
+        stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return m_Compare(keys[a], keys[b]); });
+
+        vector<K> sortedKeys;
+        vector<V> sortedValues;
+
+        sortedKeys.reserve(keys.size());
+        sortedValues.reserve(values.size());
+
+        for (auto index : order) {
+            bool isDuplicate = !sortedKeys.empty() && !m_Compare(sortedKeys.back(), keys[index]);
+
+            if (!isDuplicate) {
+                sortedKeys.push_back(std::move(keys[index]));
+                sortedValues.push_back(std::move(values[index]));
+            }
+            else if (policy == eDuplicatePolicy::KEEP_LAST)
+                sortedValues.back() = std::move(values[index]);
+        }
+
+        mergeSorted(std::move(sortedKeys), std::move(sortedValues), policy);
     }
 
-    template <typename K, typename V>
-    void FlatMap<K, V>::erase(const K& key) {
-        using namespace std;
+    template <typename K, typename V, typename C>
+    void FlatMap<K, V, C>::merge(const FlatMap& other, eDuplicatePolicy policy) {
+        if (&other == this)
+            return;
 
-        // [NOTE] could make an util::algorithm version of lower_bound
-        auto it = lower_bound(begin(m_Keys), end(m_Keys), key);
+        auto keys   = other.m_Keys;
+        auto values = other.m_Values;
+
+        mergeSorted(std::move(keys), std::move(values), policy);
+    }
 
-        if (it == end(m_Keys))
+    template <typename K, typename V, typename C>
+    void FlatMap<K, V, C>::merge(FlatMap&& other, eDuplicatePolicy policy) {
+        // merging a map into itself leaves it as is (like std::map::merge)
+        if (&other == this)
             return;
 
-        const auto index = distance(begin(m_Keys), it);
+        mergeSorted(std::move(other.m_Keys), std::move(other.m_Values), policy);
+        other.clear();
+    }
 
-        m_Keys.erase(it);
-        m_Values.erase(begin(m_Values) + index);
+    template <typename K, typename V, typename C>
+    bool FlatMap<K, V, C>::contains(const K& key) const {
+        return findIndex(key) != m_Keys.size();
     }
 
-    template <typename K, typename V>
-    void FlatMap<K, V>::clear() noexcept {
+    template <typename K, typename V, typename C>
+    template <typename tKey, typename, typename>
+    bool FlatMap<K, V, C>::contains(const tKey& key) const {
+        return findIndex(key) != m_Keys.size();
+    }
+
+    template <typename K, typename V, typename C>
+    void FlatMap<K, V, C>::erase(const K& key) {
+        auto index = findIndex(key);
+
+        if (index == m_Keys.size())
+            return;
+
+        unfreeze();
+        m_Keys.erase(m_Keys.begin() + index);
+        m_Values.erase(m_Values.begin() + index);
+    }
+
+    template <typename K, typename V, typename C>
+    void FlatMap<K, V, C>::clear() noexcept {
+        unfreeze();
         m_Keys.clear();
         m_Values.clear();
     }
 
-    template <typename K, typename V>
-    size_t FlatMap<K, V>::size() const noexcept {
+    template <typename K, typename V, typename C>
+    void FlatMap<K, V, C>::freeze() {
+        unfreeze();
+
+        // [NOTE] the positions are stored as 32 bits to keep the layout compact
+        if (m_Keys.empty() || (m_Keys.size() >= UINT32_MAX))
+            return;
+
+        m_FrozenKeys.assign(m_Keys.size() + 1, m_Keys.front());
+        m_FrozenIndices.assign(m_Keys.size() + 1, static_cast<uint32_t>(m_Keys.size()));
+
+        buildFrozen(0, 1);
+    }
+
+    template <typename K, typename V, typename C>
+    void FlatMap<K, V, C>::unfreeze() noexcept {
+        if (!isFrozen())
+            return;
+
+        m_FrozenKeys.clear();
+        m_FrozenKeys.shrink_to_fit();
+        m_FrozenIndices.clear();
+        m_FrozenIndices.shrink_to_fit();
+    }
+
+    template <typename K, typename V, typename C>
+    bool FlatMap<K, V, C>::isFrozen() const noexcept {
+        return !m_FrozenIndices.empty();
+    }
+
+    template <typename K, typename V, typename C>
+    typename FlatMap<K, V, C>::iterator FlatMap<K, V, C>::find(const K& key) {
+        return begin() + static_cast<std::ptrdiff_t>(findIndex(key));
+    }
+
+    template <typename K, typename V, typename C>
+    typename FlatMap<K, V, C>::const_iterator FlatMap<K, V, C>::find(const K& key) const {
+        return begin() + static_cast<std::ptrdiff_t>(findIndex(key));
+    }
+
+    template <typename K, typename V, typename C>
+    template <typename tKey, typename, typename>
+    typename FlatMap<K, V, C>::iterator FlatMap<K, V, C>::find(const tKey& key) {
+        return begin() + static_cast<std::ptrdiff_t>(findIndex(key));
+    }
+
+    template <typename K, typename V, typename C>
+    template <typename tKey, typename, typename>
+    typename FlatMap<K, V, C>::const_iterator FlatMap<K, V, C>::find(const tKey& key) const {
+        return begin() + static_cast<std::ptrdiff_t>(findIndex(key));
+    }
+
+    template <typename K, typename V, typename C>
+    typename FlatMap<K, V, C>::iterator FlatMap<K, V, C>::begin() noexcept {
+        return iterator(m_Keys.data(), m_Values.data());
+    }
+
+    template <typename K, typename V, typename C>
+    typename FlatMap<K, V, C>::iterator FlatMap<K, V, C>::end() noexcept {
+        return begin() + static_cast<std::ptrdiff_t>(m_Keys.size());
+    }
+
+    template <typename K, typename V, typename C>
+    typename FlatMap<K, V, C>::const_iterator FlatMap<K, V, C>::begin() const noexcept {
+        return const_iterator(m_Keys.data(), m_Values.data());
+    }
+
+    template <typename K, typename V, typename C>
+    typename FlatMap<K, V, C>::const_iterator FlatMap<K, V, C>::end() const noexcept {
+        return begin() + static_cast<std::ptrdiff_t>(m_Keys.size());
+    }
+
+    template <typename K, typename V, typename C>
+    typename FlatMap<K, V, C>::const_iterator FlatMap<K, V, C>::cbegin() const noexcept {
+        return begin();
+    }
+
+    template <typename K, typename V, typename C>
+    typename FlatMap<K, V, C>::const_iterator FlatMap<K, V, C>::cend() const noexcept {
+        return end();
+    }
+
+    template <typename K, typename V, typename C>
+    void FlatMap<K, V, C>::reserve(size_t count) {
+        m_Keys.reserve(count);
+        m_Values.reserve(count);
+    }
+
+    template <typename K, typename V, typename C>
+    void FlatMap<K, V, C>::shrink_to_fit() {
+        m_Keys.shrink_to_fit();
+        m_Values.shrink_to_fit();
+    }
+
+    template <typename K, typename V, typename C>
+    size_t FlatMap<K, V, C>::capacity() const noexcept {
+        return m_Keys.capacity();
+    }
+
+    template <typename K, typename V, typename C>
+    size_t FlatMap<K, V, C>::size() const noexcept {
         return m_Keys.size();
     }
 
-    template <typename K, typename V>
-    const std::vector<K>& FlatMap<K, V>::getKeys() const noexcept {
+    template <typename K, typename V, typename C>
+    bool FlatMap<K, V, C>::empty() const noexcept {
+        return m_Keys.empty();
+    }
+
+    template <typename K, typename V, typename C>
+    const std::vector<K>& FlatMap<K, V, C>::getKeys() const noexcept {
         return m_Keys;
     }
 
-    template <typename K, typename V>
-    const std::vector<V>& FlatMap<K, V>::getValues() const noexcept {
+    template <typename K, typename V, typename C>
+    const std::vector<V>& FlatMap<K, V, C>::getValues() const noexcept {
         return m_Values;
     }
 
-    template <typename K, typename V>
-    void FlatMap<K, V>::foreach (const KeyValueCallback& callback) const {
+    template <typename K, typename V, typename C>
+    const C& FlatMap<K, V, C>::getCompare() const noexcept {
+        return m_Compare;
+    }
+
+    template <typename K, typename V, typename C>
+    void FlatMap<K, V, C>::foreach (const KeyValueCallback& callback) const {
         for (size_t i = 0; i < m_Keys.size(); ++i)
             callback(m_Keys[i], m_Values[i]);
     }
 
-    template <typename K, typename V>
-    std::ostream& operator<<(std::ostream& os, const FlatMap<K, V>& fm) {
+    template <typename K, typename V, typename C>
+    template <typename tKey>
+    size_t FlatMap<K, V, C>::findIndex(const tKey& key) const {
+        // [NOTE] the frozen layout is checked once here, so the default path is a plain lower bound
+        if (isFrozen())
+            return frozenFindIndex(key);
+
+        auto index = sortedLowerBound(key);
+
+        // the lower bound only guarantees that the key is not ordered before the one it found
+        if ((index == m_Keys.size()) || m_Compare(key, m_Keys[index]))
+            return m_Keys.size();
+
+        return index;
+    }
+
+    template <typename K, typename V, typename C>
+    template <typename tKey>
+    size_t FlatMap<K, V, C>::frozenFindIndex(const tKey& key) const {
+        if constexpr (k_UseLinearSearch<tKey>) {
+            if (useLinearSearch<tKey>()) {
+                auto index = detail::linearLowerBound(m_Keys.data(), m_Keys.size(), key);
+
+                if ((index == m_Keys.size()) || m_Compare(key, m_Keys[index]))
+                    return m_Keys.size();
+
+                return index;
+            }
+        }
+
+        // compare with the frozen copy of the key, it was just loaded anyway
+        auto position = frozenLowerBound(key);
+
+        if ((position == 0) || m_Compare(key, m_FrozenKeys[position]))
+            return m_Keys.size();
+
+        return m_FrozenIndices[position];
+    }
+
+    template <typename K, typename V, typename C>
+    template <typename tKey>
+    size_t FlatMap<K, V, C>::lowerBound(const tKey& key) const {
+        if (isFrozen()) {
+            if constexpr (k_UseLinearSearch<tKey>) {
+                if (useLinearSearch<tKey>())
+                    return detail::linearLowerBound(m_Keys.data(), m_Keys.size(), key);
+            }
+
+            return m_FrozenIndices[frozenLowerBound(key)];  // [0] holds size()
+        }
+
+        return sortedLowerBound(key);
+    }
+
+    template <typename K, typename V, typename C>
+    template <typename tKey>
+    size_t FlatMap<K, V, C>::sortedLowerBound(const tKey& key) const {
+        if constexpr (k_UseLinearSearch<tKey>) {
+            if (m_Keys.size() <= k_LinearSearchLimit)
+                return detail::linearLowerBound(m_Keys.data(), m_Keys.size(), key);
+        }
+
+        auto it = std::lower_bound(m_Keys.begin(), m_Keys.end(), key, m_Compare);
+
+        return static_cast<size_t>(std::distance(m_Keys.begin(), it));
+    }
+
+    template <typename K, typename V, typename C>
+    template <typename tKey>
+    bool FlatMap<K, V, C>::useLinearSearch() const noexcept {
+        if constexpr (k_UseLinearSearch<tKey>)
+            return m_Keys.size() <= k_LinearSearchLimit;
+        else
+            return false;
+    }
+
+    template <typename K, typename V, typename C>
+    template <typename tKey>
+    size_t FlatMap<K, V, C>::frozenLowerBound(const tKey& key) const {
+        // the children of position k are at 2k and 2k+1, so its descendants a few levels down
+        // are adjacent (16k..16k+15 for 32 bit keys); fetching those keeps a cache line ahead
+        constexpr size_t k_PrefetchStride = (sizeof(K) < 64) ? (64 / sizeof(K)) : 1;
+
+        const K* keys  = m_FrozenKeys.data();
+        size_t   count = m_Keys.size();
+        size_t   k     = 1;
+
+        while (k <= count) {
+            detail::prefetch(reinterpret_cast<const void*>(reinterpret_cast<uintptr_t>(keys) + k * k_PrefetchStride * sizeof(K)));
+
+            k = 2 * k + static_cast<size_t>(m_Compare(keys[k], key));
+        }
+
+        // the path went right after the lower bound, and left at every step since (or it was
+        // never reached, which leaves 0); undo those steps
+        k >>= detail::countTrailingOnes(k) + 1;
+
+        return k;
+    }
+
+    template <typename K, typename V, typename C>
+    size_t FlatMap<K, V, C>::buildFrozen(size_t sortedIndex, size_t position) {
+        // an in-order traversal of the implicit tree visits the keys in sorted order
+        if (position <= m_Keys.size()) {
+            sortedIndex = buildFrozen(sortedIndex, 2 * position);
+
+            m_FrozenKeys[position]    = m_Keys[sortedIndex];
+            m_FrozenIndices[position] = static_cast<uint32_t>(sortedIndex);
+            ++sortedIndex;
+
+            sortedIndex = buildFrozen(sortedIndex, 2 * position + 1);
+        }
+
+        return sortedIndex;
+    }
+
+    template <typename K, typename V, typename C>
+    void FlatMap<K, V, C>::mergeSorted(std::vector<K>&& keys, std::vector<V>&& values, eDuplicatePolicy policy) {
+        if (keys.empty())
+            return;
+
+        unfreeze();
+
+        if (m_Keys.empty()) {
+            m_Keys   = std::move(keys);
+            m_Values = std::move(values);
+            return;
+        }
+
+        std::vector<K> mergedKeys;
+        std::vector<V> mergedValues;
+
+        mergedKeys.reserve(m_Keys.size() + keys.size());
+        mergedValues.reserve(m_Values.size() + values.size());
+
+        size_t i = 0;  // existing entries
+        size_t j = 0;  // new entries
+
+        while ((i < m_Keys.size()) && (j < keys.size())) {
+            if (m_Compare(m_Keys[i], keys[j])) {
+                mergedKeys.push_back(std::move(m_Keys[i]));
+                mergedValues.push_back(std::move(m_Values[i]));
+                ++i;
+            }
+            else if (m_Compare(keys[j], m_Keys[i])) {
+                mergedKeys.push_back(std::move(keys[j]));
+                mergedValues.push_back(std::move(values[j]));
+                ++j;
+            }
+            else {
+                // same key in both
+                mergedKeys.push_back(std::move(m_Keys[i]));
+
+                if (policy == eDuplicatePolicy::KEEP_FIRST)
+                    mergedValues.push_back(std::move(m_Values[i]));
+                else
+                    mergedValues.push_back(std::move(values[j]));
+
+                ++i;
+                ++j;
+            }
+        }
+
+        for (; i < m_Keys.size(); ++i) {
+            mergedKeys.push_back(std::move(m_Keys[i]));
+            mergedValues.push_back(std::move(m_Values[i]));
+        }
+
+        for (; j < keys.size(); ++j) {
+            mergedKeys.push_back(std::move(keys[j]));
+            mergedValues.push_back(std::move(values[j]));
+        }
+
+        m_Keys   = std::move(mergedKeys);
+        m_Values = std::move(mergedValues);
+    }
+
+    template <typename K, typename V, typename C>
+    std::ostream& operator<<(std::ostream& os, const FlatMap<K, V, C>& fm) {
         os << "[FlatMap]:\n";
 
         fm.foreach (
@@ -0,0 +1,118 @@
+#include "frame_arena.h"
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
+namespace djinn::util {
+    FrameArena::FrameArena(size_t capacity, size_t numBuffers, std::pmr::memory_resource* upstream):
+        m_Capacity(capacity),
+        m_Buffers(numBuffers),
+        m_Upstream(upstream) {
+        if (numBuffers == 0)
+            throw std::runtime_error("FrameArena requires at least one buffer");
+
+        if (!upstream)
+            throw std::runtime_error("FrameArena requires an upstream memory resource");
+
+        for (auto& buffer : m_Buffers)
+            buffer.m_Memory = std::make_unique<std::byte[]>(capacity);
+    }
+
+    FrameArena::~FrameArena() {
+        for (auto& buffer : m_Buffers)
+            release(buffer);
+    }
+
+    void FrameArena::nextFrame() {
+#ifndef NDEBUG
+        if (m_ResetThread == std::thread::id())
+            m_ResetThread = std::this_thread::get_id();
+
+        assert(m_ResetThread == std::this_thread::get_id() && "FrameArena::nextFrame() called from multiple threads");
+#endif
+
+        size_t current = m_Current.load(std::memory_order_relaxed);
+
+        {
+            const auto& buffer = m_Buffers[current];
+            size_t      used   = std::min(buffer.m_Offset.load(), m_Capacity) + buffer.m_OverflowBytes;
+
+            m_PeakBytesUsed = std::max(m_PeakBytesUsed, used);
+        }
+
+        size_t next = (current + 1) % m_Buffers.size();
+
+        // [NOTE] the buffer is reset before it is published, allocations that see the new index
+        //        also see the reset offset
+        release(m_Buffers[next]);
+        m_Current.store(next, std::memory_order_release);
+    }
+
+    size_t FrameArena::getCapacity() const {
+        return m_Capacity;
+    }
+
+    size_t FrameArena::getNumBuffers() const {
+        return m_Buffers.size();
+    }
+
+    size_t FrameArena::getBytesUsed() const {
+        return std::min(m_Buffers[m_Current.load(std::memory_order_acquire)].m_Offset.load(), m_Capacity);
+    }
+
+    size_t FrameArena::getPeakBytesUsed() const {
+        return m_PeakBytesUsed;
+    }
+
+    size_t FrameArena::getNumOverflows() const {
+        return m_NumOverflows;
+    }
+
+    void* FrameArena::do_allocate(size_t bytes, size_t alignment) {
+        auto& buffer = m_Buffers[m_Current.load(std::memory_order_acquire)];
+        auto  base   = reinterpret_cast<uintptr_t>(buffer.m_Memory.get());
+
+        size_t offset = buffer.m_Offset.load(std::memory_order_relaxed);
+
+        for (;;) {
+            // align the actual address, not just the offset
+            size_t aligned = ((base + offset + alignment - 1) & ~(uintptr_t(alignment) - 1)) - base;
+
+            if ((aligned + bytes > m_Capacity) || (aligned + bytes < aligned))
+                return allocateOverflow(buffer, bytes, alignment);
+
+            if (buffer.m_Offset.compare_exchange_weak(offset, aligned + bytes, std::memory_order_relaxed))
+                return buffer.m_Memory.get() + aligned;
+        }
+    }
+
+    void FrameArena::do_deallocate(void*, size_t, size_t) {
+        // memory is reclaimed all at once in nextFrame()
+    }
+
+    bool FrameArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+        return this == &other;
+    }
+
+    void FrameArena::release(Buffer& buffer) {
+        for (const auto& overflow : buffer.m_Overflow)
+            m_Upstream->deallocate(overflow.m_Ptr, overflow.m_Bytes, overflow.m_Alignment);
+
+        buffer.m_Overflow.clear();
+        buffer.m_OverflowBytes = 0;
+        buffer.m_Offset        = 0;
+    }
+
+    void* FrameArena::allocateOverflow(Buffer& buffer, size_t bytes, size_t alignment) {
+        std::lock_guard<std::mutex> guard(m_OverflowMutex);
+
+        void* result = m_Upstream->allocate(bytes, alignment);
+
+        buffer.m_Overflow.push_back({result, bytes, alignment});
+        buffer.m_OverflowBytes += bytes;
+        ++m_NumOverflows;
+
+        return result;
+    }
+}  // namespace djinn::util
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace djinn::util {
+    // Linear (bump) allocator for short-lived data, reset once per frame.
+    //
+    // The arena cycles through a number of equally sized buffers; memory allocated during a frame
+    // remains valid until the same buffer comes around again, so with the default of 2 buffers
+    // data from the previous frame can still be read. Deallocation is a no-op.
+    //
+    // When a buffer runs out, allocations fall back to the upstream resource; those are released
+    // when the buffer is reset, and counted so the capacity can be tuned.
+    //
+    // The arena is a std::pmr::memory_resource, so it can be used with std::pmr containers:
+    //
+    //     std::pmr::vector<int> v(&engine.getFrameArena());
+    //
+    // [NOTE] allocating is thread-safe (lock-free unless the buffer overflows), nextFrame() is not;
+    //        it should always be called by the same thread, while nothing is allocating (the
+    //        engine does so between frames). Debug builds check the former.
+    class FrameArena: public std::pmr::memory_resource {
+    public:
+        static constexpr size_t k_DefaultCapacity   = 4 * 1024 * 1024;  // bytes per buffer
+        static constexpr size_t k_DefaultNumBuffers = 2;
+
+        explicit FrameArena(
+            size_t                      capacity   = k_DefaultCapacity,
+            size_t                      numBuffers = k_DefaultNumBuffers,
+            std::pmr::memory_resource*  upstream   = std::pmr::new_delete_resource());
+        ~FrameArena();
+
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+        FrameArena(FrameArena&&)                 = delete;
+        FrameArena& operator=(FrameArena&&) = delete;
+
+        // switches to the next buffer, invalidating everything that was allocated from it
+        void nextFrame();
+
+        size_t getCapacity() const;
+        size_t getNumBuffers() const;
+        size_t getBytesUsed() const;      // in the current buffer
+        size_t getPeakBytesUsed() const;  // highest usage (including overflow) of any frame so far
+        size_t getNumOverflows() const;   // allocations that went to the upstream resource
+
+    protected:
+        void* do_allocate(size_t bytes, size_t alignment) override;
+        void  do_deallocate(void* ptr, size_t bytes, size_t alignment) override;
+        bool  do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    private:
+        struct Overflow {
+            void*  m_Ptr;
+            size_t m_Bytes;
+            size_t m_Alignment;
+        };
+
+        struct Buffer {
+            std::unique_ptr<std::byte[]> m_Memory;
+            std::atomic<size_t>          m_Offset = 0;
+            std::vector<Overflow>        m_Overflow;
+            size_t                       m_OverflowBytes = 0;
+        };
+
+        void  release(Buffer& buffer);
+        void* allocateOverflow(Buffer& buffer, size_t bytes, size_t alignment);
+
+        size_t                     m_Capacity;
+        std::vector<Buffer>        m_Buffers;
+        std::atomic<size_t>        m_Current = 0;  // only written by nextFrame()
+        std::pmr::memory_resource* m_Upstream;
+        std::thread::id            m_ResetThread;  // the thread that calls nextFrame() (debug only)
+
+        std::mutex          m_OverflowMutex;
+        std::atomic<size_t> m_NumOverflows = 0;
+        size_t              m_PeakBytesUsed = 0;
+    };
+}  // namespace djinn::util
@@ -0,0 +1,48 @@
+#include "grace_period.h"
+
+namespace djinn::util {
+    GracePeriod::ReadGuard::ReadGuard(GracePeriod& grace):
+        m_Grace(grace),
+        m_Group(grace.enter()) {}
+
+    GracePeriod::ReadGuard::~ReadGuard() {
+        m_Grace.leave(m_Group);
+    }
+
+    void GracePeriod::wait() {
+        std::lock_guard<std::mutex> writer(m_WriterMutex);
+
+        for (int phase = 0; phase < 2; ++phase) {
+            uint32_t previous = m_Epoch.fetch_add(1) & 1;
+
+            std::unique_lock<std::mutex> lock(m_WaitMutex);
+
+            m_IsWaiting = true;
+            m_Condition.wait(lock, [this, previous] { return m_Readers[previous].load() == 0; });
+            m_IsWaiting = false;
+        }
+    }
+
+    uint32_t GracePeriod::getNumReaders() const {
+        return m_Readers[0].load() + m_Readers[1].load();
+    }
+
+    uint32_t GracePeriod::enter() {
+        uint32_t group = m_Epoch.load() & 1;
+
+        // [NOTE] sequentially consistent, so whatever the reader loads after this is at least
+        //        as recent as what was published before a wait() that missed this reader
+        m_Readers[group].fetch_add(1);
+
+        return group;
+    }
+
+    void GracePeriod::leave(uint32_t group) {
+        // the writer holds m_WaitMutex between checking the count and going to sleep,
+        // so taking it here ensures the notification can't get lost
+        if ((m_Readers[group].fetch_sub(1) == 1) && m_IsWaiting) {
+            std::lock_guard<std::mutex> guard(m_WaitMutex);
+            m_Condition.notify_all();
+        }
+    }
+}  // namespace djinn::util
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+namespace djinn::util {
+    // Lets a writer wait until every reader that may still be using an old version of some
+    // shared data has finished (a grace period, in RCU terms).
+    //
+    // Readers announce themselves with read(), which only touches a counter; they never block.
+    // The writer publishes the new version first and then calls wait(). Readers are counted in
+    // two groups, and every wait() switches new readers to the other group before waiting for
+    // the previous one to drain. Doing that twice covers readers that picked a group just before
+    // it was switched; any reader that isn't waited for is guaranteed to see the new version.
+    //
+    // [NOTE] wait() blocks (it doesn't spin), but it can't return while a reader is stuck, so a
+    //        reader must never wait for the thread that is calling wait()
+    // [NOTE] calling wait() from within a read section deadlocks
+    class GracePeriod {
+    public:
+        class ReadGuard {
+        public:
+            explicit ReadGuard(GracePeriod& grace);
+            ~ReadGuard();
+
+            ReadGuard(const ReadGuard&) = delete;
+            ReadGuard& operator=(const ReadGuard&) = delete;
+            ReadGuard(ReadGuard&&)                 = delete;
+            ReadGuard& operator=(ReadGuard&&) = delete;
+
+        private:
+            GracePeriod& m_Grace;
+            uint32_t     m_Group;
+        };
+
+        GracePeriod() = default;
+
+        GracePeriod(const GracePeriod&) = delete;
+        GracePeriod& operator=(const GracePeriod&) = delete;
+        GracePeriod(GracePeriod&&)                 = delete;
+        GracePeriod& operator=(GracePeriod&&) = delete;
+
+        void wait();  // returns once all readers that started before this call have finished
+
+        uint32_t getNumReaders() const;
+
+    private:
+        uint32_t enter();
+        void     leave(uint32_t group);
+
+        std::atomic<uint32_t> m_Epoch      = 0;  // the lowest bit selects the group for new readers
+        std::atomic<uint32_t> m_Readers[2] = {0, 0};
+        std::atomic_bool      m_IsWaiting  = false;
+
+        std::mutex              m_WriterMutex;  // serializes wait()
+        std::mutex              m_WaitMutex;
+        std::condition_variable m_Condition;
+    };
+}  // namespace djinn::util
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+namespace djinn::util {
+    // Move-only replacement for std::function that stores the callable inline when it fits
+    // (and can be moved without throwing), so small lambdas never allocate. Larger callables
+    // fall back to the heap.
+    //
+    // [NOTE] not copyable, so it can hold move-only captures as well
+    template <typename Signature, size_t Capacity = 64>
+    class InplaceFunction;
+
+    template <typename R, typename... tArgs, size_t Capacity>
+    class InplaceFunction<R(tArgs...), Capacity> {
+    public:
+        InplaceFunction() = default;
+
+        template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, InplaceFunction>>>
+        InplaceFunction(F&& fn);
+
+        ~InplaceFunction();
+
+        InplaceFunction(const InplaceFunction&) = delete;
+        InplaceFunction& operator=(const InplaceFunction&) = delete;
+        InplaceFunction(InplaceFunction&& other) noexcept;
+        InplaceFunction& operator=(InplaceFunction&& other) noexcept;
+
+        R operator()(tArgs... args);
+
+        explicit operator bool() const;
+        bool     isInline() const;  // false if the callable was too large and lives on the heap
+
+        template <typename F>
+        static constexpr bool k_FitsInline = (sizeof(F) <= Capacity) && (alignof(F) <= alignof(std::max_align_t)) &&
+                                             std::is_nothrow_move_constructible_v<F>;
+
+    private:
+        struct Operations {
+            R (*m_Invoke)(void* storage, tArgs&&... args);
+            void (*m_Move)(void* from, void* to);  // move-constructs and destroys the source
+            void (*m_Destroy)(void* storage);
+            bool m_IsInline;
+        };
+
+        template <typename F>
+        static const Operations* getOperations();
+
+        void reset();
+
+        alignas(std::max_align_t) unsigned char m_Storage[Capacity];
+        const Operations* m_Operations = nullptr;
+    };
+}  // namespace djinn::util
+
+#include "inplace_function.inl"
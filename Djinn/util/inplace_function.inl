@@ -0,0 +1,110 @@
+#pragma once
+
+#include "inplace_function.h"
+
+#include <cassert>
+#include <new>
+#include <utility>
+
+namespace djinn::util {
+    template <typename R, typename... tArgs, size_t Capacity>
+    template <typename F, typename>
+    InplaceFunction<R(tArgs...), Capacity>::InplaceFunction(F&& fn) {
+        using Callable = std::decay_t<F>;
+
+        if constexpr (k_FitsInline<Callable>)
+            new (m_Storage) Callable(std::forward<F>(fn));
+        else
+            new (m_Storage) Callable*(new Callable(std::forward<F>(fn)));
+
+        m_Operations = getOperations<Callable>();
+    }
+
+    template <typename R, typename... tArgs, size_t Capacity>
+    InplaceFunction<R(tArgs...), Capacity>::~InplaceFunction() {
+        reset();
+    }
+
+    template <typename R, typename... tArgs, size_t Capacity>
+    InplaceFunction<R(tArgs...), Capacity>::InplaceFunction(InplaceFunction&& other) noexcept {
+        if (other.m_Operations) {
+            other.m_Operations->m_Move(other.m_Storage, m_Storage);
+
+            m_Operations       = other.m_Operations;
+            other.m_Operations = nullptr;
+        }
+    }
+
+    template <typename R, typename... tArgs, size_t Capacity>
+    InplaceFunction<R(tArgs...), Capacity>& InplaceFunction<R(tArgs...), Capacity>::operator=(InplaceFunction&& other) noexcept {
+        if (this != &other) {
+            reset();
+
+            if (other.m_Operations) {
+                other.m_Operations->m_Move(other.m_Storage, m_Storage);
+
+                m_Operations       = other.m_Operations;
+                other.m_Operations = nullptr;
+            }
+        }
+
+        return *this;
+    }
+
+    template <typename R, typename... tArgs, size_t Capacity>
+    R InplaceFunction<R(tArgs...), Capacity>::operator()(tArgs... args) {
+        assert(m_Operations);
+        return m_Operations->m_Invoke(m_Storage, std::forward<tArgs>(args)...);
+    }
+
+    template <typename R, typename... tArgs, size_t Capacity>
+    InplaceFunction<R(tArgs...), Capacity>::operator bool() const {
+        return m_Operations != nullptr;
+    }
+
+    template <typename R, typename... tArgs, size_t Capacity>
+    bool InplaceFunction<R(tArgs...), Capacity>::isInline() const {
+        return m_Operations && m_Operations->m_IsInline;
+    }
+
+    template <typename R, typename... tArgs, size_t Capacity>
+    template <typename F>
+    const typename InplaceFunction<R(tArgs...), Capacity>::Operations* InplaceFunction<R(tArgs...), Capacity>::getOperations() {
+        if constexpr (k_FitsInline<F>) {
+            static const Operations result = {
+                [](void* storage, tArgs&&... args) -> R {
+                    return (*std::launder(static_cast<F*>(storage)))(std::forward<tArgs>(args)...);
+                },
+                [](void* from, void* to) {
+                    auto* source = std::launder(static_cast<F*>(from));
+
+                    new (to) F(std::move(*source));
+                    source->~F();
+                },
+                [](void* storage) { std::launder(static_cast<F*>(storage))->~F(); },
+                true};
+
+            return &result;
+        }
+        else {
+            // the storage only holds a pointer
+            static const Operations result = {
+                [](void* storage, tArgs&&... args) -> R {
+                    return (**static_cast<F**>(storage))(std::forward<tArgs>(args)...);
+                },
+                [](void* from, void* to) { new (to) F*(*static_cast<F**>(from)); },
+                [](void* storage) { delete *static_cast<F**>(storage); },
+                false};
+
+            return &result;
+        }
+    }
+
+    template <typename R, typename... tArgs, size_t Capacity>
+    void InplaceFunction<R(tArgs...), Capacity>::reset() {
+        if (m_Operations) {
+            m_Operations->m_Destroy(m_Storage);
+            m_Operations = nullptr;
+        }
+    }
+}  // namespace djinn::util
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "compile_options.h"
+
+#include <atomic>
+#include <chrono>
+
+namespace djinn::util {
+    // DJINN_PROFILE_ZONE without any further dependencies, so util can be instrumented as well.
+    //
+    // The zones are recorded by core::ZoneCollector (see core/profile_zone.h), which also
+    // implements the declarations in detail.
+    namespace detail {
+        extern std::atomic_bool g_ZoneRecording;  // mirrors ZoneCollector::isEnabled()
+
+        void recordZone(
+            const char*                           name,
+            std::chrono::steady_clock::time_point begin,
+            std::chrono::steady_clock::time_point end);
+    }  // namespace detail
+
+    // RAII timing of a scope
+    class ProfileZone {
+    public:
+        explicit ProfileZone(const char* name);
+        ~ProfileZone();
+
+        ProfileZone(const ProfileZone&) = delete;
+        ProfileZone& operator=(const ProfileZone&) = delete;
+        ProfileZone(ProfileZone&&)                 = delete;
+        ProfileZone& operator=(ProfileZone&&) = delete;
+
+    private:
+        const char*                           m_Name;  // nullptr if recording was disabled on construction
+        std::chrono::steady_clock::time_point m_Begin;
+    };
+}  // namespace djinn::util
+
+#define DJINN_PROFILE_CONCAT_IMPL(a, b) a##b
+#define DJINN_PROFILE_CONCAT(a, b) DJINN_PROFILE_CONCAT_IMPL(a, b)
+
+#if DJINN_PROFILING
+#define DJINN_PROFILE_ZONE(name)                                                                   \
+    ::djinn::util::ProfileZone DJINN_PROFILE_CONCAT(djinn_profile_zone_, __LINE__)(name)
+#define DJINN_PROFILE_FUNCTION() DJINN_PROFILE_ZONE(__func__)
+#else
+#define DJINN_PROFILE_ZONE(name) ((void)0)
+#define DJINN_PROFILE_FUNCTION() ((void)0)
+#endif
+
+#include "profile_zone_macro.inl"
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "profile_zone_macro.h"
+
+namespace djinn::util {
+    inline ProfileZone::ProfileZone(const char* name):
+        m_Name(detail::g_ZoneRecording.load(std::memory_order_relaxed) ? name : nullptr) {
+        if (m_Name)
+            m_Begin = std::chrono::steady_clock::now();
+    }
+
+    inline ProfileZone::~ProfileZone() {
+        if (m_Name)
+            detail::recordZone(m_Name, m_Begin, std::chrono::steady_clock::now());
+    }
+}  // namespace djinn::util
@@ -1,7 +1,9 @@
 #include "string_util.h"
+#include "profile_zone_macro.h"
 #include <algorithm>
+#include <cctype>
+#include <cstring>
 #include <functional>
-#include <locale>
 
 namespace djinn::util {
     std::string concat(const std::vector<std::string>& parts, const std::string& separator) {
@@ -36,26 +38,45 @@ namespace djinn::util {
         return result;
     }
 
+    namespace {
+        // calls fn(first, last) for every non-empty substring between separators
+        template <typename Fn>
+        void tokenize(const std::string& source, const char separator, Fn&& fn) {
+            size_t cursor;
+            size_t last_position = 0;
+            size_t len           = source.length();
+
+            while (last_position < len + 1) {
+                cursor = source.find(separator, last_position);
+
+                if (cursor == std::string::npos)
+                    cursor = len;
+
+                if (cursor != last_position)
+                    fn(source.begin() + last_position, source.begin() + cursor);
+
+                last_position = cursor + 1;
+            }
+        }
+    }  // namespace
+
     std::vector<std::string> split(const std::string& source, const char separator) {
-        using namespace std;
+        DJINN_PROFILE_ZONE("util::split");
 
-        vector<string> result;
+        std::vector<std::string> result;
 
-        size_t cursor;
-        size_t last_position = 0;
-        size_t len           = source.length();
+        tokenize(source, separator, [&](auto first, auto last) { result.emplace_back(first, last); });
 
-        while (last_position < len + 1) {
-            cursor = source.find(separator, last_position);
+        return result;
+    }
 
-            if (cursor == string::npos)
-                cursor = len;
+    std::pmr::vector<std::pmr::string>
+        split(const std::string& source, const char separator, std::pmr::memory_resource* resource) {
+        DJINN_PROFILE_ZONE("util::split (pmr)");
 
-            if (cursor != last_position)
-                result.push_back(string(source.begin() + last_position, source.begin() + cursor));
+        std::pmr::vector<std::pmr::string> result(resource);
 
-            last_position = cursor + 1;
-        }
+        tokenize(source, separator, [&](auto first, auto last) { result.emplace_back(first, last); });
 
         return result;
     }
@@ -63,6 +84,8 @@ namespace djinn::util {
     std::vector<std::string> split(const std::string& source, const std::string& delimiter) {
         using namespace std;
 
+        DJINN_PROFILE_ZONE("util::split");
+
         if (delimiter.size() == 0)
             return {source};
 
@@ -99,6 +122,8 @@ namespace djinn::util {
         split(const std::string& source, const std::vector<std::string>& delimiters) {
         using namespace std;
 
+        DJINN_PROFILE_ZONE("util::split");
+
         if (delimiters.empty())
             return {source};
 
@@ -147,7 +172,7 @@ namespace djinn::util {
         std::string result = s;
 
         std::transform(result.begin(), result.end(), result.begin(), [](unsigned char c) {
-            return std::toupper(c, std::locale());
+            return static_cast<char>(std::toupper(c));
         });
 
         return result;
@@ -157,7 +182,7 @@ namespace djinn::util {
         std::string result = s;
 
         std::transform(result.begin(), result.end(), result.begin(), [](unsigned char c) {
-            return std::tolower(c, std::locale());
+            return static_cast<char>(std::tolower(c));
         });
 
         return result;
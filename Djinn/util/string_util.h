@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory_resource>
 #include <string>
 #include <vector>
 
@@ -19,6 +20,10 @@ namespace djinn::util {
     // strings is complex [NOTE] there are even more variations to specify splitting; add as required...
     std::vector<std::string> split(const std::string& source, const char separator = '\n');
 
+    // same as above, but allocates from the given resource (typically the engine's frame arena)
+    std::pmr::vector<std::pmr::string>
+        split(const std::string& source, const char separator, std::pmr::memory_resource* resource);
+
     // [NOTE] this is currently using boyer-moore-horspool, alternatives are certainly possible
     std::vector<std::string> split(const std::string& source, const std::string& separator = "\n");
 
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace djinn::bench {
+    // Minimal '--key value' command line parsing; a flag without a value is stored as "1"
+    class Arguments {
+    public:
+        Arguments(int argc, char* argv[]);
+
+        const std::string& getCommand() const;  // first positional argument
+        bool               has(const std::string& key) const;
+
+        template <typename T>
+        T get(const std::string& key, T defaultValue) const;
+
+    private:
+        std::string                                  m_Command;
+        std::unordered_map<std::string, std::string> m_Values;
+    };
+
+    // each of these returns the process exit code
+    int runFrameLoop(const Arguments& args);
+    int runDelegate(const Arguments& args);
+    int runFlatMap(const Arguments& args);
+}  // namespace djinn::bench
+
+#include "bench.inl"
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "bench.h"
+
+namespace djinn::bench {
+    template <typename T>
+    T Arguments::get(const std::string& key, T defaultValue) const {
+        auto it = m_Values.find(key);
+
+        if (it == m_Values.end())
+            return defaultValue;
+
+        std::stringstream sstr(it->second);
+
+        T result;
+        if (!(sstr >> result))
+            return defaultValue;
+
+        return result;
+    }
+
+    template <>
+    inline std::string Arguments::get(const std::string& key, std::string defaultValue) const {
+        auto it = m_Values.find(key);
+
+        if (it == m_Values.end())
+            return defaultValue;
+
+        return it->second;
+    }
+}  // namespace djinn::bench
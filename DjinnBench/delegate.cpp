@@ -0,0 +1,139 @@
+#include "bench.h"
+
+#include "core/mediator.h"
+#include "util/delegate.h"
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Compares the cost of delivering a message to a number of handlers:
+//   legacy     - the previous MediatorQueue: lock, copy a vector of std::function, call each
+//   function   - a plain loop over a vector of std::function (no lock, no copy)
+//   delegate   - a plain loop over a vector of util::Delegate
+//   broadcast  - djinn::broadcast
+//   post       - djinn::post, with a dispatch every 1000 messages
+
+namespace djinn::bench {
+    namespace {
+        struct DelegateMessage {
+            int m_Value;
+        };
+
+        struct Counter {
+            void operator()(const DelegateMessage& msg) {
+                m_Total += msg.m_Value;
+            }
+
+            int64_t m_Total = 0;
+        };
+
+        class LegacyQueue {
+        public:
+            void add(Counter* c) {
+                std::lock_guard<std::mutex> guard(m_Mutex);
+                m_Handlers.push_back([c](const DelegateMessage& msg) { (*c)(msg); });
+            }
+
+            void broadcast(const DelegateMessage& msg) {
+                std::vector<std::function<void(const DelegateMessage&)>> localCopy;
+
+                {
+                    std::lock_guard<std::mutex> guard(m_Mutex);
+                    localCopy = m_Handlers;
+                }
+
+                for (const auto& handler : localCopy)
+                    handler(msg);
+            }
+
+        private:
+            std::mutex                                                m_Mutex;
+            std::vector<std::function<void(const DelegateMessage&)>> m_Handlers;
+        };
+
+        template <typename Fn>
+        double measure(size_t numMessages, Fn&& fn) {
+            using Clock = std::chrono::steady_clock;
+
+            auto start = Clock::now();
+
+            for (size_t i = 0; i < numMessages; ++i)
+                fn(DelegateMessage{static_cast<int>(i & 0xFF)});
+
+            return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / numMessages;
+        }
+    }  // namespace
+
+    int runDelegate(const Arguments& args) {
+        auto numMessages = args.get<size_t>("messages", 1000000);
+
+        std::cout << "ns per message (" << numMessages << " messages)\n";
+        std::cout << std::setw(10) << "handlers" << std::setw(12) << "legacy" << std::setw(12) << "function"
+                  << std::setw(12) << "delegate" << std::setw(12) << "broadcast" << std::setw(12) << "post"
+                  << "\n";
+
+        int64_t checksum = 0;
+
+        for (size_t numHandlers : {1, 4, 16, 64}) {
+            std::vector<Counter> counters(numHandlers);
+
+            LegacyQueue legacy;
+            for (auto& c : counters)
+                legacy.add(&c);
+
+            std::vector<std::function<void(const DelegateMessage&)>> functions;
+            for (auto& c : counters)
+                functions.push_back([&c](const DelegateMessage& msg) { c(msg); });
+
+            using Handler = util::Delegate<void(const DelegateMessage&)>;
+
+            std::vector<Handler> delegates;
+            for (auto& c : counters)
+                delegates.push_back(Handler::bind(&c));
+
+            for (auto& c : counters)
+                add_handler<DelegateMessage>(&c);
+
+            double tLegacy = measure(numMessages, [&](const DelegateMessage& msg) { legacy.broadcast(msg); });
+
+            double tFunction = measure(numMessages, [&](const DelegateMessage& msg) {
+                for (const auto& fn : functions)
+                    fn(msg);
+            });
+
+            double tDelegate = measure(numMessages, [&](const DelegateMessage& msg) {
+                for (const auto& d : delegates)
+                    d(msg);
+            });
+
+            double tBroadcast = measure(numMessages, [](const DelegateMessage& msg) { broadcast(msg); });
+
+            size_t numPosted = 0;
+            double tPost     = measure(numMessages, [&](const DelegateMessage& msg) {
+                post(msg);
+
+                if (++numPosted % 1000 == 0)
+                    dispatch<DelegateMessage>();
+            });
+            dispatch<DelegateMessage>();
+
+            for (auto& c : counters) {
+                remove_handler<DelegateMessage>(&c);
+                checksum += c.m_Total;
+            }
+
+            std::cout << std::fixed << std::setprecision(2) << std::setw(10) << numHandlers << std::setw(12)
+                      << tLegacy << std::setw(12) << tFunction << std::setw(12) << tDelegate << std::setw(12)
+                      << tBroadcast << std::setw(12) << tPost << "\n";
+        }
+
+        std::cout << "(checksum " << checksum << ")\n";
+
+        return 0;
+    }
+}  // namespace djinn::bench
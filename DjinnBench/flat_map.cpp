@@ -0,0 +1,94 @@
+#include "bench.h"
+
+#include "util/flat_map.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// Compares FlatMap lookups over a range of sizes:
+//   lower_bound - std::lower_bound on the sorted keys (what FlatMap used for every lookup)
+//   flatmap     - FlatMap as is; small maps are searched linearly
+//   frozen      - FlatMap after freeze()
+//
+// The keys are the even numbers, about half of the lookups miss.
+
+namespace djinn::bench {
+    namespace {
+        template <typename Fn>
+        double measure(const std::vector<uint32_t>& lookups, Fn&& fn) {
+            using Clock = std::chrono::steady_clock;
+
+            auto start = Clock::now();
+
+            for (auto key : lookups)
+                fn(key);
+
+            return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / lookups.size();
+        }
+    }  // namespace
+
+    int runFlatMap(const Arguments& args) {
+        auto maxSize    = args.get<size_t>("max", 10000000);
+        auto numLookups = args.get<size_t>("lookups", 1000000);
+
+        std::cout << "ns per lookup (" << numLookups << " lookups)\n";
+        std::cout << std::setw(10) << "size" << std::setw(14) << "lower_bound" << std::setw(12) << "flatmap"
+                  << std::setw(12) << "frozen"
+                  << "\n";
+
+        std::mt19937 rng(1234);
+        uint64_t     checksum = 0;
+
+        for (size_t size : {8, 64, 512, 4096, 32768, 262144, 2097152, 10000000}) {
+            if (size > maxSize)
+                break;
+
+            std::vector<std::pair<uint32_t, uint32_t>> entries(size);
+
+            for (size_t i = 0; i < size; ++i)
+                entries[i] = {static_cast<uint32_t>(i * 2), static_cast<uint32_t>(i)};
+
+            util::FlatMap<uint32_t, uint32_t> fm(entries.begin(), entries.end());
+
+            std::uniform_int_distribution<uint32_t> dist(0, static_cast<uint32_t>(size * 2 - 1));
+            std::vector<uint32_t>                   lookups(numLookups);
+
+            for (auto& key : lookups)
+                key = dist(rng);
+
+            const auto& keys   = fm.getKeys();
+            const auto& values = fm.getValues();
+
+            double tLowerBound = measure(lookups, [&](uint32_t key) {
+                auto it = std::lower_bound(keys.begin(), keys.end(), key);
+
+                if ((it != keys.end()) && (*it == key))
+                    checksum += values[it - keys.begin()];
+            });
+
+            double tFlatMap = measure(lookups, [&](uint32_t key) {
+                if (auto value = fm[key])
+                    checksum += *value;
+            });
+
+            fm.freeze();
+
+            double tFrozen = measure(lookups, [&](uint32_t key) {
+                if (auto value = fm[key])
+                    checksum += *value;
+            });
+
+            std::cout << std::fixed << std::setprecision(2) << std::setw(10) << size << std::setw(14) << tLowerBound
+                      << std::setw(12) << tFlatMap << std::setw(12) << tFrozen << "\n";
+        }
+
+        std::cout << "(checksum " << checksum << ")\n";
+
+        return 0;
+    }
+}  // namespace djinn::bench
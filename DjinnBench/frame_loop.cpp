@@ -0,0 +1,217 @@
+#include "bench.h"
+#include "histogram.h"
+
+#include "core/engine.h"
+
+#if DJINN_VULKAN && (DJINN_PLATFORM == DJINN_PLATFORM_WINDOWS)
+#include "graphics/graphics.h"
+#endif
+
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <utility>
+
+// Runs the engine main loop for a fixed number of frames, with a configurable set of systems
+// that just burn cpu time; the per-frame durations are collected in a histogram.
+//
+// The systems are arranged in layers, each system depending on (up to) two systems of the
+// previous layer, so the scheduler has something to work with.
+
+namespace djinn::bench {
+    namespace {
+        constexpr size_t k_MaxSystems = 64;
+
+        struct Workload {
+            size_t m_NumSystems = 16;
+            size_t m_NumLayers  = 4;
+            double m_Work       = 200.0;  // microseconds
+            double m_Jitter     = 10.0;   // percent
+            double m_FixedWork  = 0.0;    // microseconds
+        };
+
+        void burn(double microseconds) {
+            using Clock = std::chrono::steady_clock;
+
+            auto deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(
+                                               std::chrono::duration<double, std::micro>(microseconds));
+
+            while (Clock::now() < deadline)
+                ;
+        }
+
+        std::string syntheticName(size_t index) {
+            return "Synthetic" + std::to_string(index);
+        }
+
+        // the engine allows just one system per type, hence the template
+        template <size_t N>
+        class SyntheticSystem: public core::System {
+        public:
+            explicit SyntheticSystem(const Workload& workload):
+                System(syntheticName(N)),
+                m_Workload(workload),
+                m_Random(static_cast<unsigned>(N)) {
+                size_t perLayer = std::max<size_t>(workload.m_NumSystems / std::max<size_t>(workload.m_NumLayers, 1), 1);
+
+                if (N >= perLayer) {
+                    addDependency(syntheticName(N - perLayer));
+
+                    if ((N % perLayer) + 1 < perLayer)
+                        addDependency(syntheticName(N - perLayer + 1));
+                }
+            }
+
+            void update() override {
+                std::uniform_real_distribution<double> variation(-m_Workload.m_Jitter, m_Workload.m_Jitter);
+
+                burn(m_Workload.m_Work * (1.0 + variation(m_Random) / 100.0));
+            }
+
+            void fixedUpdate(double) override {
+                if (m_Workload.m_FixedWork > 0.0)
+                    burn(m_Workload.m_FixedWork);
+            }
+
+        private:
+            Workload     m_Workload;
+            std::mt19937 m_Random;
+        };
+
+        template <size_t... Is>
+        void enableSystems(Engine& engine, const Workload& workload, std::index_sequence<Is...>) {
+            ((Is < workload.m_NumSystems ? engine.enable<SyntheticSystem<Is>>(workload) : void()), ...);
+        }
+
+        class FrameLoopApp: public app::Application {
+        public:
+            FrameLoopApp(size_t numWarmup, size_t numFrames, Histogram* result):
+                Application("FrameLoopBench"),
+                m_NumWarmup(numWarmup),
+                m_NumFrames(numFrames),
+                m_Result(result) {
+                m_Result->reserve(numFrames);
+            }
+
+            void init() override {
+                System::init();
+            }
+
+            void update() override {
+                // the delta time covers the whole previous iteration of the main loop
+                if (m_Counter > m_NumWarmup)
+                    m_Result->add(std::chrono::duration<double>(m_Engine->getDeltaTime()));
+
+                if (++m_Counter > m_NumWarmup + m_NumFrames)
+                    m_Engine->stop();
+            }
+
+            void shutdown() override {
+                System::shutdown();
+            }
+
+        private:
+            size_t     m_NumWarmup;
+            size_t     m_NumFrames;
+            size_t     m_Counter = 0;
+            Histogram* m_Result;
+        };
+
+        // returns false if any of the percentiles is worse than the baseline by more than the tolerance
+        bool compareBaseline(const nlohmann::json& current, const nlohmann::json& baseline, double tolerance) {
+            bool result = true;
+
+            for (const char* key : {"p50", "p90", "p99"}) {
+                double before = baseline.value(key, 0.0);
+                double after  = current.value(key, 0.0);
+
+                if (before <= 0.0)
+                    continue;
+
+                double change = (after - before) / before * 100.0;
+
+                std::cout << key << ": " << before << "us -> " << after << "us (" << std::showpos << change
+                          << std::noshowpos << "%)\n";
+
+                if (change > tolerance)
+                    result = false;
+            }
+
+            return result;
+        }
+    }  // namespace
+
+    int runFrameLoop(const Arguments& args) {
+        Workload workload;
+
+        workload.m_NumSystems = std::min(args.get<size_t>("systems", workload.m_NumSystems), k_MaxSystems);
+        workload.m_NumLayers  = args.get<size_t>("layers", workload.m_NumLayers);
+        workload.m_Work       = args.get<double>("work", workload.m_Work);
+        workload.m_Jitter     = args.get<double>("jitter", workload.m_Jitter);
+        workload.m_FixedWork  = args.get<double>("fixed-work", workload.m_FixedWork);
+
+        auto numFrames = args.get<size_t>("frames", 1000);
+        auto numWarmup = args.get<size_t>("warmup", 60);
+
+        Histogram frameTimes;
+
+        auto& engine = Engine::instance();
+
+        engine.setHeadless(true);
+        engine.setSaveSettings(false);  // don't leave config files behind
+        engine.getFramePacer().setMode(core::FramePacer::eMode::UNLIMITED);
+
+        enableSystems(engine, workload, std::make_index_sequence<k_MaxSystems>());
+
+        if (args.has("graphics")) {
+#if DJINN_VULKAN && (DJINN_PLATFORM == DJINN_PLATFORM_WINDOWS)
+            engine.enable<Graphics>();
+#else
+            std::cout << "The Graphics system is not available on this platform, ignoring --graphics\n";
+#endif
+        }
+
+        engine.setApplication<FrameLoopApp>(numWarmup, numFrames, &frameTimes);
+        engine.run();
+
+        std::cout << "\nFrame times (" << workload.m_NumSystems << " systems, " << workload.m_NumLayers
+                  << " layers, " << workload.m_Work << "us work):\n"
+                  << frameTimes;
+
+        nlohmann::json results;
+
+        results["benchmark"]  = "frameloop";
+        results["systems"]    = workload.m_NumSystems;
+        results["layers"]     = workload.m_NumLayers;
+        results["work"]       = workload.m_Work;
+        results["jitter"]     = workload.m_Jitter;
+        results["fixed_work"] = workload.m_FixedWork;
+        results["frames"]     = frameTimes.toJson();
+
+        auto output = args.get<std::string>("output", "");
+        if (!output.empty()) {
+            std::ofstream out(output);
+            out << results.dump(4);
+        }
+
+        auto baselineFile = args.get<std::string>("baseline", "");
+        if (!baselineFile.empty()) {
+            std::ifstream in(baselineFile);
+
+            if (!in.good())
+                throw std::runtime_error("Failed to open baseline " + baselineFile);
+
+            nlohmann::json baseline;
+            in >> baseline;
+
+            std::cout << "\nCompared to " << baselineFile << ":\n";
+
+            if (!compareBaseline(results["frames"], baseline["frames"], args.get<double>("tolerance", 10.0))) {
+                std::cout << "Regression detected\n";
+                return 3;
+            }
+        }
+
+        return 0;
+    }
+}  // namespace djinn::bench
@@ -0,0 +1,128 @@
+#include "histogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <numeric>
+#include <ostream>
+#include <string>
+
+namespace djinn::bench {
+    void Histogram::reserve(size_t count) {
+        m_Samples.reserve(count);
+    }
+
+    void Histogram::add(Duration sample) {
+        m_Samples.push_back(sample.count());
+        m_Sorted = false;
+    }
+
+    size_t Histogram::getNumSamples() const {
+        return m_Samples.size();
+    }
+
+    double Histogram::getPercentile(double p) const {
+        if (m_Samples.empty())
+            return 0.0;
+
+        sort();
+
+        // nearest-rank
+        auto rank = static_cast<size_t>(std::ceil(p / 100.0 * m_Samples.size()));
+        rank      = std::clamp<size_t>(rank, 1, m_Samples.size());
+
+        return m_Samples[rank - 1];
+    }
+
+    double Histogram::getMean() const {
+        if (m_Samples.empty())
+            return 0.0;
+
+        return std::accumulate(m_Samples.begin(), m_Samples.end(), 0.0) / m_Samples.size();
+    }
+
+    double Histogram::getStdDev() const {
+        if (m_Samples.size() < 2)
+            return 0.0;
+
+        double mean  = getMean();
+        double total = 0.0;
+
+        for (auto x : m_Samples)
+            total += (x - mean) * (x - mean);
+
+        return std::sqrt(total / (m_Samples.size() - 1));
+    }
+
+    double Histogram::getMin() const {
+        return getPercentile(0.0);
+    }
+
+    double Histogram::getMax() const {
+        return getPercentile(100.0);
+    }
+
+    nlohmann::json Histogram::toJson() const {
+        nlohmann::json result;
+
+        result["samples"] = getNumSamples();
+        result["mean"]    = getMean();
+        result["stddev"]  = getStdDev();
+        result["min"]     = getMin();
+        result["p50"]     = getPercentile(50.0);
+        result["p90"]     = getPercentile(90.0);
+        result["p99"]     = getPercentile(99.0);
+        result["p999"]    = getPercentile(99.9);
+        result["max"]     = getMax();
+
+        return result;
+    }
+
+    void Histogram::sort() const {
+        if (!m_Sorted) {
+            std::sort(m_Samples.begin(), m_Samples.end());
+            m_Sorted = true;
+        }
+    }
+
+    std::ostream& operator<<(std::ostream& os, const Histogram& h) {
+        if (h.m_Samples.empty())
+            return os << "(no samples)\n";
+
+        h.sort();
+
+        os << std::fixed << std::setprecision(1);
+        os << "samples " << h.getNumSamples() << ", mean " << h.getMean() << "us, stddev "
+           << h.getStdDev() << "us\n";
+        os << "min " << h.getMin() << "  p50 " << h.getPercentile(50.0) << "  p90 "
+           << h.getPercentile(90.0) << "  p99 " << h.getPercentile(99.0) << "  p99.9 "
+           << h.getPercentile(99.9) << "  max " << h.getMax() << " (us)\n";
+
+        // bucket index = floor(log2(us) * k_BucketsPerOctave)
+        auto bucketOf = [](double us) {
+            return static_cast<int>(std::floor(std::log2(std::max(us, 1.0)) * Histogram::k_BucketsPerOctave));
+        };
+        auto lowerBound = [](int bucket) {
+            return std::pow(2.0, static_cast<double>(bucket) / Histogram::k_BucketsPerOctave);
+        };
+
+        int first = bucketOf(h.m_Samples.front());
+        int last  = bucketOf(h.m_Samples.back());
+
+        std::vector<size_t> counts(last - first + 1, 0);
+        for (auto x : h.m_Samples)
+            ++counts[bucketOf(x) - first];
+
+        size_t largest = *std::max_element(counts.begin(), counts.end());
+
+        for (int i = 0; i < static_cast<int>(counts.size()); ++i) {
+            auto bar = (counts[i] * 50 + largest - 1) / largest;
+
+            os << std::setw(10) << lowerBound(first + i) << " - " << std::setw(10)
+               << lowerBound(first + i + 1) << " us | " << std::setw(7) << counts[i] << " "
+               << std::string(bar, '#') << "\n";
+        }
+
+        return os;
+    }
+}  // namespace djinn::bench
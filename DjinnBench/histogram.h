@@ -0,0 +1,38 @@
+#pragma once
+
+#include "third_party.h"
+
+#include <chrono>
+#include <iosfwd>
+#include <vector>
+
+namespace djinn::bench {
+    // Collects durations and reports percentiles plus a log-scale histogram
+    // (4 buckets per power of 2, starting at 1 microsecond)
+    class Histogram {
+    public:
+        using Duration = std::chrono::duration<double, std::micro>;
+
+        void reserve(size_t count);
+        void add(Duration sample);
+
+        size_t getNumSamples() const;
+        double getPercentile(double p) const;  // in microseconds, p in [0, 100]
+        double getMean() const;
+        double getStdDev() const;
+        double getMin() const;
+        double getMax() const;
+
+        nlohmann::json toJson() const;
+
+        friend std::ostream& operator<<(std::ostream& os, const Histogram& h);
+
+    private:
+        static constexpr int k_BucketsPerOctave = 4;
+
+        void sort() const;
+
+        mutable std::vector<double> m_Samples;  // microseconds
+        mutable bool                m_Sorted = true;
+    };
+}  // namespace djinn::bench
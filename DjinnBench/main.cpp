@@ -0,0 +1,77 @@
+#include "bench.h"
+
+#include <iostream>
+
+using namespace djinn;
+
+namespace {
+    void printUsage() {
+        std::cout << "Usage: DjinnBench <benchmark> [--option value]...\n"
+                     "\n"
+                     "Benchmarks:\n"
+                     "  frameloop  runs the engine main loop headless with a synthetic workload\n"
+                     "             --frames N      number of measured frames (1000)\n"
+                     "             --warmup N      number of frames to discard first (60)\n"
+                     "             --systems N     number of synthetic systems, at most 64 (16)\n"
+                     "             --layers N      dependency depth of the systems (4)\n"
+                     "             --work US       busy time per system update, in microseconds (200)\n"
+                     "             --jitter PCT    random variation of the work, in percent (10)\n"
+                     "             --fixed-work US busy time per system fixed update (0)\n"
+                     "             --graphics      also enable the Graphics system (offscreen)\n"
+                     "             --output FILE   write the results as json\n"
+                     "             --baseline FILE compare against earlier json results\n"
+                     "             --tolerance PCT allowed regression against the baseline (10)\n"
+                     "  delegate   compares message delivery strategies\n"
+                     "             --messages N    number of messages per measurement (1000000)\n"
+                     "  flatmap    compares FlatMap lookup strategies for 8 up to 10M entries\n"
+                     "             --max N         largest map size to measure (10000000)\n"
+                     "             --lookups N     number of lookups per measurement (1000000)\n";
+    }
+}  // namespace
+
+namespace djinn::bench {
+    Arguments::Arguments(int argc, char* argv[]) {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+
+            if (arg.rfind("--", 0) == 0) {
+                std::string key = arg.substr(2);
+
+                if ((i + 1 < argc) && (std::string(argv[i + 1]).rfind("--", 0) != 0))
+                    m_Values[key] = argv[++i];
+                else
+                    m_Values[key] = "1";
+            }
+            else if (m_Command.empty())
+                m_Command = arg;
+        }
+    }
+
+    const std::string& Arguments::getCommand() const {
+        return m_Command;
+    }
+
+    bool Arguments::has(const std::string& key) const {
+        return m_Values.find(key) != m_Values.end();
+    }
+}  // namespace djinn::bench
+
+int main(int argc, char* argv[]) {
+    bench::Arguments args(argc, argv);
+
+    try {
+        if (args.getCommand() == "frameloop")
+            return bench::runFrameLoop(args);
+        if (args.getCommand() == "delegate")
+            return bench::runDelegate(args);
+        if (args.getCommand() == "flatmap")
+            return bench::runFlatMap(args);
+    }
+    catch (std::exception& ex) {
+        std::cerr << "Benchmark failed: " << ex.what() << "\n";
+        return 2;
+    }
+
+    printUsage();
+    return 1;
+}
@@ -0,0 +1,173 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "core/binary_log.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace DjinnTest {
+    namespace {
+        enum class eColor
+        {
+            RED,
+            GREEN
+        };
+
+        enum class eGrade: char
+        {
+            A = 'a',
+            B = 'b'
+        };
+
+        enum class eLarge: uint64_t
+        {
+            VALUE = 1ull << 40
+        };
+
+        std::vector<std::string> decode(const std::filesystem::path& path) {
+            std::ifstream     file(path, std::ios::binary);
+            std::stringstream output;
+
+            Assert::IsTrue(djinn::core::decodeBinaryLog(file, output));
+
+            std::vector<std::string> result;
+            std::string              line;
+
+            while (std::getline(output, line))
+                result.push_back(line);
+
+            return result;
+        }
+
+        bool contains(const std::string& line, const std::string& text) {
+            return line.find(text) != std::string::npos;
+        }
+    }  // namespace
+
+    TEST_CLASS(BinaryLog) {
+    public:
+        TEST_METHOD(round_trip) {
+            auto  path = std::filesystem::temp_directory_path() / "djinn_binary_log_test.bin";
+            auto& log  = djinn::core::BinaryLog::instance();
+
+            log.open(path);
+            Assert::IsTrue(log.isOpen());
+
+            std::string name = "djinn";
+
+            gLogBinary(WARNING, "values {} {} {} {} {} {}", true, 'x', -42, uint16_t(7), 2.5f, eColor::GREEN);
+            gLogBinary(WARNING, "strings {} {} {}", "literal", name, static_cast<const char*>(nullptr));
+            gLogBinary(WARNING, "extra", 1, 2);
+
+            log.close();
+
+            auto lines = decode(path);
+
+            Assert::IsTrue(lines.size() == 3);
+            Assert::IsTrue(contains(lines[0], "values true x -42 7 2.5 1 (binary_log.cpp:"));
+            Assert::IsTrue(contains(lines[1], "strings literal djinn (null)"));
+            Assert::IsTrue(contains(lines[2], "extra 1 2"));
+
+            // only the filename is stored, not the directories it was built in
+            std::ifstream file(path, std::ios::binary);
+            std::string   raw((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            file.close();
+
+            Assert::IsTrue(contains(raw, "binary_log.cpp"));
+            Assert::IsFalse(contains(raw, "core/binary_log.cpp") || contains(raw, "core\\binary_log.cpp"));
+
+            std::filesystem::remove(path);
+        }
+
+        TEST_METHOD(enum_arguments) {
+            auto  path = std::filesystem::temp_directory_path() / "djinn_binary_log_enums.bin";
+            auto& log  = djinn::core::BinaryLog::instance();
+
+            log.open(path);
+
+            // enums are stored as their underlying type, which may be smaller than 8 bytes
+            gLogBinary(WARNING, "enums {} {} {} {}", eGrade::B, 42, eColor::RED, eLarge::VALUE);
+
+            log.close();
+
+            auto lines = decode(path);
+
+            Assert::IsTrue(lines.size() == 1);
+            Assert::IsTrue(contains(lines[0], "enums b 42 0 1099511627776 (binary_log.cpp:"));
+            Assert::IsFalse(contains(lines[0], "malformed"));
+
+            std::filesystem::remove(path);
+        }
+
+        TEST_METHOD(threads_and_wrapping) {
+            // enough to wrap around the buffer of a thread a couple of times
+            constexpr int k_NumMessages = 20000;
+
+            auto  path = std::filesystem::temp_directory_path() / "djinn_binary_log_threads.bin";
+            auto& log  = djinn::core::BinaryLog::instance();
+
+            log.open(path);
+
+            std::vector<std::thread> threads;
+
+            for (int t = 0; t < 4; ++t)
+                threads.emplace_back([t] {
+                    for (int i = 0; i < k_NumMessages; ++i)
+                        gLogBinary(MESSAGE, "thread {} message {} padding {}", t, i, "some text to fill the buffers up");
+                });
+
+            // flushing concurrently with the threads that are logging
+            for (int i = 0; i < 100; ++i)
+                log.flush();
+
+            for (auto& thread : threads)
+                thread.join();  // these buffers are orphaned now, but should still be written
+
+            // larger than the buffer of a thread, so it's written directly
+            std::string large(djinn::core::BinaryLog::k_BufferSize + 100, 'z');
+            gLogBinary(MESSAGE, "large {}", large);
+
+            log.close();
+
+            auto lines = decode(path);
+
+            Assert::IsTrue(lines.size() == 4 * k_NumMessages + 1);
+            Assert::IsTrue(contains(lines.back(), large));
+
+            // the messages of a single thread remain in order
+            std::vector<int> next(4, 0);
+
+            for (size_t i = 0; i + 1 < lines.size(); ++i) {
+                std::stringstream sstr(lines[i].substr(lines[i].find("thread ")));
+                std::string       word;
+                int               thread  = -1;
+                int               message = -1;
+
+                sstr >> word >> thread >> word >> message;
+
+                Assert::IsTrue((thread >= 0) && (thread < 4));
+                Assert::IsTrue(message == next[thread]);
+
+                ++next[thread];
+            }
+
+            std::filesystem::remove(path);
+        }
+
+        TEST_METHOD(invalid_input) {
+            std::stringstream input("definitely not a binary log");
+            std::stringstream output;
+
+            Assert::IsFalse(djinn::core::decodeBinaryLog(input, output));
+        }
+    };
+}
@@ -0,0 +1,137 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "core/dependency_graph.h"
+#include "core/system.h"
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace DjinnTest {
+    namespace {
+        class TestSystem: public djinn::core::System {
+        public:
+            TestSystem(const std::string& name, const std::vector<std::string>& dependencies):
+                System(name) {
+                for (const auto& dep : dependencies)
+                    addDependency(dep);
+            }
+        };
+
+        struct Systems {
+            void add(const std::string& name, const std::vector<std::string>& dependencies = {}) {
+                m_Storage.push_back(std::make_unique<TestSystem>(name, dependencies));
+                m_Pointers.push_back(m_Storage.back().get());
+            }
+
+            std::vector<std::unique_ptr<TestSystem>> m_Storage;
+            std::vector<djinn::core::System*>        m_Pointers;
+        };
+
+        // yields the message of the exception thrown while building the graph (empty if it succeeded)
+        std::string buildError(const std::vector<djinn::core::System*>& systems) {
+            try {
+                djinn::core::DependencyGraph graph(systems);
+            }
+            catch (const std::runtime_error& ex) {
+                return ex.what();
+            }
+
+            return std::string();
+        }
+
+        size_t positionOf(const djinn::core::DependencyGraph& graph, const std::string& name) {
+            const auto& order = graph.getOrder();
+
+            for (size_t i = 0; i < order.size(); ++i)
+                if (graph[order[i]].m_System->getName() == name)
+                    return i;
+
+            return order.size();
+        }
+    }  // namespace
+
+    TEST_CLASS(DependencyGraph) {
+    public:
+        TEST_METHOD(order_and_levels) {
+            // a <- b <- d
+            // a <- c <- d
+            Systems systems;
+            systems.add("d", {"b", "c"});
+            systems.add("c", {"a"});
+            systems.add("b", {"a"});
+            systems.add("a");
+
+            djinn::core::DependencyGraph graph(systems.m_Pointers);
+
+            Assert::IsTrue(graph.size() == 4);
+            Assert::IsTrue(graph.getOrder().size() == 4);
+
+            Assert::IsTrue(positionOf(graph, "a") < positionOf(graph, "b"));
+            Assert::IsTrue(positionOf(graph, "a") < positionOf(graph, "c"));
+            Assert::IsTrue(positionOf(graph, "b") < positionOf(graph, "d"));
+            Assert::IsTrue(positionOf(graph, "c") < positionOf(graph, "d"));
+
+            const auto& levels = graph.getLevels();
+
+            Assert::IsTrue(levels.size() == 3);
+            Assert::IsTrue(levels[0].size() == 1);
+            Assert::IsTrue(levels[1].size() == 2);  // b and c are independent
+            Assert::IsTrue(levels[2].size() == 1);
+
+            // ids are indices into the supplied list
+            Assert::IsTrue(graph[0].m_System->getName() == "d");
+            Assert::IsTrue(graph[0].m_Depth == 2);
+            Assert::IsTrue(graph[0].m_Dependencies.size() == 2);
+            Assert::IsTrue(graph[3].m_Dependents.size() == 2);
+        }
+
+        TEST_METHOD(available) {
+            Systems systems;
+            systems.add("b", {"a"});
+
+            // 'a' was initialized earlier, so it isn't part of this graph
+            djinn::core::DependencyGraph graph(systems.m_Pointers, {"a"});
+
+            Assert::IsTrue(graph.size() == 1);
+            Assert::IsTrue(graph[0].m_Dependencies.empty());
+        }
+
+        TEST_METHOD(missing_dependencies) {
+            Systems systems;
+            systems.add("a", {"x"});
+            systems.add("b", {"y"});
+
+            auto message = buildError(systems.m_Pointers);
+
+            // all of them are reported
+            Assert::IsTrue(message.find("[x]") != std::string::npos);
+            Assert::IsTrue(message.find("[y]") != std::string::npos);
+        }
+
+        TEST_METHOD(cycle) {
+            Systems systems;
+            systems.add("a", {"c"});
+            systems.add("b", {"a"});
+            systems.add("c", {"b"});
+            systems.add("d", {"a"});  // depends on the cycle, but isn't part of it
+
+            auto message = buildError(systems.m_Pointers);
+
+            Assert::IsTrue(message.find("Cyclic system dependency: ") == 0);
+
+            // just the systems in the cycle
+            auto cycle = message.substr(std::string("Cyclic system dependency: ").size());
+
+            Assert::IsTrue(cycle.find('d') == std::string::npos);
+            Assert::IsTrue(cycle.find('a') != std::string::npos);
+            Assert::IsTrue(cycle.find('b') != std::string::npos);
+            Assert::IsTrue(cycle.find('c') != std::string::npos);
+        }
+    };
+}
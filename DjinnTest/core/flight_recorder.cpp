@@ -0,0 +1,140 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "core/flight_recorder.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace DjinnTest {
+    namespace {
+        using djinn::core::eLogCategory;
+
+        std::vector<std::string> decode(const std::filesystem::path& path) {
+            std::ifstream     file(path, std::ios::binary);
+            std::stringstream output;
+
+            Assert::IsTrue(djinn::core::decodeFlightRecorder(file, output));
+
+            std::vector<std::string> result;
+            std::string              line;
+
+            while (std::getline(output, line))
+                result.push_back(line);
+
+            return result;
+        }
+
+        // yields the number in 'message N (...)', or -1
+        int getMessageIndex(const std::string& line) {
+            auto pos = line.find("message ");
+
+            if (pos == std::string::npos)
+                return -1;
+
+            return std::stoi(line.substr(pos + 8));
+        }
+
+        void writeMessages(djinn::core::FlightRecorder& recorder, int first, int last) {
+            for (int i = first; i < last; ++i)
+                recorder.write({eLogCategory::MESSAGE, "test.cpp", i}, "message " + std::to_string(i));
+        }
+    }  // namespace
+
+    TEST_CLASS(FlightRecorder) {
+    public:
+        TEST_METHOD(wraps_around) {
+            auto path = std::filesystem::temp_directory_path() / "djinn_flight_recorder_wrap.bin";
+            std::filesystem::remove(path);
+
+            {
+                djinn::core::FlightRecorder recorder(path, 4096);
+                writeMessages(recorder, 0, 500);  // many times the capacity
+            }
+
+            auto lines = decode(path);
+
+            Assert::IsTrue(!lines.empty());
+            Assert::IsTrue(lines.size() < 500);
+
+            // only the most recent messages remain, oldest first and without gaps
+            int first = getMessageIndex(lines.front());
+
+            Assert::IsTrue(first > 0);
+
+            for (size_t i = 0; i < lines.size(); ++i)
+                Assert::IsTrue(getMessageIndex(lines[i]) == first + static_cast<int>(i));
+
+            Assert::IsTrue(getMessageIndex(lines.back()) == 499);
+            Assert::IsTrue(lines.back().find("(test.cpp:499)") != std::string::npos);
+
+            // an existing ring with the same capacity is continued
+            {
+                djinn::core::FlightRecorder recorder(path, 4096);
+                writeMessages(recorder, 500, 510);
+            }
+
+            lines = decode(path);
+            Assert::IsTrue(getMessageIndex(lines.back()) == 509);
+            Assert::IsTrue(getMessageIndex(lines.front()) > first);
+
+            std::filesystem::remove(path);
+        }
+
+        TEST_METHOD(skips_corrupt_records) {
+            auto path = std::filesystem::temp_directory_path() / "djinn_flight_recorder_corrupt.bin";
+            std::filesystem::remove(path);
+
+            {
+                djinn::core::FlightRecorder recorder(path, 4096);
+                writeMessages(recorder, 0, 20);  // fits without wrapping
+            }
+
+            // damage the text of a single record
+            {
+                std::vector<char> data;
+
+                {
+                    std::ifstream file(path, std::ios::binary);
+                    data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+                }
+
+                std::string needle = "message 10";
+
+                auto it = std::search(data.begin(), data.end(), needle.begin(), needle.end());
+                Assert::IsTrue(it != data.end());
+
+                *(it + 8) = 'X';
+
+                std::ofstream file(path, std::ios::binary | std::ios::trunc);
+                file.write(data.data(), static_cast<std::streamsize>(data.size()));
+            }
+
+            auto lines = decode(path);
+
+            Assert::IsTrue(lines.size() == 19);
+
+            for (const auto& line : lines)
+                Assert::IsTrue(getMessageIndex(line) != 10);
+
+            Assert::IsTrue(getMessageIndex(lines[9]) == 9);
+            Assert::IsTrue(getMessageIndex(lines[10]) == 11);
+
+            std::filesystem::remove(path);
+        }
+
+        TEST_METHOD(invalid_input) {
+            std::stringstream input("definitely not a flight recorder");
+            std::stringstream output;
+
+            Assert::IsFalse(djinn::core::decodeFlightRecorder(input, output));
+        }
+    };
+}
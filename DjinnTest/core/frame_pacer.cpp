@@ -0,0 +1,130 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "core/frame_pacer.h"
+
+#include <chrono>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace DjinnTest {
+    namespace {
+        using djinn::core::FramePacer;
+
+        bool isClose(double a, double b) {
+            return std::abs(a - b) < 1e-9;
+        }
+
+        // timings are only checked loosely, a busy machine may always take longer
+        bool isPeriod(FramePacer::Duration elapsed, std::chrono::milliseconds period) {
+            using namespace std::chrono_literals;
+
+            return (elapsed >= period - 1ms) && (elapsed < period + 50ms);
+        }
+    }  // namespace
+
+    TEST_CLASS(FramePacing) {
+    public:
+        TEST_METHOD(parse_mode) {
+            for (auto mode : {FramePacer::eMode::UNLIMITED, FramePacer::eMode::TARGET_FPS, FramePacer::eMode::VSYNC}) {
+                std::stringstream sstr;
+                sstr << mode;
+
+                Assert::IsTrue(djinn::core::parseFramePacingMode(sstr.str(), FramePacer::eMode::UNLIMITED) == mode);
+                Assert::IsTrue(djinn::core::parseFramePacingMode(sstr.str(), FramePacer::eMode::VSYNC) == mode);
+            }
+
+            Assert::IsTrue(djinn::core::parseFramePacingMode("vsync", FramePacer::eMode::UNLIMITED) == FramePacer::eMode::VSYNC);
+
+            // unknown names keep whatever was there before
+            Assert::IsTrue(djinn::core::parseFramePacingMode("60fps", FramePacer::eMode::TARGET_FPS) == FramePacer::eMode::TARGET_FPS);
+            Assert::IsTrue(djinn::core::parseFramePacingMode("Target FPS", FramePacer::eMode::VSYNC) == FramePacer::eMode::VSYNC);
+        }
+
+        TEST_METHOD(target_fps) {
+            using namespace std::chrono_literals;
+
+            FramePacer pacer;
+            pacer.setMode(FramePacer::eMode::TARGET_FPS);
+            pacer.setTargetFrameRate(100.0);
+            pacer.start();
+
+            for (int i = 0; i < 3; ++i)
+                Assert::IsTrue(isPeriod(pacer.endFrame(), 10ms));
+        }
+
+        TEST_METHOD(unlimited) {
+            using namespace std::chrono_literals;
+
+            FramePacer pacer;
+            pacer.setMode(FramePacer::eMode::UNLIMITED);
+            pacer.setTargetFrameRate(10.0);  // ignored
+            pacer.start();
+
+            for (int i = 0; i < 3; ++i)
+                Assert::IsTrue(pacer.endFrame() < 50ms);
+        }
+
+        TEST_METHOD(vsync) {
+            using namespace std::chrono_literals;
+
+            FramePacer pacer;
+            pacer.setMode(FramePacer::eMode::VSYNC);
+            pacer.setTargetFrameRate(10.0);
+            pacer.start();
+
+            // presentation is expected to block, so there's no waiting here
+            Assert::IsTrue(pacer.endFrame() < 50ms);
+
+            // ...unless there is nothing to present
+            pacer.setHeadless(true);
+            pacer.start();
+
+            Assert::IsTrue(isPeriod(pacer.endFrame(), 100ms));
+        }
+
+        TEST_METHOD(fixed_steps) {
+            djinn::core::FixedStepAccumulator accumulator;
+            accumulator.setTimestep(0.25);
+
+            accumulator.add(0.75);
+            Assert::IsTrue(accumulator.consume() == 3);
+            Assert::IsTrue(accumulator.consume() == 0);
+            Assert::IsTrue(isClose(accumulator.getAlpha(), 0.0));
+
+            // partial steps are kept for the next frame
+            accumulator.add(0.125);
+            Assert::IsTrue(accumulator.consume() == 0);
+            Assert::IsTrue(isClose(accumulator.getAlpha(), 0.5));
+
+            accumulator.add(0.125);
+            Assert::IsTrue(accumulator.consume() == 1);
+        }
+
+        TEST_METHOD(fixed_steps_capped) {
+            djinn::core::FixedStepAccumulator accumulator;
+            accumulator.setTimestep(0.25);
+            accumulator.setMaxSteps(5);
+
+            // 10 and a half steps are due, only 5 are taken and the other 5 are dropped
+            accumulator.add(2.625);
+            Assert::IsTrue(accumulator.consume() == 5);
+            Assert::IsTrue(isClose(accumulator.getAlpha(), 0.5));
+            Assert::IsTrue(accumulator.consume() == 0);
+
+            bool isThrown = false;
+
+            try {
+                accumulator.setTimestep(0.0);
+            }
+            catch (const std::runtime_error&) {
+                isThrown = true;
+            }
+
+            Assert::IsTrue(isThrown);
+        }
+    };
+}
@@ -0,0 +1,138 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "core/job_system.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace DjinnTest {
+    TEST_CLASS(JobSystem) {
+    public:
+        TEST_METHOD(parallel_for) {
+            djinn::core::SystemScheduler pool(3);
+            djinn::JobSystem             jobs;
+
+            jobs.start(pool);
+
+            std::vector<std::atomic_int> hits(1000);
+
+            auto counter = jobs.parallel_for(hits.size(), 16, [&](size_t i) { ++hits[i]; });
+            jobs.wait(counter);
+
+            Assert::IsTrue(counter->isDone());
+
+            for (const auto& count : hits)
+                Assert::IsTrue(count == 1);
+
+            jobs.stop();
+        }
+
+        TEST_METHOD(dependencies) {
+            djinn::core::SystemScheduler pool(2);
+            djinn::JobSystem             jobs;
+
+            jobs.start(pool);
+
+            std::atomic_int step    = 0;
+            bool            inOrder = true;
+
+            auto first = jobs.schedule([&] {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                step = 1;
+            });
+
+            auto second = jobs.schedule(
+                [&] {
+                    if (step != 1)
+                        inOrder = false;
+                },
+                first);
+
+            jobs.wait(second);
+
+            Assert::IsTrue(first->isDone());
+            Assert::IsTrue(inOrder);
+
+            jobs.stop();
+        }
+
+        TEST_METHOD(stealing) {
+            // a single job spawns the work on its own queue; the other workers have to steal it
+            djinn::core::SystemScheduler pool(4);
+            djinn::JobSystem             jobs;
+
+            jobs.start(pool);
+
+            std::mutex                mutex;
+            std::set<std::thread::id> threads;
+            std::thread::id           spawner;
+
+            auto root = jobs.schedule([&] {
+                spawner = std::this_thread::get_id();
+
+                auto children = jobs.parallel_for(64, 1, [&](size_t) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+                    std::lock_guard<std::mutex> guard(mutex);
+                    threads.insert(std::this_thread::get_id());
+                });
+
+                jobs.wait(children);  // waiting from within a job
+            });
+
+            jobs.wait(root);
+
+            Assert::IsTrue(threads.size() > 1);
+            Assert::IsTrue(threads.size() - threads.count(spawner) >= 1);
+
+            jobs.stop();
+        }
+
+        TEST_METHOD(wait_without_workers) {
+            djinn::core::SystemScheduler pool(0);
+            djinn::JobSystem             jobs;
+
+            jobs.start(pool);
+
+            std::atomic_int sum = 0;
+
+            auto counter = jobs.parallel_for(100, 10, [&](size_t i) { sum += static_cast<int>(i); });
+            jobs.wait(counter);  // executes everything on this thread
+
+            Assert::IsTrue(sum == 4950);
+
+            jobs.stop();
+        }
+
+        TEST_METHOD(stop_completes_outstanding_jobs) {
+            djinn::core::SystemScheduler pool(0);
+            djinn::JobSystem             jobs;
+
+            jobs.start(pool);
+
+            std::atomic_int numDone = 0;
+
+            auto first  = jobs.schedule([&] { ++numDone; });
+            auto second = jobs.schedule([&] { ++numDone; }, first);
+
+            jobs.stop();
+
+            Assert::IsTrue(numDone == 2);
+            Assert::IsTrue(first->isDone());
+            Assert::IsTrue(second->isDone());
+
+            // when not running, jobs are executed right away
+            auto third = jobs.schedule([&] { ++numDone; });
+
+            Assert::IsTrue(third->isDone());
+            Assert::IsTrue(numDone == 3);
+        }
+    };
+}
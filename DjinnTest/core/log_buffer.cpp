@@ -0,0 +1,175 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "core/log_buffer.h"
+
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <utility>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace DjinnTest {
+    namespace {
+        template <typename T>
+        std::string streamed(T value) {
+            std::stringstream sstr;
+            sstr << value;
+            return sstr.str();
+        }
+
+        template <typename T>
+        bool isSameAsStream(T value) {
+            djinn::core::LogBuffer buffer;
+
+            if constexpr (std::is_integral_v<T>)
+                buffer.appendInteger(value);
+            else
+                buffer.appendFloat(value);
+
+            return buffer.view() == streamed(value);
+        }
+    }  // namespace
+
+    TEST_CLASS(LogBuffer) {
+    public:
+        TEST_METHOD(inline_to_heap) {
+            using djinn::core::LogBuffer;
+
+            LogBuffer   buffer;
+            std::string expected;
+
+            Assert::IsTrue(buffer.empty());
+            Assert::IsTrue(buffer.isInline());
+
+            // fill the inline part exactly
+            for (size_t i = 0; i < LogBuffer::k_InlineCapacity; ++i) {
+                char c = static_cast<char>('a' + i % 26);
+
+                buffer.append(c);
+                expected += c;
+            }
+
+            Assert::IsTrue(buffer.isInline());
+            Assert::IsTrue(buffer.size() == LogBuffer::k_InlineCapacity);
+
+            // one more moves everything to the heap
+            buffer.append("xyz");
+            expected += "xyz";
+
+            Assert::IsFalse(buffer.isInline());
+            Assert::IsTrue(buffer.view() == expected);
+
+            for (int i = 0; i < 1000; ++i) {
+                buffer.appendInteger(i);
+                expected += std::to_string(i);
+            }
+
+            Assert::IsTrue(buffer.view() == expected);
+
+            buffer.clear();
+
+            Assert::IsTrue(buffer.empty());
+            Assert::IsTrue(buffer.isInline());
+
+            buffer.append("again");
+            Assert::IsTrue(buffer.view() == "again");
+        }
+
+        TEST_METHOD(large_first_append) {
+            djinn::core::LogBuffer buffer;
+            std::string            text(1000, 'q');
+
+            buffer.append("short");
+            buffer.append(text);
+
+            Assert::IsFalse(buffer.isInline());
+            Assert::IsTrue(buffer.view() == "short" + text);
+        }
+
+        TEST_METHOD(integers_match_stream) {
+            Assert::IsTrue(isSameAsStream(0));
+            Assert::IsTrue(isSameAsStream(-1));
+            Assert::IsTrue(isSameAsStream(12345));
+            Assert::IsTrue(isSameAsStream(int16_t(-32768)));
+            Assert::IsTrue(isSameAsStream(uint16_t(65535)));
+            Assert::IsTrue(isSameAsStream(std::numeric_limits<int32_t>::min()));
+            Assert::IsTrue(isSameAsStream(std::numeric_limits<int64_t>::min()));
+            Assert::IsTrue(isSameAsStream(std::numeric_limits<int64_t>::max()));
+            Assert::IsTrue(isSameAsStream(std::numeric_limits<uint64_t>::max()));
+            Assert::IsTrue(isSameAsStream(size_t(42)));
+        }
+
+        TEST_METHOD(floats_match_stream) {
+            Assert::IsTrue(isSameAsStream(0.0));
+            Assert::IsTrue(isSameAsStream(1.0));
+            Assert::IsTrue(isSameAsStream(-1.5));
+            Assert::IsTrue(isSameAsStream(0.1));
+            Assert::IsTrue(isSameAsStream(3.14159265358979));
+            Assert::IsTrue(isSameAsStream(123456.0));
+            Assert::IsTrue(isSameAsStream(1234567.0));  // switches to scientific notation
+            Assert::IsTrue(isSameAsStream(1e-5));
+            Assert::IsTrue(isSameAsStream(1e300));
+            Assert::IsTrue(isSameAsStream(-2.5e-300));
+            Assert::IsTrue(isSameAsStream(std::numeric_limits<double>::infinity()));
+            Assert::IsTrue(isSameAsStream(static_cast<double>(0.3f)));
+        }
+
+        TEST_METHOD(copy_and_move) {
+            using djinn::core::LogBuffer;
+
+            std::string longText(LogBuffer::k_InlineCapacity * 2, 'L');
+
+            LogBuffer shortBuffer;
+            shortBuffer.append("short");
+
+            LogBuffer longBuffer;
+            longBuffer.append(longText);
+
+            // copies
+            LogBuffer a(shortBuffer);
+            LogBuffer b(longBuffer);
+
+            Assert::IsTrue(a.view() == "short");
+            Assert::IsTrue(a.isInline());
+            Assert::IsTrue(b.view() == longText);
+            Assert::IsFalse(b.isInline());
+            Assert::IsTrue(shortBuffer.view() == "short");
+            Assert::IsTrue(longBuffer.view() == longText);
+
+            // assigning in both directions
+            a = longBuffer;
+            b = shortBuffer;
+
+            Assert::IsTrue(a.view() == longText);
+            Assert::IsTrue(b.view() == "short");
+            Assert::IsTrue(b.isInline());
+
+            a = a;  // self assignment
+            Assert::IsTrue(a.view() == longText);
+
+            // moves leave the source empty
+            LogBuffer c(std::move(a));
+
+            Assert::IsTrue(c.view() == longText);
+            Assert::IsTrue(a.empty());
+
+            LogBuffer d(std::move(b));
+
+            Assert::IsTrue(d.view() == "short");
+            Assert::IsTrue(b.empty());
+
+            c = std::move(d);
+
+            Assert::IsTrue(c.view() == "short");
+            Assert::IsTrue(c.isInline());
+            Assert::IsTrue(d.empty());
+
+            // the moved-from buffers are still usable
+            a.append("reused");
+            Assert::IsTrue(a.view() == "reused");
+        }
+    };
+}
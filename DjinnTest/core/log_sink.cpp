@@ -0,0 +1,114 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "core/log_sink.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace DjinnTest {
+    namespace {
+        using djinn::core::eLogCategory;
+
+        std::string readFile(const std::filesystem::path& path) {
+            std::ifstream file(path);
+            return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        }
+    }  // namespace
+
+    TEST_CLASS(LogSink) {
+    public:
+        TEST_METHOD(poll_without_support) {
+            int numWritten = 0;
+
+            djinn::core::LogSink sink([&](const djinn::core::LogMessage::MetaInfo&, std::string_view) { ++numWritten; });
+
+            sink.poll();  // lambdas don't implement it
+            sink.write({eLogCategory::MESSAGE, "test", 1}, "a");
+
+            Assert::IsTrue(numWritten == 1);
+        }
+
+        TEST_METHOD(file_sink_flushes_when_idle) {
+            using namespace std::chrono_literals;
+
+            auto path = std::filesystem::temp_directory_path() / "djinn_log_sink_test.log";
+
+            djinn::core::FileSinkSettings settings;
+            settings.m_FlushInterval = 50ms;
+
+            {
+                auto sink = djinn::core::makeFileSink(path, settings);
+
+                sink.write({eLogCategory::MESSAGE, "test", 1}, "first");  // the first write is always due
+                sink.write({eLogCategory::MESSAGE, "test", 2}, "buffered");
+
+                Assert::IsTrue(readFile(path).find("buffered") == std::string::npos);
+
+                sink.poll();  // too soon
+                Assert::IsTrue(readFile(path).find("buffered") == std::string::npos);
+
+                std::this_thread::sleep_for(60ms);
+
+                sink.poll();
+                Assert::IsTrue(readFile(path).find("buffered") != std::string::npos);
+
+                sink.write({eLogCategory::ERROR_, "test", 3}, "urgent");
+                Assert::IsTrue(readFile(path).find("urgent") != std::string::npos);
+            }
+
+            std::filesystem::remove(path);
+        }
+
+        TEST_METHOD(file_sink_rotates) {
+            using namespace std::chrono_literals;
+
+            auto directory = std::filesystem::temp_directory_path();
+            auto current   = directory / "djinn_rotation_test.log";
+            auto previous  = directory / "djinn_rotation_test.1.log";
+            auto oldest    = directory / "djinn_rotation_test.2.log";
+
+            for (const auto& path : {current, previous, oldest})
+                std::filesystem::remove(path);
+
+            djinn::core::FileSinkSettings settings;
+            settings.m_FlushInterval = 1h;  // only errors are flushed
+            settings.m_MaxFileSize   = 64;  // not quite two lines
+            settings.m_MaxFiles      = 2;
+
+            {
+                auto sink = djinn::core::makeFileSink(current, settings);
+
+                sink.write({eLogCategory::ERROR_, "test", 1}, "first");
+                sink.write({eLogCategory::MESSAGE, "test", 2}, "buffered");
+
+                Assert::IsTrue(readFile(current).find("first") != std::string::npos);
+                Assert::IsTrue(readFile(current).find("buffered") == std::string::npos);
+
+                // errors bypass the buffer; this one doesn't fit anymore, so the file is rotated first
+                sink.write({eLogCategory::ERROR_, "test", 3}, "urgent");
+
+                Assert::IsTrue(readFile(current).find("buffered") != std::string::npos);
+                Assert::IsTrue(readFile(current).find("urgent") != std::string::npos);
+                Assert::IsTrue(readFile(previous).find("first") != std::string::npos);
+
+                // rotating again drops the oldest file instead of keeping a third one
+                sink.write({eLogCategory::ERROR_, "test", 4}, "again");
+
+                Assert::IsTrue(readFile(current).find("again") != std::string::npos);
+                Assert::IsTrue(readFile(previous).find("urgent") != std::string::npos);
+                Assert::IsTrue(readFile(previous).find("first") == std::string::npos);
+                Assert::IsFalse(std::filesystem::exists(oldest));
+            }
+
+            for (const auto& path : {current, previous, oldest})
+                std::filesystem::remove(path);
+        }
+    };
+}
@@ -0,0 +1,254 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "core/log_writer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace DjinnTest {
+    namespace {
+        using Record = djinn::core::LogWriter::Record;
+        using djinn::core::eLogCategory;
+
+        Record makeRecord(eLogCategory category, int value) {
+            Record result{{category, "test", 0}, {}};
+            result.m_Text.appendInteger(value);
+
+            return result;
+        }
+
+        // collects everything that was written; optionally holds up the writer thread
+        struct Collector {
+            void operator()(const Record& record) {
+                while (m_Stalled)
+                    std::this_thread::yield();
+
+                std::lock_guard<std::mutex> guard(m_Mutex);
+                m_Written.emplace_back(record.m_Text.view());
+            }
+
+            std::vector<std::string> getWritten() {
+                std::lock_guard<std::mutex> guard(m_Mutex);
+                return m_Written;
+            }
+
+            std::atomic_bool         m_Stalled = false;
+            std::mutex               m_Mutex;
+            std::vector<std::string> m_Written;
+        };
+    }  // namespace
+
+    TEST_CLASS(LogWriter) {
+    public:
+        TEST_METHOD(drains_on_destruction) {
+            using djinn::core::LogWriter;
+
+            Collector collector;
+
+            {
+                LogWriter writer([&](const LogWriter::Record& r) { collector(r); }, 1024, LogWriter::eOverflowPolicy::BLOCK);
+
+                for (int i = 0; i < 1000; ++i)
+                    Assert::IsTrue(writer.push(makeRecord(eLogCategory::MESSAGE, i)));
+            }
+
+            auto written = collector.getWritten();
+
+            Assert::IsTrue(written.size() == 1000);
+
+            for (int i = 0; i < 1000; ++i)
+                Assert::IsTrue(written[i] == std::to_string(i));  // single producer, so in order
+        }
+
+        TEST_METHOD(sync) {
+            using djinn::core::LogWriter;
+
+            Collector collector;
+            LogWriter writer([&](const LogWriter::Record& r) { collector(r); }, 64, LogWriter::eOverflowPolicy::BLOCK);
+
+            for (int i = 0; i < 10; ++i)
+                writer.push(makeRecord(eLogCategory::MESSAGE, i));
+
+            writer.sync();
+
+            Assert::IsTrue(collector.getWritten().size() == 10);
+        }
+
+        TEST_METHOD(drop) {
+            using djinn::core::LogWriter;
+
+            Collector collector;
+            collector.m_Stalled = true;
+
+            {
+                LogWriter writer([&](const LogWriter::Record& r) { collector(r); }, 4, LogWriter::eOverflowPolicy::DROP);
+
+                int numAccepted = 0;
+
+                for (int i = 0; i < 100; ++i)
+                    if (writer.push(makeRecord(eLogCategory::MESSAGE, i)))
+                        ++numAccepted;
+
+                // the writer may have taken a batch out of the queue before it stalled
+                Assert::IsTrue(numAccepted >= 4);
+                Assert::IsTrue(numAccepted <= 8);
+                Assert::IsTrue(writer.getNumDropped() == static_cast<size_t>(100 - numAccepted));
+
+                collector.m_Stalled = false;
+            }
+
+            // no report with this policy
+            for (const auto& text : collector.getWritten())
+                Assert::IsTrue(text.find("dropped") == std::string::npos);
+        }
+
+        TEST_METHOD(count) {
+            using djinn::core::LogWriter;
+
+            Collector collector;
+            collector.m_Stalled = true;
+
+            size_t numDropped = 0;
+
+            {
+                LogWriter writer([&](const LogWriter::Record& r) { collector(r); }, 4, LogWriter::eOverflowPolicy::COUNT);
+
+                for (int i = 0; i < 100; ++i)
+                    writer.push(makeRecord(eLogCategory::MESSAGE, i));
+
+                numDropped = writer.getNumDropped();
+                Assert::IsTrue(numDropped > 0);
+
+                collector.m_Stalled = false;
+                writer.sync();
+
+                // reported once there is room again
+                writer.push(makeRecord(eLogCategory::MESSAGE, -1));
+            }
+
+            bool isReported = false;
+
+            for (const auto& text : collector.getWritten())
+                if (text == std::to_string(numDropped) + " log messages were dropped (queue capacity: 4)")
+                    isReported = true;
+
+            Assert::IsTrue(isReported);
+        }
+
+        TEST_METHOD(block) {
+            using djinn::core::LogWriter;
+
+            Collector collector;
+            collector.m_Stalled = true;
+
+            LogWriter writer([&](const LogWriter::Record& r) { collector(r); }, 4, LogWriter::eOverflowPolicy::BLOCK);
+
+            std::atomic_int numPushed = 0;
+
+            std::thread producer([&] {
+                for (int i = 0; i < 100; ++i) {
+                    writer.push(makeRecord(eLogCategory::MESSAGE, i));
+                    ++numPushed;
+                }
+            });
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            Assert::IsTrue(numPushed < 100);  // waiting for room
+
+            collector.m_Stalled = false;
+            producer.join();
+
+            writer.sync();
+
+            Assert::IsTrue(collector.getWritten().size() == 100);
+            Assert::IsTrue(writer.getNumDropped() == 0);
+        }
+
+        TEST_METHOD(block_from_writer_thread) {
+            using djinn::core::LogWriter;
+
+            Collector collector;
+
+            {
+                LogWriter* self = nullptr;
+
+                // a sink that logs more than fits in the queue while it is being written to
+                LogWriter writer(
+                    [&](const LogWriter::Record& r) {
+                        collector(r);
+
+                        if (r.m_Text.view() == "0")
+                            for (int i = 1; i <= 8; ++i)
+                                self->push(makeRecord(eLogCategory::MESSAGE, i));
+                    },
+                    2,
+                    LogWriter::eOverflowPolicy::BLOCK);
+
+                self = &writer;
+
+                writer.push(makeRecord(eLogCategory::MESSAGE, 0));
+            }  // writes whatever is still queued
+
+            Assert::IsTrue(collector.getWritten().size() == 9);
+        }
+
+        TEST_METHOD(fatal_is_written_before_push_returns) {
+            using djinn::core::LogWriter;
+
+            Collector collector;
+            LogWriter writer([&](const LogWriter::Record& r) { collector(r); }, 8, LogWriter::eOverflowPolicy::DROP);
+
+            // keep the other producers busy, so the queue holds records of several threads
+            std::atomic_bool         isDone = false;
+            std::vector<std::thread> producers;
+
+            for (int i = 0; i < 3; ++i)
+                producers.emplace_back([&] {
+                    while (!isDone)
+                        writer.push(makeRecord(eLogCategory::MESSAGE, 0));
+                });
+
+            for (int i = 1; i <= 200; ++i) {
+                Assert::IsTrue(writer.push(makeRecord(eLogCategory::FATAL, i)));
+
+                auto written = collector.getWritten();
+                Assert::IsTrue(std::find(written.begin(), written.end(), std::to_string(i)) != written.end());
+            }
+
+            isDone = true;
+
+            for (auto& producer : producers)
+                producer.join();
+        }
+
+        TEST_METHOD(idle) {
+            using djinn::core::LogWriter;
+
+            Collector       collector;
+            std::atomic_int numIdle = 0;
+
+            LogWriter writer(
+                [&](const LogWriter::Record& r) { collector(r); },
+                64,
+                LogWriter::eOverflowPolicy::BLOCK,
+                [&] { ++numIdle; });
+
+            writer.push(makeRecord(eLogCategory::MESSAGE, 0));
+            writer.sync();
+
+            // called on the writer thread while nothing is queued
+            while (numIdle < 2)
+                std::this_thread::yield();
+
+            Assert::IsTrue(collector.getWritten().size() == 1);
+        }
+    };
+}
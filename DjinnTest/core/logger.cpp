@@ -0,0 +1,248 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "core/logger.h"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace DjinnTest {
+    namespace {
+        using djinn::core::eLogCategory;
+
+        // logs through a specific site, the way the macros do
+        void logAt(djinn::core::Logger& logger, djinn::core::LogSite& site, const std::string& text) {
+            if (logger.admit(site))
+                logger(site.getCategory(), site.getSourceFile(), site.getSourceLine()) << text;
+        }
+
+        struct Collector {
+            void operator()(const djinn::core::LogMessage::MetaInfo&, std::string_view message) {
+                m_Written->emplace_back(message);
+            }
+
+            std::vector<std::string>* m_Written;
+        };
+
+        struct Counter {
+            void operator()(const djinn::core::LogMessage::MetaInfo&, std::string_view) {
+                // the sink shouldn't be written to once removeAll() has returned
+                if (m_IsRemoved->load())
+                    ++*m_NumLate;
+
+                ++*m_NumWritten;
+            }
+
+            std::atomic_int*  m_NumWritten;
+            std::atomic_int*  m_NumLate;
+            std::atomic_bool* m_IsRemoved;
+        };
+
+        // the logging macros always use the global logger, where a single sink can't be removed again;
+        // so this one is added just once, and only collects while a test points it somewhere
+        struct GlobalCollector {
+            void operator()(const djinn::core::LogMessage::MetaInfo&, std::string_view message) {
+                if (auto* written = s_Written.load())
+                    written->emplace_back(message);
+            }
+
+            static inline std::atomic<std::vector<std::string>*> s_Written = nullptr;
+        };
+
+        int countCall(int* numCalls) {
+            ++*numCalls;
+            return *numCalls;
+        }
+    }  // namespace
+
+    TEST_CLASS(Logger) {
+    public:
+        TEST_METHOD(unlimited_by_default) {
+            // [NOTE] sites are registered globally and never removed, so they have to outlive the test
+            static djinn::core::LogSite site(eLogCategory::MESSAGE, "test", 1);
+
+            std::vector<std::string> written;
+
+            djinn::core::Logger logger;
+            logger.add(Collector{&written});
+
+            for (int i = 0; i < 1000; ++i)
+                logAt(logger, site, "same");
+
+            Assert::IsTrue(written.size() == 1000);
+            Assert::IsTrue(logger.getNumRateLimited() == 0);
+            Assert::IsTrue(logger.getNumCollapsed() == 0);
+        }
+
+        TEST_METHOD(rate_limit) {
+            using namespace std::chrono_literals;
+
+            static djinn::core::LogSite site(eLogCategory::MESSAGE, "test", 2);
+
+            std::vector<std::string> written;
+
+            djinn::core::Logger logger;
+            logger.add(Collector{&written});
+            logger.setRateLimit(eLogCategory::MESSAGE, {10, 50ms, false});
+
+            for (int i = 0; i < 25; ++i)
+                logAt(logger, site, std::to_string(i));
+
+            Assert::IsTrue(written.size() == 10);
+            Assert::IsTrue(written.back() == "9");
+            Assert::IsTrue(logger.getNumRateLimited() == 15);
+            Assert::IsTrue(site.getNumRateLimited() == 15);
+
+            // still within the interval, nothing to report yet
+            logger.reportExpired();
+            Assert::IsTrue(written.size() == 10);
+
+            std::this_thread::sleep_for(60ms);
+
+            logger.reportExpired();
+            Assert::IsTrue(written.size() == 11);
+            Assert::IsTrue(written.back() == "15 messages were suppressed (rate limit)");
+
+            // a new interval, so the site may log again
+            logAt(logger, site, "again");
+            Assert::IsTrue(written.back() == "again");
+        }
+
+        TEST_METHOD(collapse_repeats) {
+            using namespace std::chrono_literals;
+
+            static djinn::core::LogSite site(eLogCategory::WARNING, "test", 3);
+
+            std::vector<std::string> written;
+
+            djinn::core::Logger logger;
+            logger.add(Collector{&written});
+            logger.setRateLimit(eLogCategory::WARNING, {0, 1s, true});
+
+            logAt(logger, site, "a");
+            logAt(logger, site, "a");
+            logAt(logger, site, "a");
+            logAt(logger, site, "b");  // reports the repeats first
+            logAt(logger, site, "b");
+
+            Assert::IsTrue(written.size() == 3);
+            Assert::IsTrue(written[0] == "a");
+            Assert::IsTrue(written[1] == "last message repeated 2 times");
+            Assert::IsTrue(written[2] == "b");
+            Assert::IsTrue(logger.getNumCollapsed() == 3);
+
+            // the pending repeat is written with reportSuppressed, regardless of the interval
+            logger.reportSuppressed();
+
+            Assert::IsTrue(written.size() == 4);
+            Assert::IsTrue(written[3] == "last message repeated 1 times");
+
+            logger.reportSuppressed();
+            Assert::IsTrue(written.size() == 4);  // nothing pending anymore
+        }
+
+        TEST_METHOD(fatal_is_never_limited) {
+            static djinn::core::LogSite site(eLogCategory::FATAL, "test", 4);
+
+            std::vector<std::string> written;
+
+            djinn::core::Logger logger;
+            logger.add(Collector{&written});
+            logger.setRateLimit(eLogCategory::FATAL, {1, std::chrono::seconds(1), true});
+
+            for (int i = 0; i < 5; ++i)
+                logAt(logger, site, "fatal");
+
+            Assert::IsTrue(written.size() == 5);
+        }
+
+        TEST_METHOD(disabled_category_evaluates_nothing) {
+            static bool isAdded = false;
+
+            auto& logger = djinn::core::Logger::instance();
+
+            if (!isAdded) {
+                logger.add(GlobalCollector());
+                isAdded = true;
+            }
+
+            std::vector<std::string> written;
+            int                      numCalls = 0;
+
+            bool wasActive = djinn::core::isLogCategoryActive(eLogCategory::DEBUG);
+
+            GlobalCollector::s_Written = &written;
+            djinn::core::setGlobalLogCategory(eLogCategory::DEBUG, false);
+
+            gLogDebug << countCall(&numCalls);
+            logger.sync();
+
+            Assert::IsTrue(numCalls == 0);
+            Assert::IsTrue(written.empty());
+
+            djinn::core::setGlobalLogCategory(eLogCategory::DEBUG, true);
+
+            gLogDebug << countCall(&numCalls);
+            logger.sync();
+
+            djinn::core::setGlobalLogCategory(eLogCategory::DEBUG, wasActive);
+            GlobalCollector::s_Written = nullptr;
+
+#if DJINN_MIN_LOG_LEVEL <= 0
+            Assert::IsTrue(numCalls == 1);
+            Assert::IsTrue(written.size() == 1);
+            Assert::IsTrue(written.front() == "1");
+#else
+            // DEBUG is compiled out in this configuration, so it stays silent regardless
+            Assert::IsTrue(numCalls == 0);
+            Assert::IsTrue(written.empty());
+#endif
+        }
+
+        TEST_METHOD(sinks_change_while_logging) {
+            static djinn::core::LogSite site(eLogCategory::MESSAGE, "test", 5);
+
+            std::atomic_int  numWritten[2] = {0, 0};
+            std::atomic_int  numLate       = 0;
+            std::atomic_bool isRemoved[2]  = {false, false};
+            std::atomic_bool isDone        = false;
+
+            djinn::core::Logger logger;
+
+            std::vector<std::thread> threads;
+
+            for (int i = 0; i < 4; ++i)
+                threads.emplace_back([&] {
+                    while (!isDone)
+                        logAt(logger, site, "message");
+                });
+
+            for (int i = 0; i < 200; ++i) {
+                int idx = i % 2;
+
+                isRemoved[idx] = false;
+
+                logger.add(Counter{&numWritten[idx], &numLate, &isRemoved[idx]});
+                std::this_thread::yield();
+
+                Assert::IsTrue(logger.getNumSinks() == 1);
+
+                logger.removeAll();
+                isRemoved[idx] = true;
+            }
+
+            isDone = true;
+
+            for (auto& thread : threads)
+                thread.join();
+
+            Assert::IsTrue(numLate == 0);
+            Assert::IsTrue(logger.getNumSinks() == 0);
+        }
+    };
+}
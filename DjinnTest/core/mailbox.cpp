@@ -0,0 +1,166 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "core/mailbox.h"
+#include "core/mediator.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace DjinnTest {
+    namespace {
+        // every message type has a single global queue, so each test uses its own types
+        struct ForOwner {
+            int m_Value;
+        };
+
+        struct ForRemoved {
+            int m_Value;
+        };
+
+        template <typename T>
+        struct OwnedCollector: djinn::MessageHandler<T> {
+            OwnedCollector():
+                djinn::MessageHandler<T>(djinn::eDelivery::OWNER_THREAD) {}
+
+            void operator()(const T& message) override {
+                m_Values.push_back(message.m_Value);
+                m_Threads.push_back(std::this_thread::get_id());
+            }
+
+            std::vector<int>             m_Values;
+            std::vector<std::thread::id> m_Threads;
+        };
+    }  // namespace
+
+    TEST_CLASS(Mailbox) {
+    public:
+        TEST_METHOD(delivered_on_owner_thread) {
+            auto& mailbox = djinn::core::Mailbox::current();
+            mailbox.drain();  // whatever earlier tests left behind
+
+            OwnedCollector<ForOwner> handler;
+
+            std::thread other([] { djinn::broadcast(ForOwner{1}); });
+            other.join();
+
+            Assert::IsTrue(handler.m_Values.empty());
+            Assert::IsFalse(mailbox.isEmpty());
+
+            mailbox.drain();
+
+            Assert::IsTrue(handler.m_Values == std::vector<int>({1}));
+            Assert::IsTrue(handler.m_Threads.front() == std::this_thread::get_id());
+
+            // broadcasts on the owner thread itself are delivered right away
+            djinn::broadcast(ForOwner{2});
+            Assert::IsTrue(handler.m_Values.size() == 2);
+        }
+
+        TEST_METHOD(removed_before_drain) {
+            auto& mailbox = djinn::core::Mailbox::current();
+            mailbox.drain();
+
+            OwnedCollector<ForRemoved> handler;
+
+            std::thread other([] { djinn::broadcast(ForRemoved{1}); });
+            other.join();
+
+            djinn::remove_handler<ForRemoved>(&handler);
+
+            Assert::IsTrue(mailbox.drain() == 1);  // the letter is still there...
+            Assert::IsTrue(handler.m_Values.empty());  // ...but skips the handler
+
+            djinn::add_handler<ForRemoved>(&handler);  // the destructor removes it again
+        }
+
+        TEST_METHOD(posted_while_draining) {
+            djinn::core::Mailbox mailbox;
+
+            int numFirst  = 0;
+            int numSecond = 0;
+
+            mailbox.post([&] {
+                ++numFirst;
+                mailbox.post([&] { ++numSecond; });
+            });
+
+            Assert::IsTrue(mailbox.drain() == 1);
+            Assert::IsTrue(numFirst == 1);
+            Assert::IsTrue(numSecond == 0);
+            Assert::IsFalse(mailbox.isEmpty());
+
+            Assert::IsTrue(mailbox.drain() == 1);
+            Assert::IsTrue(numSecond == 1);
+            Assert::IsTrue(mailbox.isEmpty());
+        }
+
+        TEST_METHOD(replace_wakeup_while_posting) {
+            // every wakeup checks that its state is still alive; the state is 'destroyed' as
+            // soon as setWakeup() has replaced it (but kept around, so a late call can be detected)
+            struct State {
+                std::atomic_bool m_IsAlive = true;
+            };
+
+            djinn::core::Mailbox mailbox;
+
+            constexpr int k_NumPosts = 2000;
+
+            std::atomic_int numDone    = 0;
+            std::atomic_int numErrors  = 0;
+            std::atomic_int numWakeups = 0;
+
+            auto makeWakeup = [&](State* state) {
+                return [&, state] {
+                    // give setWakeup() a chance to return while this is still running
+                    bool isAlive = state->m_IsAlive;
+                    std::this_thread::sleep_for(std::chrono::microseconds(20));
+
+                    if (!isAlive || !state->m_IsAlive)
+                        ++numErrors;
+
+                    ++numWakeups;
+                };
+            };
+
+            std::vector<std::unique_ptr<State>> states;
+
+            states.push_back(std::make_unique<State>());
+            mailbox.setWakeup(makeWakeup(states.back().get()));
+
+            std::vector<std::thread> posters;
+
+            for (int i = 0; i < 4; ++i)
+                posters.emplace_back([&] {
+                    for (int j = 0; j < k_NumPosts; ++j)
+                        mailbox.post([] {});
+
+                    ++numDone;
+                });
+
+            while (numDone < 4) {
+                states.push_back(std::make_unique<State>());
+                mailbox.setWakeup(makeWakeup(states.back().get()));
+
+                states[states.size() - 2]->m_IsAlive = false;
+
+                mailbox.drain();
+                std::this_thread::yield();
+            }
+
+            for (auto& poster : posters)
+                poster.join();
+
+            mailbox.setWakeup(nullptr);
+            mailbox.drain();
+
+            Assert::IsTrue(numWakeups == 4 * k_NumPosts);
+            Assert::IsTrue(numErrors == 0);
+        }
+    };
+}
@@ -0,0 +1,205 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "core/mediator.h"
+
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace DjinnTest {
+    namespace {
+        // every message type has a single global queue, so each test uses its own types
+        struct Deferred {
+            int m_Value;
+        };
+
+        struct Batched {
+            int m_Value;
+        };
+
+        struct Broadcasted {
+            int m_Value;
+        };
+
+        struct First {
+            int m_Value;
+        };
+
+        struct Second {
+            int m_Value;
+        };
+
+        struct Removed {
+            int m_Value;
+        };
+
+        struct Latest {
+            int m_Value;
+        };
+
+        struct Summed {
+            int m_Value;
+        };
+
+        struct Lossless {
+            int m_Value;
+        };
+
+        template <typename T>
+        struct Collector: djinn::MessageHandler<T> {
+            void operator()(const T& message) override { m_Values.push_back(message.m_Value); }
+
+            std::vector<int> m_Values;
+        };
+
+        template <typename T>
+        struct BatchCollector: djinn::BatchMessageHandler<T> {
+            void operator()(absl::Span<const T> messages) override {
+                std::vector<int> batch;
+
+                for (const auto& message : messages)
+                    batch.push_back(message.m_Value);
+
+                m_Batches.push_back(batch);
+            }
+
+            std::vector<std::vector<int>> m_Batches;
+        };
+    }  // namespace
+}  // namespace DjinnTest
+
+namespace djinn {
+    template <>
+    struct MessagePolicy<DjinnTest::Latest> {
+        static constexpr eCoalescing k_Coalescing = eCoalescing::KEEP_LATEST;
+    };
+
+    template <>
+    struct MessagePolicy<DjinnTest::Summed> {
+        static constexpr eCoalescing k_Coalescing = eCoalescing::ACCUMULATE;
+
+        static void accumulate(DjinnTest::Summed& total, const DjinnTest::Summed& next) {
+            total.m_Value += next.m_Value;
+        }
+    };
+}  // namespace djinn
+
+namespace DjinnTest {
+    TEST_CLASS(Mediator) {
+    public:
+        TEST_METHOD(post_waits_for_dispatch) {
+            Collector<Deferred> handler;
+
+            djinn::post(Deferred{1});
+            djinn::post(Deferred{2});
+
+            Assert::IsTrue(handler.m_Values.empty());
+
+            djinn::dispatch<Deferred>();
+
+            Assert::IsTrue(handler.m_Values == std::vector<int>({1, 2}));
+
+            djinn::dispatch<Deferred>();  // nothing new
+            Assert::IsTrue(handler.m_Values.size() == 2);
+        }
+
+        TEST_METHOD(batch_handler_gets_one_span) {
+            BatchCollector<Batched> handler;
+
+            for (int i = 0; i < 5; ++i)
+                djinn::post(Batched{i});
+
+            djinn::dispatch<Batched>();
+
+            Assert::IsTrue(handler.m_Batches.size() == 1);
+            Assert::IsTrue(handler.m_Batches[0] == std::vector<int>({0, 1, 2, 3, 4}));
+        }
+
+        TEST_METHOD(broadcast_to_batch_handler) {
+            BatchCollector<Broadcasted> handler;
+
+            djinn::broadcast(Broadcasted{7});
+            djinn::broadcast(Broadcasted{8});
+
+            Assert::IsTrue(handler.m_Batches.size() == 2);
+            Assert::IsTrue(handler.m_Batches[0] == std::vector<int>({7}));
+            Assert::IsTrue(handler.m_Batches[1] == std::vector<int>({8}));
+        }
+
+        TEST_METHOD(dispatch_all_types) {
+            Collector<First>  first;
+            Collector<Second> second;
+
+            djinn::post(First{1});
+            djinn::post(Second{2});
+            djinn::post(First{3});
+
+            djinn::dispatch();
+
+            Assert::IsTrue(first.m_Values == std::vector<int>({1, 3}));
+            Assert::IsTrue(second.m_Values == std::vector<int>({2}));
+        }
+
+        TEST_METHOD(removed_handler_is_skipped) {
+            Collector<Removed> kept;
+            Collector<Removed> removed;
+
+            djinn::post(Removed{1});
+            djinn::remove_handler<Removed>(&removed);
+
+            djinn::dispatch<Removed>();
+
+            Assert::IsTrue(kept.m_Values == std::vector<int>({1}));
+            Assert::IsTrue(removed.m_Values.empty());
+
+            djinn::add_handler<Removed>(&removed);  // the destructor removes it again
+        }
+
+        TEST_METHOD(keep_latest) {
+            BatchCollector<Latest> handler;
+
+            djinn::post(Latest{1});
+            djinn::post(Latest{2});
+            djinn::post(Latest{3});
+
+            djinn::dispatch<Latest>();
+
+            Assert::IsTrue(handler.m_Batches.size() == 1);
+            Assert::IsTrue(handler.m_Batches[0] == std::vector<int>({3}));
+
+            // broadcasts are never coalesced
+            djinn::broadcast(Latest{4});
+            djinn::broadcast(Latest{5});
+
+            Assert::IsTrue(handler.m_Batches.size() == 3);
+        }
+
+        TEST_METHOD(accumulate) {
+            BatchCollector<Summed> handler;
+
+            for (int i = 1; i <= 4; ++i)
+                djinn::post(Summed{i});
+
+            djinn::dispatch<Summed>();
+
+            Assert::IsTrue(handler.m_Batches.size() == 1);
+            Assert::IsTrue(handler.m_Batches[0] == std::vector<int>({10}));
+        }
+
+        TEST_METHOD(keep_all_is_lossless) {
+            BatchCollector<Lossless> handler;
+
+            for (int i = 0; i < 1000; ++i)
+                djinn::post(Lossless{i});
+
+            djinn::dispatch<Lossless>();
+
+            Assert::IsTrue(handler.m_Batches.size() == 1);
+            Assert::IsTrue(handler.m_Batches[0].size() == 1000);
+
+            for (int i = 0; i < 1000; ++i)
+                Assert::IsTrue(handler.m_Batches[0][i] == i);
+        }
+    };
+}
@@ -0,0 +1,119 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "core/profile_zone.h"
+#include "util/string_util.h"
+
+#include <atomic>
+#include <cstring>
+#include <memory_resource>
+#include <thread>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace DjinnTest {
+    namespace {
+        size_t countZones(const std::vector<djinn::core::ZoneEvent>& timeline, const char* name) {
+            size_t result = 0;
+
+            for (const auto& evt : timeline)
+                if (std::strcmp(evt.m_Name, name) == 0)
+                    ++result;
+
+            return result;
+        }
+    }  // namespace
+
+    TEST_CLASS(ProfileZone) {
+    public:
+        TEST_METHOD(collects_from_exited_threads) {
+            auto& collector = djinn::core::ZoneCollector::instance();
+
+            collector.clear();
+            collector.setEnabled(true);
+
+            std::thread worker([] {
+                for (int i = 0; i < 10; ++i)
+                    djinn::core::ProfileZone zone("exited");
+            });
+
+            worker.join();
+
+            collector.collect();
+            collector.collect();  // the buffer is gone by now, nothing should be collected twice
+
+            Assert::IsTrue(countZones(collector.getTimeline(), "exited") == 10);
+
+            collector.setEnabled(false);
+            collector.clear();
+        }
+
+        TEST_METHOD(collects_while_recording) {
+            auto& collector = djinn::core::ZoneCollector::instance();
+
+            collector.clear();
+            collector.setEnabled(true);
+
+            constexpr int k_NumZones = 2000;
+
+            std::atomic_int numDone = 0;
+
+            std::vector<std::thread> workers;
+
+            for (int t = 0; t < 4; ++t)
+                workers.emplace_back([&] {
+                    for (int i = 0; i < k_NumZones; ++i) {
+                        djinn::core::ProfileZone zone("busy");
+
+                        // don't fill up the buffer faster than it is drained
+                        if (i % 512 == 0)
+                            std::this_thread::yield();
+                    }
+
+                    ++numDone;
+                });
+
+            while (numDone < 4)
+                collector.collect();
+
+            for (auto& worker : workers)
+                worker.join();
+
+            collector.collect();
+
+            auto timeline = collector.getTimeline();
+
+            Assert::IsTrue(countZones(timeline, "busy") + collector.getNumDropped() == 4 * k_NumZones);
+
+            for (size_t i = 1; i < timeline.size(); ++i)
+                Assert::IsTrue(timeline[i - 1].m_Begin <= timeline[i].m_Begin);
+
+            collector.setEnabled(false);
+            collector.clear();
+        }
+
+        TEST_METHOD(zones_in_util) {
+            auto& collector = djinn::core::ZoneCollector::instance();
+
+            collector.clear();
+            collector.setEnabled(true);
+
+            djinn::util::split("a,b,c", ',');
+            djinn::util::split("a,b,c", ',', std::pmr::new_delete_resource());
+
+            collector.collect();
+
+#if DJINN_PROFILING
+            // the overloads can be told apart
+            Assert::IsTrue(countZones(collector.getTimeline(), "util::split") == 1);
+            Assert::IsTrue(countZones(collector.getTimeline(), "util::split (pmr)") == 1);
+#else
+            Assert::IsTrue(collector.getTimeline().empty());
+#endif
+
+            collector.setEnabled(false);
+            collector.clear();
+        }
+    };
+}
@@ -0,0 +1,146 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "core/profiler.h"
+
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace DjinnTest {
+    namespace {
+        using ePhase = djinn::core::Profiler::ePhase;
+    }  // namespace
+
+    TEST_CLASS(Profiler) {
+    public:
+        TEST_METHOD(disabled) {
+            djinn::core::Profiler profiler;
+
+            bool isCalled = false;
+
+            profiler.beginFrame(0);
+            profiler.measure("system", ePhase::UPDATE, [&] { isCalled = true; });
+            profiler.endFrame();
+
+            Assert::IsTrue(isCalled);
+            Assert::IsTrue(profiler.getNames().empty());
+        }
+
+        TEST_METHOD(samples_from_threads) {
+            constexpr int k_NumThreads = 4;
+            constexpr int k_NumFrames  = 50;
+
+            djinn::core::Profiler profiler(100);
+            profiler.setEnabled(true);
+
+            profiler.measure("init", ePhase::INIT, [] {});
+
+            for (int f = 0; f < k_NumFrames; ++f) {
+                profiler.beginFrame(f);
+
+                // [NOTE] new threads every frame, so buffers of exited threads are drained as well
+                std::vector<std::thread> threads;
+
+                for (int t = 0; t < k_NumThreads; ++t)
+                    threads.emplace_back([&profiler, t] {
+                        auto name = "system" + std::to_string(t);
+
+                        profiler.measure(name, ePhase::UPDATE, [] {});
+                        profiler.measure(name, ePhase::UPDATE, [] {});  // summed within the frame
+                    });
+
+                profiler.measure("main", ePhase::FIXED_UPDATE, [] {});
+
+                for (auto& thread : threads)
+                    thread.join();
+
+                profiler.endFrame();
+            }
+
+            for (int t = 0; t < k_NumThreads; ++t)
+                Assert::IsTrue(profiler.getStatistics("system" + std::to_string(t)).m_NumSamples == k_NumFrames);
+
+            Assert::IsTrue(profiler.getStatistics("main", ePhase::FIXED_UPDATE).m_NumSamples == k_NumFrames);
+            Assert::IsTrue(profiler.getStatistics("init", ePhase::INIT).m_NumSamples == 1);
+            Assert::IsTrue(profiler.getFrameStatistics().m_NumSamples == k_NumFrames);
+            Assert::IsTrue(profiler.getNumDropped() == 0);
+
+            profiler.setEnabled(false);
+        }
+
+        TEST_METHOD(late_samples_count_towards_next_frame) {
+            djinn::core::Profiler profiler;
+            profiler.setEnabled(true);
+
+            profiler.beginFrame(0);
+            profiler.measure("x", ePhase::UPDATE, [] {});
+            profiler.endFrame();
+
+            profiler.measure("x", ePhase::UPDATE, [] {});  // in between frames
+            Assert::IsTrue(profiler.getStatistics("x").m_NumSamples == 1);
+
+            profiler.beginFrame(1);
+            profiler.endFrame();
+
+            Assert::IsTrue(profiler.getStatistics("x").m_NumSamples == 2);
+            Assert::IsTrue(profiler.getStatistics("x", ePhase::INIT).m_NumSamples == 0);
+
+            profiler.setEnabled(false);
+        }
+
+        TEST_METHOD(p99_is_nearest_rank) {
+            djinn::core::Profiler profiler(100);
+            profiler.setEnabled(true);
+
+            auto begin = djinn::core::Profiler::Clock::now();
+
+            // 1..100 ms
+            for (int f = 0; f < 100; ++f) {
+                profiler.beginFrame(f);
+                profiler.record("x", ePhase::UPDATE, begin, begin + std::chrono::milliseconds(f + 1));
+                profiler.endFrame();
+            }
+
+            auto stats = profiler.getStatistics("x");
+
+            Assert::IsTrue(stats.m_NumSamples == 100);
+            Assert::IsTrue(std::abs(stats.m_P99 - 99.0) < 1e-6);
+            Assert::IsTrue(std::abs(stats.m_Max - 100.0) < 1e-6);
+
+            profiler.setEnabled(false);
+        }
+
+        TEST_METHOD(separate_profilers) {
+            djinn::core::Profiler a;
+            djinn::core::Profiler b;
+
+            a.setEnabled(true);
+            b.setEnabled(true);
+
+            for (int f = 0; f < 10; ++f) {
+                a.beginFrame(f);
+                b.beginFrame(f);
+
+                // the same thread alternates between both
+                a.measure("x", ePhase::UPDATE, [] {});
+                b.measure("y", ePhase::UPDATE, [] {});
+                a.measure("x", ePhase::UPDATE, [] {});
+
+                a.endFrame();
+                b.endFrame();
+            }
+
+            Assert::IsTrue(a.getStatistics("x").m_NumSamples == 10);
+            Assert::IsTrue(a.getStatistics("y").m_NumSamples == 0);
+            Assert::IsTrue(b.getStatistics("y").m_NumSamples == 10);
+
+            a.setEnabled(false);
+            b.setEnabled(false);
+        }
+    };
+}
@@ -0,0 +1,227 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "core/dependency_graph.h"
+#include "core/system.h"
+#include "core/system_scheduler.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace DjinnTest {
+    namespace {
+        class TestSystem: public djinn::core::System {
+        public:
+            TestSystem(const std::string& name, const std::vector<std::string>& dependencies, bool isMainOnly = false):
+                System(name) {
+                for (const auto& dep : dependencies)
+                    addDependency(dep);
+
+                if (isMainOnly)
+                    setThreadAffinity(eThreadAffinity::MAIN);
+            }
+        };
+
+        struct Systems {
+            void add(const std::string& name, const std::vector<std::string>& dependencies = {}, bool isMainOnly = false) {
+                m_Storage.push_back(std::make_unique<TestSystem>(name, dependencies, isMainOnly));
+                m_Pointers.push_back(m_Storage.back().get());
+            }
+
+            std::vector<std::unique_ptr<TestSystem>> m_Storage;
+            std::vector<djinn::core::System*>        m_Pointers;
+        };
+    }  // namespace
+
+    TEST_CLASS(SystemScheduler) {
+    public:
+        TEST_METHOD(dependencies_come_first) {
+            Systems systems;
+            systems.add("a");
+            systems.add("b", {"a"});
+            systems.add("c", {"a"});
+            systems.add("d", {"b", "c"});
+
+            djinn::core::SystemScheduler scheduler(3);
+            scheduler.build(djinn::core::DependencyGraph(systems.m_Pointers));
+
+            Assert::IsTrue(scheduler.getNumSystems() == 4);
+
+            for (int repeat = 0; repeat < 100; ++repeat) {
+                std::mutex               mutex;
+                std::vector<std::string> order;
+
+                scheduler.execute([&](djinn::core::System* system) {
+                    std::lock_guard<std::mutex> guard(mutex);
+                    order.push_back(system->getName());
+                });
+
+                Assert::IsTrue(order.size() == 4);
+                Assert::IsTrue(order.front() == "a");
+                Assert::IsTrue(order.back() == "d");
+            }
+        }
+
+        TEST_METHOD(independent_systems_overlap) {
+            Systems systems;
+            systems.add("a");
+            systems.add("b");
+            systems.add("c");
+
+            djinn::core::SystemScheduler scheduler(2);
+            scheduler.build(djinn::core::DependencyGraph(systems.m_Pointers));
+
+            std::atomic_int numActive = 0;
+            std::atomic_int maxActive = 0;
+
+            scheduler.execute([&](djinn::core::System*) {
+                int active = ++numActive;
+
+                int previous = maxActive;
+                while ((active > previous) && !maxActive.compare_exchange_weak(previous, active))
+                    ;
+
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                --numActive;
+            });
+
+            Assert::IsTrue(maxActive > 1);
+        }
+
+        TEST_METHOD(main_affinity) {
+            Systems systems;
+            systems.add("worker");
+            systems.add("main", {"worker"}, true);
+
+            djinn::core::SystemScheduler scheduler(2);
+            scheduler.build(djinn::core::DependencyGraph(systems.m_Pointers));
+
+            auto            caller = std::this_thread::get_id();
+            std::thread::id mainThread;
+
+            for (int repeat = 0; repeat < 20; ++repeat) {
+                scheduler.execute([&](djinn::core::System* system) {
+                    if (system->getName() == "main")
+                        mainThread = std::this_thread::get_id();
+                });
+
+                Assert::IsTrue(mainThread == caller);
+            }
+        }
+
+        TEST_METHOD(exceptions_are_rethrown) {
+            Systems systems;
+            systems.add("a");
+            systems.add("b", {"a"});
+            systems.add("c");
+
+            djinn::core::SystemScheduler scheduler(2);
+            scheduler.build(djinn::core::DependencyGraph(systems.m_Pointers));
+
+            std::atomic_int numCalls = 0;
+            bool            isThrown = false;
+
+            try {
+                scheduler.execute([&](djinn::core::System* system) {
+                    ++numCalls;
+
+                    if (system->getName() == "a")
+                        throw std::runtime_error("failed");
+                });
+            }
+            catch (const std::runtime_error&) {
+                isThrown = true;
+            }
+
+            Assert::IsTrue(isThrown);
+            Assert::IsTrue(numCalls == 3);  // the others are still processed
+        }
+
+        TEST_METHOD(without_workers) {
+            Systems systems;
+            systems.add("a");
+            systems.add("b", {"a"});
+
+            djinn::core::SystemScheduler scheduler(0);
+            scheduler.build(djinn::core::DependencyGraph(systems.m_Pointers));
+
+            auto caller     = std::this_thread::get_id();
+            bool isOnCaller = true;
+
+            scheduler.execute([&](djinn::core::System*) {
+                if (std::this_thread::get_id() != caller)
+                    isOnCaller = false;
+            });
+
+            Assert::IsTrue(isOnCaller);
+        }
+
+        TEST_METHOD(set_num_workers) {
+            Systems systems;
+            systems.add("a");
+            systems.add("b");
+
+            djinn::core::SystemScheduler scheduler(0);
+            scheduler.build(djinn::core::DependencyGraph(systems.m_Pointers));
+
+            scheduler.setNumWorkers(3);
+            Assert::IsTrue(scheduler.getNumWorkers() == 3);
+
+            auto            caller       = std::this_thread::get_id();
+            std::atomic_int numOnWorkers = 0;
+
+            scheduler.execute([&](djinn::core::System*) {
+                if (std::this_thread::get_id() != caller)
+                    ++numOnWorkers;
+
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            });
+
+            Assert::IsTrue(numOnWorkers > 0);
+
+            scheduler.setNumWorkers(0);
+            Assert::IsTrue(scheduler.getNumWorkers() == 0);
+
+            numOnWorkers = 0;
+
+            scheduler.execute([&](djinn::core::System*) {
+                if (std::this_thread::get_id() != caller)
+                    ++numOnWorkers;
+            });
+
+            Assert::IsTrue(numOnWorkers == 0);
+        }
+
+        TEST_METHOD(idle_task) {
+            djinn::core::SystemScheduler scheduler(2);
+
+            std::atomic_int numCalls = 0;
+            std::atomic_int index    = -1;
+
+            scheduler.setIdleTask([&] {
+                index = scheduler.getCurrentWorkerIndex();
+                ++numCalls;
+            });
+
+            for (int i = 0; i < 10; ++i)
+                scheduler.notifyIdleTask();
+
+            while (numCalls < 10)
+                std::this_thread::yield();
+
+            scheduler.setIdleTask(nullptr);  // waits for the workers to finish with it
+
+            Assert::IsTrue(numCalls == 10);
+            Assert::IsTrue((index == 0) || (index == 1));
+            Assert::IsTrue(scheduler.getCurrentWorkerIndex() == -1);
+        }
+    };
+}
@@ -0,0 +1,151 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "input/input_record.h"
+
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace DjinnTest {
+    TEST_CLASS(InputRecord) {
+    public:
+        TEST_METHOD(headers) {
+            using namespace djinn::input::record;
+
+            std::vector<uint8_t> buffer;
+
+            FileHeader file;
+            std::memcpy(file.m_Magic, k_Magic, sizeof(k_Magic));
+            file.m_Version = k_Version;
+
+            RecordHeader record;
+            record.m_Frame     = 12345678901ull;
+            record.m_Timestamp = 42;
+            record.m_Type      = eEventType::MOUSE_SCROLL;
+            record.m_Size      = 7;
+
+            append(buffer, file);
+            append(buffer, record);
+
+            // no padding
+            Assert::IsTrue(buffer.size() == k_FileHeaderSize + k_RecordHeaderSize);
+
+            const uint8_t* cursor = buffer.data();
+            const uint8_t* end    = cursor + buffer.size();
+
+            FileHeader   fileCopy;
+            RecordHeader recordCopy;
+
+            Assert::IsTrue(extract(cursor, end, fileCopy));
+            Assert::IsTrue(std::memcmp(fileCopy.m_Magic, k_Magic, sizeof(k_Magic)) == 0);
+            Assert::IsTrue(fileCopy.m_Version == k_Version);
+
+            Assert::IsTrue(extract(cursor, end, recordCopy));
+            Assert::IsTrue(recordCopy.m_Frame == record.m_Frame);
+            Assert::IsTrue(recordCopy.m_Timestamp == record.m_Timestamp);
+            Assert::IsTrue(recordCopy.m_Type == record.m_Type);
+            Assert::IsTrue(recordCopy.m_Size == record.m_Size);
+
+            Assert::IsTrue(cursor == end);
+            Assert::IsFalse(extract(cursor, end, recordCopy));  // nothing left
+        }
+
+        TEST_METHOD(truncated) {
+            using namespace djinn::input::record;
+
+            std::vector<uint8_t> buffer;
+
+            RecordHeader record = {1, 2, eEventType::KEY_PRESSED, 3};
+            append(buffer, record);
+            buffer.pop_back();
+
+            const uint8_t* cursor = buffer.data();
+            const uint8_t* end    = cursor + buffer.size();
+
+            Assert::IsFalse(extract(cursor, end, record));
+
+            djinn::input::Mouse::OnMoved moved = {};
+
+            buffer.clear();
+            EventTraits<djinn::input::Mouse::OnMoved>::write(buffer, moved);
+
+            Assert::IsFalse(EventTraits<djinn::input::Mouse::OnMoved>::read(buffer.data(), buffer.data() + buffer.size() - 1, moved));
+        }
+
+        TEST_METHOD(keyboard_events) {
+            using namespace djinn::input;
+            using namespace djinn::input::record;
+
+            std::vector<uint8_t> buffer;
+
+            Keyboard::OnKeyPressed  pressed  = {nullptr, Keyboard::eKey::c};
+            Keyboard::OnKeyReleased released = {nullptr, Keyboard::eKey::a};
+
+            EventTraits<Keyboard::OnKeyPressed>::write(buffer, pressed);
+            size_t split = buffer.size();
+            EventTraits<Keyboard::OnKeyReleased>::write(buffer, released);
+
+            Keyboard::OnKeyPressed  pressedCopy  = {};
+            Keyboard::OnKeyReleased releasedCopy = {};
+
+            Assert::IsTrue(EventTraits<Keyboard::OnKeyPressed>::read(buffer.data(), buffer.data() + split, pressedCopy));
+            Assert::IsTrue(EventTraits<Keyboard::OnKeyReleased>::read(buffer.data() + split, buffer.data() + buffer.size(), releasedCopy));
+
+            Assert::IsTrue(pressedCopy.key == Keyboard::eKey::c);
+            Assert::IsTrue(releasedCopy.key == Keyboard::eKey::a);
+        }
+
+        TEST_METHOD(mouse_events) {
+            using namespace djinn::input;
+            using namespace djinn::input::record;
+
+            Mouse::OnMoved          moved    = {nullptr, 1.5f, 2.5f, -3.0f, 4.0f};
+            Mouse::OnButtonPressed  pressed  = {nullptr, 5.0f, 6.0f, Mouse::eButton::right};
+            Mouse::OnButtonReleased released = {nullptr, 7.0f, 8.0f, Mouse::eButton::middle};
+            Mouse::OnDoubleClick    click    = {nullptr, 9.0f, 10.0f, Mouse::eButton::left};
+            Mouse::OnScroll         scroll   = {nullptr, -3};
+
+            auto roundTrip = [](const auto& evt) {
+                using T = std::decay_t<decltype(evt)>;
+
+                std::vector<uint8_t> buffer;
+                EventTraits<T>::write(buffer, evt);
+
+                T result = {};
+                Assert::IsTrue(EventTraits<T>::read(buffer.data(), buffer.data() + buffer.size(), result));
+
+                return result;
+            };
+
+            auto movedCopy = roundTrip(moved);
+            Assert::IsTrue(movedCopy.m_X == 1.5f);
+            Assert::IsTrue(movedCopy.m_Y == 2.5f);
+            Assert::IsTrue(movedCopy.m_DeltaX == -3.0f);
+            Assert::IsTrue(movedCopy.m_DeltaY == 4.0f);
+
+            auto pressedCopy = roundTrip(pressed);
+            Assert::IsTrue(pressedCopy.m_X == 5.0f);
+            Assert::IsTrue(pressedCopy.m_Y == 6.0f);
+            Assert::IsTrue(pressedCopy.m_Button == Mouse::eButton::right);
+
+            auto releasedCopy = roundTrip(released);
+            Assert::IsTrue(releasedCopy.m_X == 7.0f);
+            Assert::IsTrue(releasedCopy.m_Y == 8.0f);
+            Assert::IsTrue(releasedCopy.m_Button == Mouse::eButton::middle);
+
+            auto clickCopy = roundTrip(click);
+            Assert::IsTrue(clickCopy.m_X == 9.0f);
+            Assert::IsTrue(clickCopy.m_Y == 10.0f);
+            Assert::IsTrue(clickCopy.m_Button == Mouse::eButton::left);
+
+            auto scrollCopy = roundTrip(scroll);
+            Assert::IsTrue(scrollCopy.m_ScrollAmount == -3);
+
+            // the device pointers are never stored
+            Assert::IsTrue(scrollCopy.m_Mouse == nullptr);
+        }
+    };
+}
@@ -0,0 +1,85 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "core/mediator.h"
+#include "input/input.h"
+#include "input/mouse.h"
+
+#include <string>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace DjinnTest {
+    namespace {
+        using djinn::input::Mouse;
+
+        // records every mouse event in the order it arrives
+        struct MouseLog:
+            djinn::MessageHandler<Mouse::OnMoved>,
+            djinn::MessageHandler<Mouse::OnScroll>,
+            djinn::MessageHandler<Mouse::OnButtonPressed> {
+            void operator()(const Mouse::OnMoved& evt) override {
+                m_Events.push_back("moved");
+                m_Moves.push_back(evt);
+            }
+
+            void operator()(const Mouse::OnScroll& evt) override {
+                m_Events.push_back("scroll");
+                m_Scrolls.push_back(evt);
+            }
+
+            void operator()(const Mouse::OnButtonPressed&) override { m_Events.push_back("pressed"); }
+
+            std::vector<std::string>     m_Events;
+            std::vector<Mouse::OnMoved>  m_Moves;
+            std::vector<Mouse::OnScroll> m_Scrolls;
+        };
+    }  // namespace
+
+    TEST_CLASS(MouseCoalescing) {
+    public:
+        TEST_METHOD(accumulates_per_dispatch) {
+            djinn::Input        input;
+            djinn::input::Mouse mouse(&input);
+            MouseLog            log;
+
+            mouse.setPosition(0.1f, 0.2f);
+            mouse.setPosition(0.3f, 0.1f);
+            mouse.setPosition(0.5f, 0.5f);
+
+            mouse.doScroll(1);
+            mouse.doScroll(2);
+            mouse.doScroll(-4);
+
+            Assert::IsTrue(log.m_Events.empty());  // posted, nothing happens until dispatch
+
+            djinn::dispatch();
+
+            Assert::IsTrue(log.m_Moves.size() == 1);
+            Assert::IsTrue(log.m_Moves[0].m_X == 0.5f);
+            Assert::IsTrue(log.m_Moves[0].m_Y == 0.5f);
+            Assert::IsTrue(log.m_Moves[0].m_DeltaX == 0.5f);  // summed, relative to the start
+            Assert::IsTrue(log.m_Moves[0].m_DeltaY == 0.5f);
+
+            Assert::IsTrue(log.m_Scrolls.size() == 1);
+            Assert::IsTrue(log.m_Scrolls[0].m_ScrollAmount == -1);
+        }
+
+        TEST_METHOD(flushes_before_buttons) {
+            djinn::Input        input;
+            djinn::input::Mouse mouse(&input);
+            MouseLog            log;
+
+            mouse.setPosition(0.25f, 0.75f);
+            mouse.setButtonState(djinn::input::Mouse::eButton::left, true);
+
+            // the movement happened first, so it is delivered first
+            Assert::IsTrue(log.m_Events == std::vector<std::string>({"moved", "pressed"}));
+            Assert::IsTrue(log.m_Moves[0].m_X == 0.25f);
+
+            djinn::dispatch();
+            Assert::IsTrue(log.m_Events.size() == 2);  // nothing left to deliver
+        }
+    };
+}
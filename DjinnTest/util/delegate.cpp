@@ -0,0 +1,96 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "util/delegate.h"
+
+#include <type_traits>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace {
+    struct Accumulator {
+        void add(int x) {
+            m_Total += x;
+        }
+
+        // same body as add(), so the linker may fold the two
+        void increase(int x) {
+            m_Total += x;
+        }
+
+        int operator()(int x) const {
+            return m_Total + x;
+        }
+
+        int m_Total = 0;
+    };
+
+    int twice(int x) {
+        return x * 2;
+    }
+}  // namespace
+
+namespace DjinnTest {
+    TEST_CLASS(Delegate) {
+    public:
+        TEST_METHOD(member_function) {
+            using djinn::util::Delegate;
+
+            Accumulator acc;
+
+            auto d = Delegate<void(int)>::bind<&Accumulator::add>(&acc);
+
+            d(3);
+            d(4);
+
+            Assert::IsTrue(acc.m_Total == 7);
+            Assert::IsTrue(d.getObject() == &acc);
+        }
+
+        TEST_METHOD(functor) {
+            using djinn::util::Delegate;
+
+            Accumulator acc;
+            acc.m_Total = 10;
+
+            auto d = Delegate<int(int)>::bind(&acc);
+
+            Assert::IsTrue(d(5) == 15);
+        }
+
+        TEST_METHOD(free_function) {
+            using djinn::util::Delegate;
+
+            auto d = Delegate<int(int)>::bind<&twice>();
+
+            Assert::IsTrue(d(21) == 42);
+        }
+
+        TEST_METHOD(comparison) {
+            using djinn::util::Delegate;
+
+            Accumulator a;
+            Accumulator b;
+
+            Delegate<void(int)> empty;
+
+            auto da = Delegate<void(int)>::bind<&Accumulator::add>(&a);
+            auto db = Delegate<void(int)>::bind<&Accumulator::add>(&b);
+
+            Assert::IsFalse(static_cast<bool>(empty));
+            Assert::IsTrue(static_cast<bool>(da));
+
+            Assert::IsTrue(da == Delegate<void(int)>::bind<&Accumulator::add>(&a));
+            Assert::IsTrue(da != db);
+            Assert::IsTrue(da != empty);
+
+            // different member functions never compare equal, even if their code is identical
+            auto di = Delegate<void(int)>::bind<&Accumulator::increase>(&a);
+
+            Assert::IsTrue(da != di);
+            Assert::IsTrue(da.getIdentity() != di.getIdentity());
+
+            static_assert(std::is_trivially_copyable_v<Delegate<void(int)>>);
+        }
+    };
+}
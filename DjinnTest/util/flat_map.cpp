@@ -4,7 +4,12 @@
 #include "util/flat_map.h"
 #include "../indicator.h"
 
+#include <algorithm>
+#include <cctype>
 #include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
@@ -93,5 +98,244 @@ namespace DjinnTest {
             Assert::IsTrue(key_sum = 1 + 2 + 3 + 4);
             Assert::IsTrue(value_sum = 2.3 + 4.5 + 6.7 + 8.9);
         }
+
+        TEST_METHOD(range_construction) {
+            using djinn::util::eDuplicatePolicy;
+            using djinn::util::FlatMap;
+
+            std::vector<std::pair<int, int>> values = {{5, 1}, {3, 2}, {9, 3}, {3, 4}, {1, 5}};
+
+            FlatMap<int, int> last(values.begin(), values.end());
+            FlatMap<int, int> first(values.begin(), values.end(), eDuplicatePolicy::KEEP_FIRST);
+
+            Assert::IsTrue(last.size() == 4);
+            Assert::IsTrue(std::is_sorted(last.getKeys().cbegin(), last.getKeys().cend()));
+            Assert::IsTrue(*last[3] == 4);
+            Assert::IsTrue(*first[3] == 2);
+            Assert::IsTrue(*first[9] == 3);
+
+            FlatMap<std::string, int> fm = {{"b", 2}, {"a", 1}, {"c", 3}};
+
+            Assert::IsTrue(fm.size() == 3);
+            Assert::IsTrue(fm.getKeys().front() == "a");
+            Assert::IsTrue(fm.getKeys().back() == "c");
+        }
+
+        TEST_METHOD(insert_range_merge) {
+            using djinn::util::eDuplicatePolicy;
+            using djinn::util::FlatMap;
+
+            FlatMap<int, int> fm = {{2, 20}, {4, 40}, {6, 60}};
+
+            std::vector<std::pair<int, int>> more = {{5, 50}, {4, 41}, {1, 10}};
+
+            fm.insert_range(more.begin(), more.end(), eDuplicatePolicy::KEEP_FIRST);
+
+            Assert::IsTrue(fm.size() == 5);
+            Assert::IsTrue(*fm[4] == 40);  // existing entries win
+            Assert::IsTrue(*fm[1] == 10);
+            Assert::IsTrue(std::is_sorted(fm.getKeys().cbegin(), fm.getKeys().cend()));
+
+            FlatMap<int, int> other = {{4, 42}, {7, 70}};
+
+            fm.merge(other);
+
+            Assert::IsTrue(fm.size() == 6);
+            Assert::IsTrue(*fm[4] == 42);
+            Assert::IsTrue(*fm[7] == 70);
+            Assert::IsTrue(other.size() == 2);
+
+            fm.merge(std::move(other), eDuplicatePolicy::KEEP_FIRST);
+            Assert::IsTrue(*fm[4] == 42);
+
+            // merging into itself changes nothing
+            fm.merge(fm);
+            fm.merge(std::move(fm));
+
+            Assert::IsTrue(fm.size() == 6);
+            Assert::IsTrue(*fm[7] == 70);
+
+            // large unsorted input
+            std::vector<std::pair<int, int>> shuffled;
+
+            for (int i = 0; i < 10000; ++i)
+                shuffled.emplace_back((i * 7919) % 10000, i);
+
+            FlatMap<int, int> big(shuffled.begin(), shuffled.end());
+
+            Assert::IsTrue(big.size() == 10000);
+            Assert::IsTrue(std::is_sorted(big.getKeys().cbegin(), big.getKeys().cend()));
+            Assert::IsTrue(*big[7919] == 1);
+        }
+
+        TEST_METHOD(missing_keys) {
+            using djinn::util::FlatMap;
+
+            FlatMap<int, int> fm = {{10, 1}, {20, 2}, {30, 3}};
+
+            // lookups between existing keys should not yield the next entry
+            Assert::IsTrue(fm[15] == nullptr);
+            Assert::IsTrue(fm[5] == nullptr);
+            Assert::IsTrue(fm[35] == nullptr);
+            Assert::IsFalse(fm.contains(25));
+            Assert::IsTrue(fm.find(25) == fm.end());
+
+            fm.erase(15);
+            Assert::IsTrue(fm.size() == 3);
+            Assert::IsTrue(*fm[20] == 2);
+
+            fm.erase(20);
+            Assert::IsTrue(fm.size() == 2);
+            Assert::IsTrue(fm[20] == nullptr);
+        }
+
+        TEST_METHOD(iterators) {
+            using djinn::util::FlatMap;
+
+            FlatMap<int, int> fm = {{3, 30}, {1, 10}, {2, 20}};
+
+            int key_sum = 0;
+
+            for (auto [key, value] : fm) {
+                key_sum += key;
+                value *= 2;  // modifies the value in the map
+            }
+
+            Assert::IsTrue(key_sum == 6);
+            Assert::IsTrue(*fm[2] == 40);
+
+            Assert::IsTrue(std::distance(fm.begin(), fm.end()) == 3);
+            Assert::IsTrue((fm.end() - 1)->first == 3);
+            Assert::IsTrue(fm.begin()[1].second == 40);
+
+            auto it = std::find_if(fm.cbegin(), fm.cend(), [](const auto& entry) { return entry.second == 60; });
+
+            Assert::IsTrue(it != fm.cend());
+            Assert::IsTrue(it.key() == 3);
+
+            const auto& cfm = fm;
+            FlatMap<int, int>::const_iterator cit = fm.find(1);
+
+            Assert::IsTrue(cit == cfm.begin());
+            Assert::IsTrue(std::count_if(cfm.begin(), cfm.end(), [](const auto& entry) { return entry.first > 1; }) == 2);
+        }
+
+        TEST_METHOD(heterogeneous_lookup) {
+            using djinn::util::FlatMap;
+
+            FlatMap<std::string, int, std::less<>> fm = {{"alpha", 1}, {"beta", 2}, {"gamma", 3}};
+
+            std::string_view key = "beta";
+
+            Assert::IsTrue(*fm[key] == 2);
+            Assert::IsTrue(fm.contains("gamma"));
+            Assert::IsFalse(fm.contains(std::string_view("delta")));
+            Assert::IsTrue(fm.find(key)->second == 2);
+            Assert::IsTrue(fm.find("zeta") == fm.end());
+        }
+
+        TEST_METHOD(custom_compare) {
+            using djinn::util::FlatMap;
+
+            FlatMap<int, int, std::greater<int>> fm;
+
+            fm.assign(1, 10);
+            fm.assign(3, 30);
+            fm.assign(2, 20);
+
+            Assert::IsTrue(fm.getKeys().front() == 3);
+            Assert::IsTrue(fm.getKeys().back() == 1);
+            Assert::IsTrue(*fm[2] == 20);
+            Assert::IsTrue(fm[4] == nullptr);
+
+            // case insensitive keys
+            struct CaseInsensitive {
+                bool operator()(const std::string& a, const std::string& b) const {
+                    return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(), [](char x, char y) {
+                        return std::tolower(x) < std::tolower(y);
+                    });
+                }
+            };
+
+            FlatMap<std::string, int, CaseInsensitive> names;
+
+            names.assign("Hello", 1);
+            names.assign("HELLO", 2);
+
+            Assert::IsTrue(names.size() == 1);
+            Assert::IsTrue(*names["hello"] == 2);
+        }
+
+        TEST_METHOD(reserve_shrink) {
+            using djinn::util::FlatMap;
+
+            FlatMap<int, int> fm;
+
+            fm.reserve(100);
+            Assert::IsTrue(fm.capacity() >= 100);
+
+            fm.assign(1, 2);
+            fm.shrink_to_fit();
+
+            Assert::IsTrue(fm.capacity() >= fm.size());
+            Assert::IsTrue(*fm[1] == 2);
+        }
+
+        TEST_METHOD(freeze) {
+            using djinn::util::FlatMap;
+
+            // various sizes, to get both full and partial trees (and the linear search for the small ones)
+            for (int count : {1, 2, 3, 7, 8, 31, 32, 33, 100, 1000, 4097}) {
+                FlatMap<int, int> fm;
+
+                for (int i = 0; i < count; ++i)
+                    fm.assign(i * 2, i);
+
+                fm.freeze();
+                Assert::IsTrue(fm.isFrozen());
+
+                for (int i = -2; i <= count * 2; ++i) {
+                    auto value = fm[i];
+
+                    if ((i >= 0) && (i < count * 2) && (i % 2 == 0))
+                        Assert::IsTrue(value && (*value == i / 2));
+                    else
+                        Assert::IsTrue(value == nullptr);
+                }
+            }
+
+            // modifying values is fine, adding or removing keys unfreezes
+            FlatMap<std::string, int> names = {{"one", 1}, {"two", 2}, {"three", 3}};
+
+            names.freeze();
+            names.assign("two", 22);
+
+            Assert::IsTrue(names.isFrozen());
+            Assert::IsTrue(*names["two"] == 22);
+            Assert::IsTrue(names["four"] == nullptr);
+
+            names.assign("four", 4);
+
+            Assert::IsTrue(!names.isFrozen());
+            Assert::IsTrue(*names["four"] == 4);
+
+            names.freeze();
+            names.erase("one");
+
+            Assert::IsTrue(!names.isFrozen());
+            Assert::IsTrue(!names.contains("one"));
+
+            // unsigned keys close to the top of the range, and negative keys
+            FlatMap<uint32_t, int> large = {{1u, 1}, {0x7FFFFFFFu, 2}, {0x80000000u, 3}, {0xFFFFFFFFu, 4}};
+            FlatMap<int32_t, int>  signs = {{-100, 1}, {-1, 2}, {0, 3}, {5, 4}, {1000, 5}};
+
+            Assert::IsTrue(*large[0x80000000u] == 3);
+            Assert::IsTrue(*large[0xFFFFFFFFu] == 4);
+            Assert::IsTrue(large[0x80000001u] == nullptr);
+            Assert::IsTrue(*signs[-100] == 1);
+            Assert::IsTrue(*signs[-1] == 2);
+            Assert::IsTrue(signs[-2] == nullptr);
+            Assert::IsTrue(*signs[1000] == 5);
+        }
     };
 }
\ No newline at end of file
@@ -0,0 +1,134 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "util/frame_arena.h"
+#include "util/string_util.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace DjinnTest {
+    TEST_CLASS(FrameArena) {
+    public:
+        TEST_METHOD(alignment) {
+            djinn::util::FrameArena arena(1024);
+
+            Assert::IsTrue(arena.allocate(1, 1) != nullptr);
+
+            for (size_t alignment : {2, 4, 8, 16, 32, 64}) {
+                auto* ptr = arena.allocate(3, alignment);
+                Assert::IsTrue(reinterpret_cast<uintptr_t>(ptr) % alignment == 0);
+            }
+
+            Assert::IsTrue(arena.getNumOverflows() == 0);
+        }
+
+        TEST_METHOD(reuse) {
+            djinn::util::FrameArena arena(256, 2);
+
+            auto* a = arena.allocate(64);
+            arena.nextFrame();
+            auto* b = arena.allocate(64);
+            arena.nextFrame();
+            auto* c = arena.allocate(64);
+
+            // double buffered, so the third frame reuses the memory of the first one
+            Assert::IsTrue(a != b);
+            Assert::IsTrue(a == c);
+            Assert::IsTrue(arena.getBytesUsed() == 64);
+        }
+
+        TEST_METHOD(overflow) {
+            djinn::util::FrameArena arena(128, 2);
+
+            auto* a = arena.allocate(100);
+            auto* b = arena.allocate(100);  // doesn't fit anymore
+
+            Assert::IsTrue(a != nullptr);
+            Assert::IsTrue(b != nullptr);
+            Assert::IsTrue(arena.getNumOverflows() == 1);
+
+            arena.nextFrame();
+            Assert::IsTrue(arena.getPeakBytesUsed() == 200);
+        }
+
+        TEST_METHOD(pmr_containers) {
+            djinn::util::FrameArena arena(4096);
+
+            std::pmr::vector<int> v(&arena);
+            for (int i = 0; i < 100; ++i)
+                v.push_back(i);
+
+            Assert::IsTrue(v.size() == 100);
+            Assert::IsTrue(v[99] == 99);
+            Assert::IsTrue(arena.getBytesUsed() > 0);
+            Assert::IsTrue(arena.getNumOverflows() == 0);
+
+            auto parts = djinn::util::split("a,b,,c", ',', &arena);
+
+            Assert::IsTrue(parts.size() == 3);
+            Assert::IsTrue(parts[0] == "a");
+            Assert::IsTrue(parts[2] == "c");
+            Assert::IsTrue(parts.get_allocator().resource() == &arena);
+        }
+
+        TEST_METHOD(allocating_from_workers) {
+            // workers allocate during a frame, the main thread switches frames in between
+            constexpr int k_NumWorkers = 4;
+            constexpr int k_NumFrames  = 200;
+
+            djinn::util::FrameArena arena(64 * 1024);
+
+            std::atomic_int frame     = 0;
+            std::atomic_int numDone   = 0;
+            std::atomic_int numErrors = 0;
+
+            std::vector<std::thread> workers;
+
+            for (int w = 0; w < k_NumWorkers; ++w)
+                workers.emplace_back([&, w] {
+                    for (int f = 1; f <= k_NumFrames; ++f) {
+                        while (frame < f)
+                            std::this_thread::yield();
+
+                        std::vector<unsigned char*> blocks;
+
+                        for (int i = 0; i < 32; ++i) {
+                            auto* block = static_cast<unsigned char*>(arena.allocate(64, 16));
+                            std::memset(block, w, 64);
+                            blocks.push_back(block);
+                        }
+
+                        // no other worker may have been handed the same memory
+                        for (auto* block : blocks)
+                            for (int i = 0; i < 64; ++i)
+                                if (block[i] != w)
+                                    ++numErrors;
+
+                        ++numDone;
+                    }
+                });
+
+            for (int f = 1; f <= k_NumFrames; ++f) {
+                frame = f;
+
+                while (numDone < f * k_NumWorkers)
+                    std::this_thread::yield();
+
+                arena.nextFrame();
+            }
+
+            for (auto& worker : workers)
+                worker.join();
+
+            Assert::IsTrue(numErrors == 0);
+            Assert::IsTrue(arena.getNumOverflows() == 0);
+            Assert::IsTrue(arena.getPeakBytesUsed() >= k_NumWorkers * 32 * 64);
+        }
+    };
+}
@@ -0,0 +1,119 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "util/grace_period.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace DjinnTest {
+    TEST_CLASS(GracePeriod) {
+    public:
+        TEST_METHOD(no_readers) {
+            djinn::util::GracePeriod grace;
+
+            grace.wait();  // should return immediately
+
+            {
+                djinn::util::GracePeriod::ReadGuard a(grace);
+                djinn::util::GracePeriod::ReadGuard b(grace);  // nested
+
+                Assert::IsTrue(grace.getNumReaders() == 2);
+            }
+
+            Assert::IsTrue(grace.getNumReaders() == 0);
+            grace.wait();
+        }
+
+        TEST_METHOD(waits_for_reader) {
+            using namespace std::chrono_literals;
+
+            djinn::util::GracePeriod grace;
+
+            std::atomic_bool isReading = false;
+            std::atomic_bool isDone    = false;
+            std::atomic_bool release   = false;
+
+            std::thread reader([&] {
+                djinn::util::GracePeriod::ReadGuard guard(grace);
+
+                isReading = true;
+
+                while (!release)
+                    std::this_thread::yield();
+            });
+
+            while (!isReading)
+                std::this_thread::yield();
+
+            std::thread writer([&] {
+                grace.wait();
+                isDone = true;
+            });
+
+            std::this_thread::sleep_for(20ms);
+            Assert::IsFalse(isDone);
+
+            release = true;
+
+            reader.join();
+            writer.join();
+
+            Assert::IsTrue(isDone);
+        }
+
+        TEST_METHOD(readers_never_see_retired_data) {
+            // the writer replaces the data, waits and then 'destroys' the previous version;
+            // readers check that whatever they picked up is still alive while they use it
+            struct Data {
+                std::atomic_bool m_IsAlive = true;
+            };
+
+            djinn::util::GracePeriod grace;
+
+            constexpr int k_NumVersions = 2000;
+
+            std::vector<std::unique_ptr<Data>> versions;
+            for (int i = 0; i < k_NumVersions; ++i)
+                versions.push_back(std::make_unique<Data>());
+
+            std::atomic<Data*> current = versions[0].get();
+            std::atomic_bool   isDone  = false;
+            std::atomic_int    numErrors = 0;
+
+            std::vector<std::thread> readers;
+
+            for (int i = 0; i < 4; ++i)
+                readers.emplace_back([&] {
+                    while (!isDone) {
+                        djinn::util::GracePeriod::ReadGuard guard(grace);
+
+                        auto* data = current.load();
+
+                        for (int j = 0; j < 16; ++j)
+                            if (!data->m_IsAlive)
+                                ++numErrors;
+                    }
+                });
+
+            for (int i = 1; i < k_NumVersions; ++i) {
+                auto* previous = current.exchange(versions[i].get());
+
+                grace.wait();
+                previous->m_IsAlive = false;
+            }
+
+            isDone = true;
+
+            for (auto& reader : readers)
+                reader.join();
+
+            Assert::IsTrue(numErrors == 0);
+        }
+    };
+}
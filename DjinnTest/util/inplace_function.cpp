@@ -0,0 +1,97 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "util/inplace_function.h"
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace DjinnTest {
+    TEST_CLASS(InplaceFunction) {
+    public:
+        TEST_METHOD(small_inline) {
+            using djinn::util::InplaceFunction;
+
+            int total = 0;
+
+            InplaceFunction<void(int)> fn = [&total](int x) { total += x; };
+
+            Assert::IsTrue(static_cast<bool>(fn));
+            Assert::IsTrue(fn.isInline());
+
+            fn(3);
+            fn(4);
+
+            Assert::IsTrue(total == 7);
+
+            InplaceFunction<void(int)> empty;
+            Assert::IsFalse(static_cast<bool>(empty));
+        }
+
+        TEST_METHOD(large_on_heap) {
+            using djinn::util::InplaceFunction;
+
+            std::array<int, 64> values = {};
+            values[10]                 = 42;
+
+            InplaceFunction<int(), 32> fn = [values] { return values[10]; };
+
+            Assert::IsFalse(fn.isInline());
+            Assert::IsTrue(fn() == 42);
+        }
+
+        TEST_METHOD(move_only_captures) {
+            using djinn::util::InplaceFunction;
+
+            auto value = std::make_shared<int>(5);
+
+            {
+                InplaceFunction<int()> a = [ptr = std::make_unique<std::shared_ptr<int>>(value)] { return **ptr; };
+                Assert::IsTrue(value.use_count() == 2);
+
+                InplaceFunction<int()> b = std::move(a);
+                Assert::IsFalse(static_cast<bool>(a));
+                Assert::IsTrue(b() == 5);
+
+                InplaceFunction<int()> c;
+                c = std::move(b);
+                Assert::IsTrue(c() == 5);
+                Assert::IsTrue(value.use_count() == 2);
+
+                // replacing destroys the previous callable
+                c = [] { return 1; };
+                Assert::IsTrue(value.use_count() == 1);
+                Assert::IsTrue(c() == 1);
+            }
+
+            // same for the heap version
+            {
+                std::array<char, 128> padding = {};
+
+                InplaceFunction<int(), 16> a = [value, padding] { return *value + padding[0]; };
+                Assert::IsTrue(value.use_count() == 2);
+
+                InplaceFunction<int(), 16> b = std::move(a);
+                Assert::IsTrue(b() == 5);
+            }
+
+            Assert::IsTrue(value.use_count() == 1);
+        }
+
+        TEST_METHOD(in_containers) {
+            using djinn::util::InplaceFunction;
+
+            std::vector<InplaceFunction<std::string()>> functions;
+
+            for (int i = 0; i < 100; ++i)
+                functions.push_back([i] { return std::to_string(i); });
+
+            Assert::IsTrue(functions[42]() == "42");
+            Assert::IsTrue(functions[99]() == "99");
+        }
+    };
+}
@@ -0,0 +1,82 @@
+#include "core/binary_log.h"
+#include "core/flight_recorder.h"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+namespace {
+    void printUsage() {
+        std::cout << "Usage: LogTool <command> <input> [output]\n"
+                     "\n"
+                     "Commands:\n"
+                     "  decode  converts a binary log (see core/binary_log.h) into the regular text\n"
+                     "          format; writes to the output file if given, std::cout otherwise\n"
+                     "  flight  reconstructs the log tail from a flight recorder ring file (see\n"
+                     "          core/flight_recorder.h), oldest message first\n";
+    }
+
+    int decode(const std::string& input, std::ostream& output) {
+        std::ifstream file(input, std::ios::binary);
+
+        if (!file.good()) {
+            std::cerr << "Failed to open " << input << "\n";
+            return 1;
+        }
+
+        if (!djinn::core::decodeBinaryLog(file, output)) {
+            std::cerr << input << " is not a valid binary log\n";
+            return 2;
+        }
+
+        return 0;
+    }
+
+    int flight(const std::string& input, std::ostream& output) {
+        std::ifstream file(input, std::ios::binary);
+
+        if (!file.good()) {
+            std::cerr << "Failed to open " << input << "\n";
+            return 1;
+        }
+
+        if (!djinn::core::decodeFlightRecorder(file, output)) {
+            std::cerr << input << " is not a valid flight recorder file\n";
+            return 2;
+        }
+
+        return 0;
+    }
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        printUsage();
+        return 1;
+    }
+
+    std::string command = argv[1];
+    std::string input   = argv[2];
+
+    std::ofstream outputFile;
+
+    if (argc > 3) {
+        outputFile.open(argv[3]);
+
+        if (!outputFile.good()) {
+            std::cerr << "Failed to open " << argv[3] << "\n";
+            return 1;
+        }
+    }
+
+    std::ostream& output = outputFile.is_open() ? outputFile : std::cout;
+
+    if (command == "decode")
+        return decode(input, output);
+
+    if (command == "flight")
+        return flight(input, output);
+
+    printUsage();
+    return 1;
+}